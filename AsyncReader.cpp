@@ -0,0 +1,331 @@
+/*
+ * AsyncReader.cpp
+ *
+ * Class Description: Asynchronous positional file reads, through io_uring when the kernel offers it,
+ *                    through a pool of pread( ) threads otherwise.
+ * Class Invariant: - At most getQueueDepth( ) reads are submitted and not yet returned by wait( ).
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "AsyncReader.h"
+#include "UnableToOpenFileException.h"
+
+using namespace std;
+
+// Message of the exception thrown once the ring failed.
+static const char *const RING_FAILED = "Unable to read file. io_uring_enter failed.";
+
+// The ring indices are shared with the kernel: published with release stores, read with acquire loads.
+static inline unsigned int loadAcquire(const unsigned int *p)
+{
+    return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline void storeRelease(unsigned int *p, unsigned int value)
+{
+    __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+// Constructor
+AsyncReader::AsyncReader(unsigned int aQueueDepth, bool allowIoUring) : queueDepth(aQueueDepth)
+{
+    ioUring = allowIoUring && setUpRing();
+    if (!ioUring)
+    {
+        for (unsigned int t = 0; t < POOL_THREADS; t++)
+        {
+            workers.push_back(thread(&AsyncReader::work, this));
+        }
+    }
+}
+
+// Destructor
+// Description: Waits for the reads still in flight (unless the ring failed: they cannot be reaped),
+//              then releases the ring or stops the pool.
+AsyncReader::~AsyncReader()
+{
+    try
+    {
+        while (inFlight > 0 && !ringFailed)
+        {
+            wait();
+        }
+    }
+    catch (UnableToOpenFileException &)
+    {
+        // wait( ) marked the ring failed: closing it makes the kernel cancel what it still holds.
+    }
+    if (ioUring)
+    {
+        tearDownRing();
+        return;
+    }
+
+    {
+        lock_guard<mutex> guard(lock);
+        stopping = true;
+    }
+    requestReady.notify_all();
+    for (unsigned int t = 0; t < workers.size(); t++)
+    {
+        workers[t].join();
+    }
+}
+
+// Description: Returns true if the reads go through io_uring.
+bool AsyncReader::usesIoUring() const
+{
+    return ioUring;
+}
+
+// Description: Returns the maximum number of reads in flight.
+unsigned int AsyncReader::getQueueDepth() const
+{
+    return queueDepth;
+}
+
+// Description: Returns the number of reads submitted and not yet returned by wait( ).
+unsigned int AsyncReader::getInFlightCount() const
+{
+    return inFlight;
+}
+
+// Description: Queues a read. It starts at the next flush( ).
+void AsyncReader::submit(int fd, void *buffer, unsigned int length, unsigned long long offset, unsigned long long tag)
+{
+    queued.push_back(Read{fd, buffer, length, offset, tag});
+    inFlight++;
+}
+
+// Description: Starts the queued reads: fills one submission queue entry per read and enters the
+//              kernel once for all of them, or hands them to the pool.
+void AsyncReader::flush()
+{
+    if (queued.empty())
+    {
+        return;
+    }
+
+    if (ioUring)
+    {
+        io_uring_sqe *sqes = (io_uring_sqe *)ring.sqes;
+        unsigned int tail = *ring.sqTail;
+        for (unsigned int i = 0; i < queued.size(); i++)
+        {
+            unsigned int index = (tail + i) & *ring.sqMask;
+            io_uring_sqe &sqe = sqes[index];
+            memset(&sqe, 0, sizeof(sqe));
+            sqe.opcode = IORING_OP_READ;
+            sqe.fd = queued[i].fd;
+            sqe.addr = (unsigned long long)queued[i].buffer;
+            sqe.len = queued[i].length;
+            sqe.off = queued[i].offset;
+            sqe.user_data = queued[i].tag;
+            ring.sqArray[index] = index;
+        }
+        storeRelease(ring.sqTail, tail + (unsigned int)queued.size());
+
+        unsigned int toSubmit = (unsigned int)queued.size();
+        while (toSubmit > 0)
+        {
+            long submitted = syscall(__NR_io_uring_enter, ring.fd, toSubmit, 0, 0, nullptr, 0);
+            if (submitted < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+            {
+                break; // the kernel keeps the entries; they will be retried by wait( )
+            }
+            toSubmit -= (submitted > 0) ? (unsigned int)submitted : 0;
+        }
+    }
+    else
+    {
+        {
+            lock_guard<mutex> guard(lock);
+            requests.insert(requests.end(), queued.begin(), queued.end());
+        }
+        requestReady.notify_all();
+    }
+    queued.clear();
+}
+
+// Description: Flushes, then waits for a read to finish and returns its completion.
+// Exception: Throws UnableToOpenFileException if io_uring_enter( ) fails for a reason other than an
+//            interruption or a temporary shortage (EINTR, EAGAIN, EBUSY): the reads in flight can then
+//            not be reaped, so the reader is marked failed and every later wait( ) throws too.
+AsyncReader::Completion AsyncReader::wait()
+{
+    if (ringFailed)
+    {
+        throw UnableToOpenFileException(RING_FAILED);
+    }
+    flush();
+    Completion completion;
+    if (ioUring)
+    {
+        unsigned int head = *ring.cqHead;
+        while (head == loadAcquire(ring.cqTail))
+        {
+            unsigned int unsubmitted = *ring.sqTail - loadAcquire(ring.sqHead);
+            long entered = syscall(__NR_io_uring_enter, ring.fd, unsubmitted, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (entered < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY)
+            {
+                ringFailed = true;
+                throw UnableToOpenFileException(RING_FAILED);
+            }
+        }
+        const io_uring_cqe &cqe = ((const io_uring_cqe *)ring.cqes)[head & *ring.cqMask];
+        completion.tag = cqe.user_data;
+        completion.result = cqe.res;
+        storeRelease(ring.cqHead, head + 1);
+    }
+    else
+    {
+        unique_lock<mutex> guard(lock);
+        completionReady.wait(guard, [&]()
+                             { return !completions.empty(); });
+        completion = completions.front();
+        completions.pop_front();
+    }
+    inFlight--;
+    return completion;
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Sets up a ring of queueDepth entries and maps its queues; checks with a probe that the
+//              kernel supports IORING_OP_READ. Returns false, leaving no resource behind, on any failure.
+bool AsyncReader::setUpRing()
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring.fd = (int)syscall(__NR_io_uring_setup, queueDepth, &params);
+    if (ring.fd < 0)
+    {
+        return false;
+    }
+
+    ring.sqMappingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    ring.cqMappingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool singleMapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (singleMapping)
+    {
+        ring.sqMappingSize = max(ring.sqMappingSize, ring.cqMappingSize);
+    }
+    ring.sqMapping = mmap(nullptr, ring.sqMappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_SQ_RING);
+    if (ring.sqMapping == MAP_FAILED)
+    {
+        ring.sqMapping = nullptr;
+        tearDownRing();
+        return false;
+    }
+    if (singleMapping)
+    {
+        ring.cqMapping = ring.sqMapping;
+        ring.cqMappingSize = 0; // unmapped with the submission queue
+    }
+    else
+    {
+        ring.cqMapping = mmap(nullptr, ring.cqMappingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_CQ_RING);
+        if (ring.cqMapping == MAP_FAILED)
+        {
+            ring.cqMapping = nullptr;
+            tearDownRing();
+            return false;
+        }
+    }
+    ring.sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    ring.sqes = mmap(nullptr, ring.sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring.fd, IORING_OFF_SQES);
+    if (ring.sqes == MAP_FAILED)
+    {
+        ring.sqes = nullptr;
+        tearDownRing();
+        return false;
+    }
+
+    char *sq = (char *)ring.sqMapping;
+    char *cq = (char *)ring.cqMapping;
+    ring.sqHead = (unsigned int *)(sq + params.sq_off.head);
+    ring.sqTail = (unsigned int *)(sq + params.sq_off.tail);
+    ring.sqMask = (unsigned int *)(sq + params.sq_off.ring_mask);
+    ring.sqArray = (unsigned int *)(sq + params.sq_off.array);
+    ring.cqHead = (unsigned int *)(cq + params.cq_off.head);
+    ring.cqTail = (unsigned int *)(cq + params.cq_off.tail);
+    ring.cqMask = (unsigned int *)(cq + params.cq_off.ring_mask);
+    ring.cqes = cq + params.cq_off.cqes;
+
+    // IORING_OP_READ appeared in Linux 5.6, like the probe: a kernel without the probe lacks it too.
+    size_t probeSize = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+    vector<char> probeMemory(probeSize, 0);
+    io_uring_probe *probe = (io_uring_probe *)probeMemory.data();
+    if (syscall(__NR_io_uring_register, ring.fd, IORING_REGISTER_PROBE, probe, 256) < 0 ||
+        probe->last_op < IORING_OP_READ || !(probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED))
+    {
+        tearDownRing();
+        return false;
+    }
+    queueDepth = min(queueDepth, params.sq_entries);
+    return true;
+}
+
+// Description: Unmaps and closes the ring.
+void AsyncReader::tearDownRing()
+{
+    if (ring.sqes != nullptr)
+    {
+        munmap(ring.sqes, ring.sqesSize);
+    }
+    if (ring.cqMapping != nullptr && ring.cqMappingSize != 0)
+    {
+        munmap(ring.cqMapping, ring.cqMappingSize);
+    }
+    if (ring.sqMapping != nullptr)
+    {
+        munmap(ring.sqMapping, ring.sqMappingSize);
+    }
+    if (ring.fd >= 0)
+    {
+        close(ring.fd);
+    }
+    ring = Ring();
+}
+
+// Description: Body of a pool thread: serves requests with pread( ) until stopping.
+void AsyncReader::work()
+{
+    while (true)
+    {
+        Read read;
+        {
+            unique_lock<mutex> guard(lock);
+            requestReady.wait(guard, [&]()
+                              { return stopping || !requests.empty(); });
+            if (requests.empty())
+            {
+                return;
+            }
+            read = requests.front();
+            requests.pop_front();
+        }
+
+        ssize_t bytes;
+        do
+        {
+            bytes = pread(read.fd, read.buffer, read.length, (off_t)read.offset);
+        } while (bytes < 0 && errno == EINTR);
+
+        {
+            lock_guard<mutex> guard(lock);
+            completions.push_back(Completion{read.tag, (bytes < 0) ? -(long long)errno : (long long)bytes});
+        }
+        completionReady.notify_one();
+    }
+}
@@ -0,0 +1,132 @@
+/*
+ * AsyncReader.h
+ *
+ * Class Description: Asynchronous positional file reads, for ingesting large files without a
+ *                    system call (and a stream buffer copy) per line.
+ *                    Reads are queued with submit( ), handed over together with flush( ), and their
+ *                    completions collected, in any order, with wait( ).
+ *                    Uses io_uring (through the raw system calls: IORING_OP_READ, Linux 5.6) when the
+ *                    kernel offers it; otherwise (older kernel, io_uring disabled by sysctl or seccomp)
+ *                    a pool of threads calling pread( ).
+ * Class Invariant: - At most getQueueDepth( ) reads are submitted and not yet returned by wait( ).
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef ASYNC_READER_H
+#define ASYNC_READER_H
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using std::condition_variable;
+using std::deque;
+using std::mutex;
+using std::thread;
+using std::vector;
+
+class AsyncReader
+{
+
+public:
+  // A finished read: the tag given to submit( ) and the number of bytes read (-errno on failure).
+  struct Completion
+  {
+    unsigned long long tag;
+    long long result;
+  };
+
+private:
+  struct Read
+  {
+    int fd;
+    void *buffer;
+    unsigned int length;
+    unsigned long long offset;
+    unsigned long long tag;
+  };
+
+  // io_uring: the file descriptor of the ring and its mappings (shared with the kernel).
+  struct Ring
+  {
+    int fd = -1;
+    void *sqMapping = nullptr;
+    size_t sqMappingSize = 0;
+    void *cqMapping = nullptr;
+    size_t cqMappingSize = 0;
+    void *sqes = nullptr;
+    size_t sqesSize = 0;
+    unsigned int *sqHead, *sqTail, *sqMask, *sqArray;
+    unsigned int *cqHead, *cqTail, *cqMask;
+    void *cqes;
+  };
+
+  unsigned int queueDepth;
+  unsigned int inFlight = 0;  // Submitted (queued included), not yet returned by wait( ).
+  vector<Read> queued;        // Submitted, not flushed yet.
+  Ring ring;
+  bool ioUring = false;
+  bool ringFailed = false;    // io_uring_enter( ) failed for good: the reads in flight are lost.
+
+  // pread( ) pool (when io_uring is not used).
+  vector<thread> workers;
+  mutex lock;                 // Protects requests, completions and stopping.
+  condition_variable requestReady;
+  condition_variable completionReady;
+  deque<Read> requests;
+  deque<Completion> completions;
+  bool stopping = false;
+
+  // Description: Sets up the ring; returns false (leaving no resource behind) if io_uring or
+  //              IORING_OP_READ is not available.
+  bool setUpRing();
+
+  // Description: Unmaps and closes the ring.
+  void tearDownRing();
+
+  // Description: Body of a pool thread: serves requests with pread( ) until stopping.
+  void work();
+
+public:
+  const static unsigned int POOL_THREADS = 4;
+
+  // Constructor
+  // Description: Creates a reader for up to aQueueDepth reads in flight; with io_uring if allowed
+  //              (allowIoUring) and available, with POOL_THREADS pread( ) threads otherwise.
+  AsyncReader(unsigned int aQueueDepth, bool allowIoUring = true);
+
+  // Destructor
+  // Description: Waits for the reads still in flight (their buffers must stay valid until then).
+  ~AsyncReader();
+
+  AsyncReader(const AsyncReader &) = delete;
+  AsyncReader &operator=(const AsyncReader &) = delete;
+
+  // Description: Returns true if the reads go through io_uring, false if through the pread( ) pool.
+  bool usesIoUring() const;
+
+  // Description: Returns the maximum number of reads in flight.
+  unsigned int getQueueDepth() const;
+
+  // Description: Returns the number of reads submitted and not yet returned by wait( ).
+  unsigned int getInFlightCount() const;
+
+  // Description: Queues a read of length bytes of file fd at offset into buffer. It starts at the next flush( ).
+  // Precondition: getInFlightCount( ) < getQueueDepth( ).
+  void submit(int fd, void *buffer, unsigned int length, unsigned long long offset, unsigned long long tag);
+
+  // Description: Starts the queued reads (one io_uring_enter( ) for all of them).
+  void flush();
+
+  // Description: Flushes, then waits for a read to finish and returns its completion.
+  // Precondition: getInFlightCount( ) > 0.
+  // Exception: Throws UnableToOpenFileException if io_uring_enter( ) failed (other than EINTR, EAGAIN or
+  //            EBUSY): the reads in flight are lost, and every later wait( ) throws too.
+  Completion wait();
+};
+
+#endif
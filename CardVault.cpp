@@ -0,0 +1,242 @@
+/*
+ * CardVault.cpp
+ *
+ * Class Description: Tokenization vault for credit card numbers: a card number is replaced by its
+ *                    keyed hash (SipHash-2-4), and kept in an open addressing table indexed by it.
+ * Class Invariant: - Each stored card has exactly one token, and each token one card.
+ *                  - The table is at most half full.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <cctype>
+#include <cstring>
+#include <mutex>
+#include <random>
+#include <utility>
+
+#include "CardVault.h"
+#include "ElementDoesNotExistException.h"
+
+using namespace std;
+
+static inline unsigned long long rotateLeft(unsigned long long x, unsigned int bits)
+{
+    return (x << bits) | (x >> (64 - bits));
+}
+
+static inline void sipRound(unsigned long long &v0, unsigned long long &v1, unsigned long long &v2, unsigned long long &v3)
+{
+    v0 += v1;
+    v1 = rotateLeft(v1, 13);
+    v1 ^= v0;
+    v0 = rotateLeft(v0, 32);
+    v2 += v3;
+    v3 = rotateLeft(v3, 16);
+    v3 ^= v2;
+    v0 += v3;
+    v3 = rotateLeft(v3, 21);
+    v3 ^= v0;
+    v2 += v1;
+    v1 = rotateLeft(v1, 17);
+    v1 ^= v2;
+    v2 = rotateLeft(v2, 32);
+}
+
+// Description: SipHash-2-4 of the bytes [data, data + length) under key (little-endian words, as in the reference).
+static unsigned long long sipHash(const unsigned long long key[2], const char *data, size_t length)
+{
+    unsigned long long v0 = 0x736f6d6570736575ULL ^ key[0];
+    unsigned long long v1 = 0x646f72616e646f6dULL ^ key[1];
+    unsigned long long v2 = 0x6c7967656e657261ULL ^ key[0];
+    unsigned long long v3 = 0x7465646279746573ULL ^ key[1];
+
+    size_t full = length / 8 * 8;
+    for (size_t i = 0; i < full; i += 8)
+    {
+        unsigned long long m;
+        memcpy(&m, data + i, 8);
+        v3 ^= m;
+        sipRound(v0, v1, v2, v3);
+        sipRound(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+    unsigned long long last = (unsigned long long)(length & 0xff) << 56;
+    for (size_t i = full; i < length; i++)
+    {
+        last |= (unsigned long long)(unsigned char)data[i] << (8 * (i - full));
+    }
+    v3 ^= last;
+    sipRound(v0, v1, v2, v3);
+    sipRound(v0, v1, v2, v3);
+    v0 ^= last;
+
+    v2 ^= 0xff;
+    for (unsigned int i = 0; i < 4; i++)
+    {
+        sipRound(v0, v1, v2, v3);
+    }
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+// Constructor
+CardVault::CardVault()
+{
+    random_device device;
+    key[0] = (unsigned long long)device() << 32 | device();
+    key[1] = (unsigned long long)device() << 32 | device();
+    capacity = INITIAL_CAPACITY;
+    entries = new Entry[capacity];
+}
+
+// Constructor
+CardVault::CardVault(unsigned long long key0, unsigned long long key1)
+{
+    key[0] = key0;
+    key[1] = key1;
+    capacity = INITIAL_CAPACITY;
+    entries = new Entry[capacity];
+}
+
+// Destructor
+CardVault::~CardVault()
+{
+    delete[] entries;
+    entries = nullptr;
+}
+
+// Description: Returns the vault used by Member (created on first use).
+CardVault &CardVault::global()
+{
+    static CardVault vault;
+    return vault;
+}
+
+// Description: Returns the token of card, storing card if it is new. 0 for the empty string.
+unsigned long long CardVault::tokenize(const string &card)
+{
+    if (card.empty())
+    {
+        return 0;
+    }
+
+    unsigned long long token = 0;
+    {
+        shared_lock<shared_mutex> guard(lock); // most cards are already stored: look without blocking readers
+        if (entries[probe(card, token)].token != 0)
+        {
+            return token;
+        }
+    }
+
+    unique_lock<shared_mutex> guard(lock);
+    unsigned int cell = probe(card, token); // another thread may have stored it meanwhile
+    if (entries[cell].token != 0)
+    {
+        return token;
+    }
+    entries[cell].token = token;
+    entries[cell].card = card;
+    cardCount++;
+    if (cardCount * 2 > capacity)
+    {
+        grow();
+    }
+    return token;
+}
+
+// Description: Returns the card whose token is token, the empty string for token 0.
+// Exception: Throws ElementDoesNotExistException if token was not issued by this vault.
+string CardVault::detokenize(unsigned long long token) const
+{
+    if (token == 0)
+    {
+        return "";
+    }
+    shared_lock<shared_mutex> guard(lock);
+    unsigned int cell = cellOf(token);
+    if (entries[cell].token != token)
+    {
+        throw ElementDoesNotExistException("Unknown card token.");
+    }
+    return entries[cell].card;
+}
+
+// Description: Returns card with every digit but the last 4 replaced by '*'.
+string CardVault::mask(const string &card)
+{
+    string masked = card;
+    unsigned int keptDigits = 0;
+    for (size_t i = masked.size(); i-- > 0;)
+    {
+        if (isdigit((unsigned char)masked[i]) && keptDigits++ >= 4)
+        {
+            masked[i] = '*';
+        }
+    }
+    return masked;
+}
+
+// Description: Returns the number of cards stored.
+unsigned int CardVault::getCardCount() const
+{
+    shared_lock<shared_mutex> guard(lock);
+    return cardCount;
+}
+
+// Description: Returns the memory used by the table in bytes.
+unsigned long long CardVault::getMemoryUsage() const
+{
+    shared_lock<shared_mutex> guard(lock);
+    return (unsigned long long)capacity * sizeof(Entry) + sizeof(CardVault);
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Returns the cell holding token, or the empty cell where it would go
+//              (linear probing from the low bits of the token, already uniformly distributed).
+unsigned int CardVault::cellOf(unsigned long long token) const
+{
+    unsigned int cell = (unsigned int)token & (capacity - 1);
+    while (entries[cell].token != 0 && entries[cell].token != token)
+    {
+        cell = (cell + 1) & (capacity - 1);
+    }
+    return cell;
+}
+
+// Description: Sets token to the token of card and returns the cell holding card, or the empty cell
+//              where it goes. The token is the keyed hash of card; in the (2^-64 per pair) event that
+//              two cards hash alike, the later one takes the next free token value.
+unsigned int CardVault::probe(const string &card, unsigned long long &token) const
+{
+    token = sipHash(key, card.data(), card.size());
+    token += (token == 0);
+    unsigned int cell = cellOf(token);
+    while (entries[cell].token != 0 && entries[cell].card != card)
+    {
+        token += 1 + (token == ~0ULL); // never 0
+        cell = cellOf(token);
+    }
+    return cell;
+}
+
+// Description: Doubles the capacity and moves every entry (the caller holds the lock exclusively).
+void CardVault::grow()
+{
+    Entry *old = entries;
+    unsigned int oldCapacity = capacity;
+    capacity *= 2;
+    entries = new Entry[capacity];
+    for (unsigned int i = 0; i < oldCapacity; i++)
+    {
+        if (old[i].token != 0)
+        {
+            Entry &entry = entries[cellOf(old[i].token)];
+            entry.token = old[i].token;
+            entry.card = move(old[i].card);
+        }
+    }
+    delete[] old;
+}
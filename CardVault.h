@@ -0,0 +1,94 @@
+/*
+ * CardVault.h
+ *
+ * Class Description: Tokenization vault for credit card numbers. A card number is replaced by a
+ *                    64-bit token, the keyed hash (SipHash-2-4, under the vault's secret 128-bit key)
+ *                    of the card; the vault keeps the card number in an open addressing table indexed
+ *                    by the token, so that detokenizing is one hashed lookup. Tokenizing the same card
+ *                    twice gives the same token; without the key, a token reveals nothing of the card.
+ *                    Token 0 stands for "no card" (the empty string) and is never stored.
+ *                    Member keeps only the token of its card, in the process-wide vault (global( )).
+ *                    Cards stay in the vault for the life of the process.
+ *                    Every member function may be called concurrently.
+ * Class Invariant: - Each stored card has exactly one token, and each token one card.
+ *                  - The table is at most half full.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef CARD_VAULT_H
+#define CARD_VAULT_H
+
+#include <shared_mutex>
+#include <string>
+
+using std::shared_mutex;
+using std::string;
+
+class CardVault
+{
+
+private:
+  struct Entry
+  {
+    unsigned long long token = 0; // 0: empty cell.
+    string card;
+  };
+
+  unsigned long long key[2];    // SipHash key.
+  Entry *entries = nullptr;
+  unsigned int capacity = 0;    // A power of 2.
+  unsigned int cardCount = 0;
+  mutable shared_mutex lock;    // Shared for detokenize( ), exclusive for tokenize( ) when it stores a card.
+
+  // Description: Returns the cell holding token, or the empty cell where it would go.
+  unsigned int cellOf(unsigned long long token) const;
+
+  // Description: Sets token to the token of card and returns the cell holding card, or the empty cell where it goes.
+  unsigned int probe(const string &card, unsigned long long &token) const;
+
+  // Description: Doubles the capacity and moves every entry.
+  void grow();
+
+public:
+  const static unsigned int INITIAL_CAPACITY = 1024;
+
+  // Constructor
+  // Description: Creates an empty vault with a random key (from std::random_device).
+  CardVault();
+
+  // Constructor
+  // Description: Creates an empty vault with the given key (tokens are reproducible across runs).
+  CardVault(unsigned long long key0, unsigned long long key1);
+
+  // Destructor
+  ~CardVault();
+
+  CardVault(const CardVault &) = delete;
+  CardVault &operator=(const CardVault &) = delete;
+
+  // Description: Returns the vault used by Member.
+  static CardVault &global();
+
+  // Description: Returns the token of card, storing card if it is new. 0 for the empty string.
+  // Time Efficiency: O(length of card) expected
+  unsigned long long tokenize(const string &card);
+
+  // Description: Returns the card whose token is token, the empty string for token 0.
+  // Time Efficiency: O(1) expected
+  // Exception: Throws ElementDoesNotExistException if token was not issued by this vault.
+  string detokenize(unsigned long long token) const;
+
+  // Description: Returns card with every digit but the last 4 replaced by '*'.
+  // Example: "1234567890123" -> "*********0123"
+  static string mask(const string &card);
+
+  // Description: Returns the number of cards stored.
+  unsigned int getCardCount() const;
+
+  // Description: Returns the memory used by the table in bytes (not counting card numbers too long for a string's inline buffer).
+  unsigned long long getMemoryUsage() const;
+};
+
+#endif
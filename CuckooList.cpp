@@ -0,0 +1,441 @@
+/*
+ * CuckooList.cpp
+ *
+ * Class Description: List data collection ADT.
+ *                    Based on the Hashing strategy and the collision resolution strategy
+ *                    called bucketized cuckoo hashing:
+ *                    - two hash functions map each indexing key (phone) to two buckets,
+ *                    - each bucket holds BUCKET_SIZE elements and fits in one cache line,
+ *                    - a small stash absorbs the rare element that cannot be placed.
+ *                    A search therefore looks at no more than two buckets (plus the stash,
+ *                    which is empty in the common case), whatever the load of the table.
+ * Class Invariant: Data collection with the following characteristics:
+ *                  - Each element is unique (no duplicates).
+ *                  - Each element is stored in one of its two buckets or in the stash.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <climits>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "CuckooList.h"
+#include "ErrorCode.h"
+#include "PhoneKey.h"
+#include "ElementAlreadyExistsException.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+#include "UnableToInsertException.h"
+
+using namespace std;
+
+// Constructor
+// Description: Creates a table able to hold about "capacity" elements before it has to grow.
+CuckooList::CuckooList(unsigned int capacity)
+{
+    // Aim for a load of at most 90% of the cells, rounded up to a power of 2 buckets.
+    unsigned int needed = (unsigned int)(capacity / (BUCKET_SIZE * 0.9)) + 1;
+    bucketCount = 1;
+    while (bucketCount < needed)
+    {
+        bucketCount *= 2;
+    }
+    if (bucketCount < 2)
+    {
+        bucketCount = 2;
+    }
+
+    buckets = new Bucket[bucketCount];
+    for (unsigned int b = 0; b < bucketCount; b++)
+    {
+        for (unsigned int i = 0; i < BUCKET_SIZE; i++)
+        {
+            buckets[b].keys[i] = 0;
+            buckets[b].elements[i] = nullptr;
+        }
+    }
+    for (unsigned int i = 0; i < STASH_SIZE; i++)
+    {
+        stashKeys[i] = 0;
+        stash[i] = nullptr;
+    }
+}
+
+// Destructor
+// Description: Destruct a CuckooList object, releasing heap-allocated memory.
+CuckooList::~CuckooList()
+{
+    if (buckets != nullptr)
+    {
+        for (unsigned int b = 0; b < bucketCount; b++)
+        {
+            for (unsigned int i = 0; i < BUCKET_SIZE; i++)
+            {
+                delete buckets[b].elements[i];
+            }
+        }
+        delete[] buckets;
+        buckets = nullptr;
+    }
+
+    for (unsigned int i = 0; i < stashCount; i++)
+    {
+        delete stash[i];
+        stash[i] = nullptr;
+    }
+}
+
+// Description: Returns the total element count currently stored in List.
+// Postcondition: List remains unchanged.
+unsigned int CuckooList::getElementCount() const
+{
+    return elementCount;
+}
+
+// Description: Returns the number of times the table was rebuilt.
+unsigned int CuckooList::getRehashCount() const
+{
+    return rehashCount;
+}
+
+// Description: Insert an element.
+// NOTE: When no free cell can be found (eviction cycle and full stash), the table is rehashed.
+// Precondition: newElement must not already be in in the List.
+// Postcondition: newElement inserted and elementCount has been incremented.
+// Exception: Throws UnableToInsertException if we cannot insert newElement in the List
+//            (the List is then unchanged), or if its phone is "000-000-0000" (invalid).
+// Exception: Throws ElementAlreadyExistsException if newElement is already in the List.
+void CuckooList::insert(Member &newElement)
+{
+    unsigned long long key = newElement.getPhoneKey();
+    if (key == INVALID_PHONE_KEY)
+    {
+        throwException(ErrorCode::INVALID_KEY);
+    }
+
+    if (find(key) != nullptr)
+    {
+        throw ElementAlreadyExistsException("Unable to insert element. Element already exists.");
+    }
+
+    Member *homeless = &newElement;
+    Eviction chain[MAX_KICKS + 1];
+    unsigned int chainLength = 0;
+    if (!place(key, homeless, chain, &chainLength))
+    {
+        // Eviction cycle: "homeless" is whichever element was left without a cell. Undo the evictions,
+        // so that the table is whole again (newElement out of it) should a rehash throw, then rebuild
+        // the table (bigger if it is fairly full, otherwise just with new hash functions) and place
+        // newElement again.
+        undoEvictions(chain, chainLength, key, homeless);
+        unsigned long long cells = (unsigned long long)bucketCount * BUCKET_SIZE;
+        unsigned int newBucketCount = bucketCount;
+        if (elementCount + 1 >= cells * 85 / 100)
+        {
+            newBucketCount = bucketCount * 2;
+        }
+        rehash(newBucketCount);
+        while (!place(key, homeless, chain, &chainLength))
+        {
+            undoEvictions(chain, chainLength, key, homeless);
+            rehash(bucketCount * 2);
+        }
+    }
+
+    elementCount++;
+}
+
+// Description: Returns a pointer to the target element if found.
+// Postcondition: List remains unchanged.
+// Exception: Throws EmptyDataCollectionException if the List is empty.
+// Exception: Throws ElementDoesNotExistException if newElement is not found in the List.
+Member *CuckooList::search(Member &target) const
+{
+    if (isEmpty())
+    {
+        throw EmptyDataCollectionException("Data collection is empty.");
+    }
+
+    Member *found = find(target.getPhoneKey());
+    if (found == nullptr)
+    {
+        throw ElementDoesNotExistException("Element does not exist in hash table.");
+    }
+    return found;
+}
+
+// Description: Prints all elements stored in the List (unsorted).
+// Postcondition: List remains unchanged.
+void CuckooList::printList() const
+{
+    for (unsigned int b = 0; b < bucketCount; b++)
+    {
+        for (unsigned int i = 0; i < BUCKET_SIZE; i++)
+        {
+            if (buckets[b].elements[i] != nullptr)
+            {
+                cout << b << "." << i << " " << *buckets[b].elements[i];
+            }
+        }
+    }
+    for (unsigned int i = 0; i < stashCount; i++)
+    {
+        cout << "stash." << i << " " << *stash[i];
+    }
+}
+
+// Description: Prints various stats (load, stash usage, number of rehashes).
+void CuckooList::printStats() const
+{
+    unsigned int fullBuckets = 0;
+    for (unsigned int b = 0; b < bucketCount; b++)
+    {
+        if (buckets[b].elements[BUCKET_SIZE - 1] != nullptr)
+        {
+            fullBuckets++;
+        }
+    }
+
+    unsigned long long cells = (unsigned long long)bucketCount * BUCKET_SIZE;
+    cout << endl
+         << elementCount << " elements in " << bucketCount << " buckets of " << BUCKET_SIZE
+         << " (load " << (100.0 * elementCount / cells) << "%)." << endl;
+    cout << fullBuckets << " buckets are full." << endl;
+    cout << stashCount << " elements are in the stash." << endl;
+    cout << "The table was rehashed " << rehashCount << " times." << endl;
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Computes the two candidate buckets of a packed key.
+//              Both come from the same 64-bit hash code: low half and high half.
+void CuckooList::bucketsOf(unsigned long long key, unsigned int &first, unsigned int &second) const
+{
+    unsigned long long hashCode = mixKey(key ^ seed);
+    unsigned int mask = bucketCount - 1;
+    first = (unsigned int)hashCode & mask;
+    second = (unsigned int)(hashCode >> 32) & mask;
+    if (second == first)
+    {
+        second = (first + 1) & mask;
+    }
+}
+
+// Description: Returns the stored element whose key is key, nullptr if there is none.
+Member *CuckooList::find(unsigned long long key) const
+{
+    unsigned int first, second;
+    bucketsOf(key, first, second);
+
+    const Bucket &b1 = buckets[first];
+    for (unsigned int i = 0; i < BUCKET_SIZE; i++)
+    {
+        if (b1.elements[i] != nullptr && b1.keys[i] == key)
+        {
+            return b1.elements[i];
+        }
+    }
+
+    const Bucket &b2 = buckets[second];
+    for (unsigned int i = 0; i < BUCKET_SIZE; i++)
+    {
+        if (b2.elements[i] != nullptr && b2.keys[i] == key)
+        {
+            return b2.elements[i];
+        }
+    }
+
+    for (unsigned int i = 0; i < stashCount; i++)
+    {
+        if (stashKeys[i] == key)
+        {
+            return stash[i];
+        }
+    }
+    return nullptr;
+}
+
+// Description: Places an element without checking for duplicates.
+//              Takes a free cell in one of its two buckets if there is one, otherwise evicts
+//              an element and moves it to its alternate bucket, and so on (cuckoo eviction).
+// Postcondition: Returns false if the element could not be placed (table needs a rehash);
+//                key and element then describe the element left without a cell.
+bool CuckooList::place(unsigned long long &key, Member *&element, Eviction *chain, unsigned int *chainLength)
+{
+    if (chainLength != nullptr)
+    {
+        *chainLength = 0;
+    }
+    unsigned int first, second;
+    bucketsOf(key, first, second);
+    unsigned int current = first;
+
+    for (unsigned int kicks = 0; kicks <= MAX_KICKS; kicks++)
+    {
+        unsigned int candidates[2] = {current, current == first ? second : first};
+        for (unsigned int c = 0; c < 2; c++)
+        {
+            Bucket &bucket = buckets[candidates[c]];
+            for (unsigned int i = 0; i < BUCKET_SIZE; i++)
+            {
+                if (bucket.elements[i] == nullptr)
+                {
+                    bucket.keys[i] = key;
+                    bucket.elements[i] = element;
+                    return true;
+                }
+            }
+        }
+
+        // Both buckets full: evict a victim from the current bucket and send it
+        // to its other bucket.
+        Bucket &bucket = buckets[current];
+        unsigned int victim = kickCursor++ % BUCKET_SIZE;
+        if (chain != nullptr)
+        {
+            chain[(*chainLength)++] = Eviction{current, victim};
+        }
+        unsigned long long victimKey = bucket.keys[victim];
+        Member *victimElement = bucket.elements[victim];
+        bucket.keys[victim] = key;
+        bucket.elements[victim] = element;
+        key = victimKey;
+        element = victimElement;
+
+        bucketsOf(key, first, second);
+        current = (current == first) ? second : first;
+    }
+
+    // Too many evictions: most likely a cycle. Park the element in the stash if possible.
+    if (stashCount < STASH_SIZE)
+    {
+        stashKeys[stashCount] = key;
+        stash[stashCount] = element;
+        stashCount++;
+        return true;
+    }
+    return false;
+}
+
+// Description: Undoes the evictions of a failed place( ), last first: each evicted element goes back to
+//              the cell it was evicted from, and takes back the element placed there.
+// Postcondition: key and element are those given to place( ); the table is as before it.
+void CuckooList::undoEvictions(const Eviction *chain, unsigned int chainLength, unsigned long long &key,
+                               Member *&element)
+{
+    for (unsigned int i = chainLength; i > 0; i--)
+    {
+        Bucket &bucket = buckets[chain[i - 1].bucket];
+        unsigned int cell = chain[i - 1].cell;
+        swap(key, bucket.keys[cell]);
+        swap(element, bucket.elements[cell]);
+    }
+}
+
+// Description: Rebuilds the table with newBucketCount buckets and a new seed.
+// Exception: Throws UnableToInsertException if the operator "new" fails, or if the number of buckets
+//            would overflow. The table is then left as it was before the call.
+void CuckooList::rehash(unsigned int newBucketCount)
+{
+    if (newBucketCount == 0) // the doubling of bucketCount overflowed
+    {
+        throw UnableToInsertException("Unable to insert element. Cannot grow the table.");
+    }
+    Bucket *oldBuckets = buckets;
+    unsigned int oldBucketCount = bucketCount;
+    unsigned long long oldSeed = seed;
+    unsigned int oldRehashCount = rehashCount;
+    Member *oldStash[STASH_SIZE];
+    unsigned long long oldStashKeys[STASH_SIZE];
+    unsigned int oldStashCount = stashCount;
+    for (unsigned int i = 0; i < stashCount; i++)
+    {
+        oldStash[i] = stash[i];
+        oldStashKeys[i] = stashKeys[i];
+    }
+
+    // Puts back the table as it was before the call (after a failed attempt).
+    auto restore = [&]()
+    {
+        buckets = oldBuckets;
+        bucketCount = oldBucketCount;
+        seed = oldSeed;
+        rehashCount = oldRehashCount;
+        stashCount = oldStashCount;
+        for (unsigned int i = 0; i < oldStashCount; i++)
+        {
+            stash[i] = oldStash[i];
+            stashKeys[i] = oldStashKeys[i];
+        }
+    };
+
+    while (true)
+    {
+        try
+        {
+            buckets = new Bucket[newBucketCount];
+        }
+        catch (bad_alloc &)
+        {
+            restore();
+            throw UnableToInsertException("Unable to insert element. Cannot grow the table.");
+        }
+        bucketCount = newBucketCount;
+        seed = mixKey(seed + 0x9e3779b97f4a7c15ULL + rehashCount);
+        rehashCount++;
+        stashCount = 0;
+        for (unsigned int b = 0; b < bucketCount; b++)
+        {
+            for (unsigned int i = 0; i < BUCKET_SIZE; i++)
+            {
+                buckets[b].keys[i] = 0;
+                buckets[b].elements[i] = nullptr;
+            }
+        }
+
+        bool placedAll = true;
+        for (unsigned int b = 0; b < oldBucketCount && placedAll; b++)
+        {
+            for (unsigned int i = 0; i < BUCKET_SIZE && placedAll; i++)
+            {
+                if (oldBuckets[b].elements[i] != nullptr)
+                {
+                    unsigned long long key = oldBuckets[b].keys[i];
+                    Member *element = oldBuckets[b].elements[i];
+                    placedAll = place(key, element);
+                }
+            }
+        }
+        for (unsigned int i = 0; i < oldStashCount && placedAll; i++)
+        {
+            unsigned long long key = oldStashKeys[i];
+            Member *element = oldStash[i];
+            placedAll = place(key, element);
+        }
+
+        if (placedAll)
+        {
+            break;
+        }
+
+        // Still a cycle with the new hash functions: try again with twice as many buckets.
+        delete[] buckets;
+        if (newBucketCount > UINT_MAX / 2)
+        {
+            restore();
+            throw UnableToInsertException("Unable to insert element. Cannot grow the table.");
+        }
+        newBucketCount *= 2;
+    }
+
+    delete[] oldBuckets;
+}
+
+// Description: returns true if list is empty, otherwise false
+bool CuckooList::isEmpty() const
+{
+    return elementCount == 0;
+}
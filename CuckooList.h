@@ -0,0 +1,121 @@
+/*
+ * CuckooList.h
+ *
+ * Class Description: List data collection ADT.
+ *                    Based on the Hashing strategy and the collision resolution strategy
+ *                    called bucketized cuckoo hashing:
+ *                    - two hash functions map each indexing key (phone) to two buckets,
+ *                    - each bucket holds BUCKET_SIZE elements and fits in one cache line,
+ *                    - a small stash absorbs the rare element that cannot be placed.
+ *                    A search therefore looks at no more than two buckets (plus the stash,
+ *                    which is empty in the common case), whatever the load of the table.
+ * Class Invariant: Data collection with the following characteristics:
+ *                  - Each element is unique (no duplicates).
+ *                  - Each element is stored in one of its two buckets or in the stash.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef CUCKOO_LIST_H
+#define CUCKOO_LIST_H
+
+#include <string>
+#include "Member.h"
+
+class CuckooList
+{
+
+private:
+  const static unsigned int BUCKET_SIZE = 4; // Number of elements per bucket.
+  const static unsigned int STASH_SIZE = 4;  // Number of elements the stash can hold.
+  const static unsigned int MAX_KICKS = 500; // Evictions tried before we assume a cycle.
+
+  // One bucket is exactly one 64-byte cache line: the packed keys are compared first,
+  // the Member is only dereferenced once its key matches.
+  struct alignas(64) Bucket
+  {
+    unsigned long long keys[BUCKET_SIZE]; // Packed phone numbers (see PhoneKey.h).
+    Member *elements[BUCKET_SIZE];        // nullptr marks an empty cell.
+  };
+
+  // Cell an element was put in by place( ), evicting the element that was there.
+  struct Eviction
+  {
+    unsigned int bucket;
+    unsigned int cell;
+  };
+
+  Bucket *buckets = nullptr;             // Underlying data structure (array of buckets).
+  unsigned int bucketCount = 0;          // Number of buckets, always a power of 2.
+  unsigned long long seed = 0;           // Changing the seed changes both hash functions.
+  unsigned long long stashKeys[STASH_SIZE];
+  Member *stash[STASH_SIZE];             // Elements that could not be placed in their buckets.
+  unsigned int stashCount = 0;
+  unsigned int elementCount = 0;         // Current number of elements stored into Data Collection.
+  unsigned int rehashCount = 0;          // Number of times the table was rebuilt.
+  unsigned int kickCursor = 0;           // Rotates the cell chosen as eviction victim.
+
+  // Description: Computes the two candidate buckets of a packed key.
+  void bucketsOf(unsigned long long key, unsigned int &first, unsigned int &second) const;
+
+  // Description: Places an element without checking for duplicates.
+  // Postcondition: Returns false if the element could not be placed (table needs a rehash);
+  //                key and element then describe the element left without a cell.
+  //                If chain is given, chain[0 .. chainLength - 1] are the cells of the evictions.
+  bool place(unsigned long long &key, Member *&element, Eviction *chain = nullptr, unsigned int *chainLength = nullptr);
+
+  // Description: Undoes the evictions of a failed place( ), last first: key and element (the element left
+  //              without a cell) go back to their cells, until key and element are those place( ) was given.
+  void undoEvictions(const Eviction *chain, unsigned int chainLength, unsigned long long &key, Member *&element);
+
+  // Description: Rebuilds the table with newBucketCount buckets and a new seed.
+  void rehash(unsigned int newBucketCount);
+
+  // Description: Returns the stored element whose key is key, nullptr if there is none.
+  Member *find(unsigned long long key) const;
+
+  // Description: Checks if the table is empty.
+  // Postcondition: List remains unchanged.
+  bool isEmpty() const;
+
+public:
+  // Constructor
+  // Description: Creates a table able to hold about "capacity" elements before it has to grow.
+  CuckooList(unsigned int capacity);
+
+  // Destructor
+  // Description: Destruct a CuckooList object, releasing heap-allocated memory.
+  ~CuckooList();
+
+  // Description: Returns the total element count currently stored in List.
+  // Postcondition: List remains unchanged.
+  unsigned int getElementCount() const;
+
+  // Description: Returns the number of times the table was rebuilt.
+  unsigned int getRehashCount() const;
+
+  // Description: Insert an element.
+  // NOTE: When no free cell can be found (eviction cycle and full stash), the table is rehashed.
+  // Precondition: newElement must not already be in in the List.
+  // Postcondition: newElement inserted and elementCount has been incremented.
+  // Exception: Throws UnableToInsertException if we cannot insert newElement in the List
+  //            (the List is then unchanged), or if its phone is "000-000-0000" (invalid, see Member).
+  // Exception: Throws ElementAlreadyExistsException if newElement is already in the List.
+  void insert(Member &newElement);
+
+  // Description: Returns a pointer to the target element if found.
+  // Postcondition: List remains unchanged.
+  // Exception: Throws EmptyDataCollectionException if the List is empty.
+  // Exception: Throws ElementDoesNotExistException if newElement is not found in the List.
+  Member *search(Member &target) const;
+
+  // Description: Prints all elements stored in the List (unsorted).
+  // Postcondition: List remains unchanged.
+  void printList() const;
+
+  // Description: Prints various stats (load, stash usage, number of rehashes).
+  void printStats() const;
+
+}; // end CuckooList.h
+#endif
@@ -0,0 +1,28 @@
+/*
+ * DataCollectionException.cpp
+ *
+ * Class Description: Base class of the exceptions thrown by the data collection classes.
+ *                    Holds an error category (ErrorCode) and a message with static storage
+ *                    duration (a string literal), so that throwing allocates nothing
+ *                    besides the exception object itself.
+ *
+ * Author: Inspired from our textbook's authors Frank M. Carrano and Tim Henry.
+ *         Copyright (c) 2013 __Pearson Education__. All rights reserved.
+ */
+
+#include "DataCollectionException.h"
+
+// Constructor
+DataCollectionException::DataCollectionException(ErrorCode aCode, const char *aMessage) : code(aCode), message(aMessage) {}
+
+// Description: Returns the error category of this exception.
+ErrorCode DataCollectionException::getCode() const noexcept
+{
+   return code;
+}
+
+// Description: Returns the message of this exception.
+const char *DataCollectionException::what() const noexcept
+{
+   return message;
+}
@@ -0,0 +1,38 @@
+/*
+ * DataCollectionException.h
+ *
+ * Class Description: Base class of the exceptions thrown by the data collection classes.
+ *                    Holds an error category (ErrorCode) and a message with static storage
+ *                    duration (a string literal), so that throwing allocates nothing
+ *                    besides the exception object itself.
+ * Class Invariant: message points to a string that outlives the exception.
+ *
+ * Author: Inspired from our textbook's authors Frank M. Carrano and Tim Henry.
+ *         Copyright (c) 2013 __Pearson Education__. All rights reserved.
+ */
+
+#ifndef DATA_COLLECTION_EXCEPTION_H
+#define DATA_COLLECTION_EXCEPTION_H
+
+#include <exception>
+#include "ErrorCode.h"
+
+class DataCollectionException : public std::exception
+{
+
+private:
+   ErrorCode code;
+   const char *message;
+
+public:
+   // Constructor
+   // Precondition: aMessage has static storage duration (e.g. a string literal).
+   DataCollectionException(ErrorCode aCode, const char *aMessage);
+
+   // Description: Returns the error category of this exception.
+   ErrorCode getCode() const noexcept;
+
+   // Description: Returns the message of this exception.
+   const char *what() const noexcept override;
+};
+#endif
@@ -12,4 +12,4 @@
 #include "ElementAlreadyExistsException.h"
 
 // Constructor
-ElementAlreadyExistsException::ElementAlreadyExistsException(const string &message) : logic_error("ElementAlreadyExistsException") {}
+ElementAlreadyExistsException::ElementAlreadyExistsException(const char *message) : DataCollectionException(ErrorCode::ELEMENT_ALREADY_EXISTS, message) {}
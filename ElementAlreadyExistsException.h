@@ -12,16 +12,15 @@
 #ifndef ELEMENT_ALREADY_EXISTS_EXCEPTION_H
 #define ELEMENT_ALREADY_EXISTS_EXCEPTION_H
 
-#include <stdexcept>
+#include "DataCollectionException.h"
 
-using std::logic_error;
-using std::string;
-
-class ElementAlreadyExistsException : public logic_error
+class ElementAlreadyExistsException : public DataCollectionException
 {
 
 public:
    // Constructor
-   ElementAlreadyExistsException(const string &message);
+   // Description: The message defaults to errorMessage(ErrorCode::ELEMENT_ALREADY_EXISTS).
+   // Precondition: message has static storage duration (e.g. a string literal).
+   explicit ElementAlreadyExistsException(const char *message = errorMessage(ErrorCode::ELEMENT_ALREADY_EXISTS));
 };
 #endif
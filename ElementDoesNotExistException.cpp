@@ -12,4 +12,4 @@
 #include "ElementDoesNotExistException.h"
 
 // Constructor
-ElementDoesNotExistException::ElementDoesNotExistException(const string &message) : logic_error("ElementDoesNotExistException") {}
+ElementDoesNotExistException::ElementDoesNotExistException(const char *message) : DataCollectionException(ErrorCode::ELEMENT_DOES_NOT_EXIST, message) {}
@@ -12,16 +12,15 @@
 #ifndef ELEMENT_DOES_NOT_EXIST_EXCEPTION_H
 #define ELEMENT_DOES_NOT_EXIST_EXCEPTION_H
 
-#include <stdexcept>
+#include "DataCollectionException.h"
 
-using std::logic_error;
-using std::string;
-
-class ElementDoesNotExistException : public logic_error
+class ElementDoesNotExistException : public DataCollectionException
 {
 
 public:
    // Constructor
-   ElementDoesNotExistException(const string &message);
+   // Description: The message defaults to errorMessage(ErrorCode::ELEMENT_DOES_NOT_EXIST).
+   // Precondition: message has static storage duration (e.g. a string literal).
+   explicit ElementDoesNotExistException(const char *message = errorMessage(ErrorCode::ELEMENT_DOES_NOT_EXIST));
 };
 #endif
@@ -10,4 +10,4 @@
 #include "EmptyDataCollectionException.h"
 
 // Constructor
-EmptyDataCollectionException::EmptyDataCollectionException(const string &message) : logic_error(message) {}
+EmptyDataCollectionException::EmptyDataCollectionException(const char *message) : DataCollectionException(ErrorCode::EMPTY_DATA_COLLECTION, message) {}
@@ -10,16 +10,15 @@
 #ifndef EMPTY_DATA_COLLECTION_EXCEPTION_H
 #define EMPTY_DATA_COLLECTION_EXCEPTION_H
 
-#include <stdexcept>
+#include "DataCollectionException.h"
 
-using std::logic_error;
-using std::string;
-
-class EmptyDataCollectionException : public logic_error
+class EmptyDataCollectionException : public DataCollectionException
 {
 
 public:
    // Constructor
-   EmptyDataCollectionException(const string &message);
+   // Description: The message defaults to errorMessage(ErrorCode::EMPTY_DATA_COLLECTION).
+   // Precondition: message has static storage duration (e.g. a string literal).
+   explicit EmptyDataCollectionException(const char *message = errorMessage(ErrorCode::EMPTY_DATA_COLLECTION));
 };
 #endif
@@ -0,0 +1,62 @@
+/*
+ * ErrorCode.cpp
+ *
+ * Description: Error categories shared by the exceptions of the data collection classes
+ *              and by their non-throwing API (tryInsert( ), trySearch( ), tryRemove( )),
+ *              which returns an ErrorCode instead of throwing.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include "ErrorCode.h"
+#include "ElementAlreadyExistsException.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+#include "UnableToInsertException.h"
+#include "UnableToOpenFileException.h"
+
+// Description: Returns the default message of an error category (a string literal).
+const char *errorMessage(ErrorCode code)
+{
+    switch (code)
+    {
+    case ErrorCode::OK:
+        return "No error.";
+    case ErrorCode::ELEMENT_ALREADY_EXISTS:
+        return "Unable to insert element. Element already exists.";
+    case ErrorCode::ELEMENT_DOES_NOT_EXIST:
+        return "Element does not exist in hash table.";
+    case ErrorCode::EMPTY_DATA_COLLECTION:
+        return "Data collection is empty.";
+    case ErrorCode::UNABLE_TO_INSERT:
+        return "Unable to insert element.";
+    case ErrorCode::UNABLE_TO_OPEN_FILE:
+        return "Unable to open file.";
+    case ErrorCode::INVALID_KEY:
+        return "Unable to insert element. Invalid phone number.";
+    }
+    return "Unknown error.";
+}
+
+// Description: Throws the exception matching code, with its default message.
+__attribute__((cold, noinline)) void throwException(ErrorCode code)
+{
+    switch (code)
+    {
+    case ErrorCode::ELEMENT_ALREADY_EXISTS:
+        throw ElementAlreadyExistsException();
+    case ErrorCode::ELEMENT_DOES_NOT_EXIST:
+        throw ElementDoesNotExistException();
+    case ErrorCode::EMPTY_DATA_COLLECTION:
+        throw EmptyDataCollectionException();
+    case ErrorCode::UNABLE_TO_OPEN_FILE:
+        throw UnableToOpenFileException();
+    case ErrorCode::INVALID_KEY:
+        throw UnableToInsertException(ErrorCode::INVALID_KEY);
+    case ErrorCode::OK:
+    case ErrorCode::UNABLE_TO_INSERT:
+        break;
+    }
+    throw UnableToInsertException();
+}
@@ -0,0 +1,37 @@
+/*
+ * ErrorCode.h
+ *
+ * Description: Error categories shared by the exceptions of the data collection classes
+ *              and by their non-throwing API (tryInsert( ), trySearch( ), tryRemove( )),
+ *              which returns an ErrorCode instead of throwing.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef ERROR_CODE_H
+#define ERROR_CODE_H
+
+enum class ErrorCode
+{
+  OK = 0,
+  ELEMENT_ALREADY_EXISTS, // ElementAlreadyExistsException
+  ELEMENT_DOES_NOT_EXIST, // ElementDoesNotExistException
+  EMPTY_DATA_COLLECTION,  // EmptyDataCollectionException
+  UNABLE_TO_INSERT,       // UnableToInsertException
+  UNABLE_TO_OPEN_FILE,    // UnableToOpenFileException
+  INVALID_KEY             // UnableToInsertException of this code: the phone number is not valid (see normalizePhone( ))
+};
+
+// Description: Returns the default message of an error category (a string literal).
+// Time Efficiency: O(1)
+// Space Efficiency: O(1)
+const char *errorMessage(ErrorCode code);
+
+// Description: Throws the exception matching code, with its default message.
+//              Used by the throwing API on top of the non-throwing one; kept out of line
+//              so that the callers' hot path only tests the code.
+// Precondition: code is not ErrorCode::OK.
+[[noreturn]] void throwException(ErrorCode code);
+
+#endif
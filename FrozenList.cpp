@@ -0,0 +1,154 @@
+/*
+ * FrozenList.cpp
+ *
+ * Class Description: Read-only, compact copy of a List: a dense array of members positioned by a
+ *                    minimal perfect hash function over their packed phone numbers.
+ * Class Invariant: - The member whose packed phone is k is at members[index.indexOf(k)].
+ *                  - The contents never change after construction.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include "FrozenList.h"
+#include "List.h"
+#include "PhoneKey.h"
+#include "ElementDoesNotExistException.h"
+#include "EmptyDataCollectionException.h"
+
+using namespace std;
+
+// Constructor
+// Description: Builds the perfect hash function over the phones of list, then copies each element to its position.
+FrozenList::FrozenList(const List &list) : index(keysOf(list))
+{
+    members = new Member[index.getKeyCount()];
+    for (List::const_iterator it = list.begin(); it != list.end(); ++it)
+    {
+        members[index.indexOf(it->getPhoneKey())] = *it;
+    }
+}
+
+// Destructor
+FrozenList::~FrozenList()
+{
+    delete[] members;
+    members = nullptr;
+}
+
+// Description: Returns the element count.
+unsigned int FrozenList::getElementCount() const
+{
+    return index.getKeyCount();
+}
+
+// Description: Looks up the element with the same indexing key (phone) as target.
+ErrorCode FrozenList::trySearch(const Member &target, const Member *&found) const
+{
+    found = nullptr;
+    if (getElementCount() == 0)
+    {
+        return ErrorCode::EMPTY_DATA_COLLECTION;
+    }
+
+    found = find(target.getPhoneKey());
+    return (found == nullptr) ? ErrorCode::ELEMENT_DOES_NOT_EXIST : ErrorCode::OK;
+}
+
+// Description: Returns a pointer to the element with the same indexing key (phone) as target.
+// Exception: Throws EmptyDataCollectionException if the FrozenList is empty.
+// Exception: Throws ElementDoesNotExistException if target is not found.
+const Member *FrozenList::search(const Member &target) const
+{
+    const Member *found = nullptr;
+    ErrorCode code = trySearch(target, found);
+    if (code != ErrorCode::OK)
+    {
+        throwException(code);
+    }
+    return found;
+}
+
+// Description: Returns the element whose phone is phone (in any format normalizePhone( ) accepts), nullptr if none.
+const Member *FrozenList::find(const string &phone) const
+{
+    unsigned long long key = INVALID_PHONE_KEY;
+    return normalizePhone(phone, key) ? find(key) : nullptr;
+}
+
+// Description: Returns a pointer to the first element.
+const Member *FrozenList::begin() const
+{
+    return members;
+}
+
+// Description: Returns a pointer past the last element.
+const Member *FrozenList::end() const
+{
+    return members + getElementCount();
+}
+
+// Description: Writes all elements to os, one per line, through a local buffer (as List::exportTo( )).
+void FrozenList::exportTo(ostream &os) const
+{
+    const unsigned int BUFFER_SIZE = 1 << 16;
+    string buffer;
+    buffer.reserve(BUFFER_SIZE + 256);
+
+    for (const Member *member = begin(); member != end(); ++member)
+    {
+        buffer += member->getName();
+        buffer += ", ";
+        buffer += member->getPhone();
+        buffer += ", ";
+        buffer += member->getEmail();
+        buffer += ", ";
+        buffer += member->getCreditCard();
+        buffer += '\n';
+
+        if (buffer.size() >= BUFFER_SIZE)
+        {
+            os.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    os.write(buffer.data(), buffer.size());
+}
+
+// Description: Returns the memory used by the perfect hash function, in bytes.
+unsigned long long FrozenList::getIndexMemoryUsage() const
+{
+    return index.getMemoryUsage();
+}
+
+// Description: Returns the number of bits of index per element.
+double FrozenList::getIndexBitsPerKey() const
+{
+    return (getElementCount() == 0) ? 0 : index.getMemoryUsage() * 8.0 / getElementCount();
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Returns the element whose packed phone is key, nullptr if none.
+//              A key outside the set maps to an arbitrary member (or none): its key is compared.
+const Member *FrozenList::find(unsigned long long key) const
+{
+    unsigned int i = index.indexOf(key);
+    if (i >= getElementCount() || members[i].getPhoneKey() != key)
+    {
+        return nullptr;
+    }
+    return &members[i];
+}
+
+// Description: Returns the packed phone number of every element of list.
+vector<unsigned long long> FrozenList::keysOf(const List &list)
+{
+    vector<unsigned long long> keys;
+    keys.reserve(list.getElementCount());
+    for (List::const_iterator it = list.begin(); it != list.end(); ++it)
+    {
+        keys.push_back(it->getPhoneKey());
+    }
+    return keys;
+}
@@ -0,0 +1,86 @@
+/*
+ * FrozenList.h
+ *
+ * Class Description: Read-only, compact copy of a List (see List::freeze( )), for archived rosters.
+ *                    The members are stored by value in a dense array of exactly getElementCount( )
+ *                    entries (no empty cell, no tombstone, no pointer per element); a minimal perfect
+ *                    hash function over the packed phone numbers (PhonePerfectHash) gives the position
+ *                    of each member in the array, in about 3.5 bits per member.
+ *                    A search compares the packed phone of the member at that position with the target's.
+ * Class Invariant: - The member whose packed phone is k is at members[index.indexOf(k)].
+ *                  - The contents never change after construction.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef FROZEN_LIST_H
+#define FROZEN_LIST_H
+
+#include <ostream>
+#include <string>
+#include "Member.h"
+#include "ErrorCode.h"
+#include "PhonePerfectHash.h"
+
+class List;
+
+class FrozenList
+{
+
+private:
+  PhonePerfectHash index;
+  Member *members = nullptr; // Dense array of index.getKeyCount( ) members, in index order.
+
+  // Description: Returns the packed phone number of every element of list.
+  static vector<unsigned long long> keysOf(const List &list);
+
+  // Description: Returns the element whose packed phone is key, nullptr if none.
+  const Member *find(unsigned long long key) const;
+
+public:
+  // Constructor
+  // Description: Copies the elements of list. The list is unchanged.
+  // Time Efficiency: O(n) expected
+  FrozenList(const List &list);
+
+  // Destructor
+  ~FrozenList();
+
+  FrozenList(const FrozenList &) = delete;
+  FrozenList &operator=(const FrozenList &) = delete;
+
+  // Description: Returns the element count.
+  unsigned int getElementCount() const;
+
+  // Description: Looks up the element with the same indexing key (phone) as target.
+  // Postcondition: If ErrorCode::OK is returned, found points to the element. Otherwise found is
+  //                nullptr and the code is ErrorCode::EMPTY_DATA_COLLECTION or ErrorCode::ELEMENT_DOES_NOT_EXIST.
+  ErrorCode trySearch(const Member &target, const Member *&found) const;
+
+  // Description: Returns a pointer to the element with the same indexing key (phone) as target.
+  // Exception: Throws EmptyDataCollectionException if the FrozenList is empty.
+  // Exception: Throws ElementDoesNotExistException if target is not found.
+  const Member *search(const Member &target) const;
+
+  // Description: Returns the element whose phone is phone, nullptr if none. phone may be in any format
+  //              normalizePhone( ) accepts, e.g. "(604) 853-1423".
+  const Member *find(const string &phone) const;
+
+  // Description: Returns a pointer to the first element (iteration in index order, over [begin( ), end( ))).
+  const Member *begin() const;
+
+  // Description: Returns a pointer past the last element.
+  const Member *end() const;
+
+  // Description: Writes all elements to os, one per line, as List::exportTo( ) (full credit card numbers).
+  void exportTo(ostream &os) const;
+
+  // Description: Returns the memory used by the perfect hash function (the index), in bytes.
+  unsigned long long getIndexMemoryUsage() const;
+
+  // Description: Returns the number of bits of index per element.
+  double getIndexBitsPerKey() const;
+};
+
+#endif
@@ -0,0 +1,54 @@
+/*
+ * HashFamily.cpp
+ *
+ * Class Description: Ordered family of hash functions of phone numbers, weakest first, for the
+ *                    adaptive hashing of List.
+ * Class Invariant: - Exactly one of plain and seeded is set in each function.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include "HashFamily.h"
+#include "PhoneKey.h"
+
+using namespace std;
+
+// Description: Returns the family of the hash functions of PhoneKey.h.
+HashFamily HashFamily::standard()
+{
+    HashFamily family;
+    family.add("hashPhone", hashPhone);
+    family.addSeeded("hashPhoneSeeded", hashPhoneSeeded);
+    return family;
+}
+
+// Description: Registers a hash function after those already registered.
+void HashFamily::add(const string &name, HashFcn fcn)
+{
+    Function function;
+    function.name = name;
+    function.plain = fcn;
+    functions.push_back(function);
+}
+
+// Description: Registers a seeded hash function after those already registered.
+void HashFamily::addSeeded(const string &name, SeededHashFcn fcn)
+{
+    Function function;
+    function.name = name;
+    function.seeded = fcn;
+    functions.push_back(function);
+}
+
+// Description: Returns the number of functions registered.
+unsigned int HashFamily::size() const
+{
+    return (unsigned int)functions.size();
+}
+
+// Description: Returns the function registered in position i.
+const HashFamily::Function &HashFamily::at(unsigned int i) const
+{
+    return functions[i];
+}
@@ -0,0 +1,63 @@
+/*
+ * HashFamily.h
+ *
+ * Class Description: Ordered family of hash functions of phone numbers, from which a List with adaptive
+ *                    hashing (List::enableAdaptiveHashing( )) picks the next function to rehash with
+ *                    when its probe sequences get too long for its load factor.
+ *                    Functions are registered weakest first. A seeded function stands for a whole
+ *                    family of functions, one per seed: once it is reached, each further switch
+ *                    reseeds it instead of moving on.
+ *                    Example: HashFamily family; family.add("hashFoldShift", hashFoldShift);
+ *                             family.addSeeded("hashPhoneSeeded", hashPhoneSeeded);
+ * Class Invariant: - Exactly one of plain and seeded is set in each function.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef HASH_FAMILY_H
+#define HASH_FAMILY_H
+
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+class HashFamily
+{
+
+public:
+  typedef unsigned int (*HashFcn)(string);
+  typedef unsigned int (*SeededHashFcn)(const string &, unsigned long long);
+
+  // A registered hash function.
+  struct Function
+  {
+    string name;
+    HashFcn plain = nullptr;
+    SeededHashFcn seeded = nullptr;
+  };
+
+private:
+  vector<Function> functions;
+
+public:
+  // Description: Returns the family of the hash functions of PhoneKey.h: hashPhone, then hashPhoneSeeded.
+  static HashFamily standard();
+
+  // Description: Registers a hash function after those already registered.
+  void add(const string &name, HashFcn fcn);
+
+  // Description: Registers a seeded hash function after those already registered.
+  void addSeeded(const string &name, SeededHashFcn fcn);
+
+  // Description: Returns the number of functions registered.
+  unsigned int size() const;
+
+  // Description: Returns the function registered in position i (0: the first registered).
+  // Precondition: i < size( ).
+  const Function &at(unsigned int i) const;
+};
+
+#endif
@@ -0,0 +1,731 @@
+/*
+ * HashTable.h
+ *
+ * Class Description: Generic hash table based on the open addressing collision resolution strategy.
+ *                    Stores pointers to Value objects, indexed by the Key that KeyOf extracts from
+ *                    a Value and that Hash turns into a hash index. The table does not own the values.
+ *                    Compile-time policy (TablePolicy):
+ *                    - capacity: FixedCapacity<N> embeds N cells in the object itself (no heap
+ *                      allocation, capacity is a constant), DynamicCapacity allocates the cells
+ *                      on the heap with a capacity chosen at construction, optionally on
+ *                      huge pages (TableAllocation::HUGE_PAGES),
+ *                    - probing: LinearProbing or QuadraticProbing (the capacity is then a power of 2),
+ *                    - stats: whether a per-cell collision counter is maintained.
+ *                    Removal leaves a tombstone; tombstones are cleared by compact( ), which runs
+ *                    by itself once they fill 1/TOMBSTONE_RATIO of the cells.
+ *                    Example: HashTable<string, Member, PhoneHash, MemberPhone, TablePolicy<FixedCapacity<103>>>
+ * Class Invariant: - Each key is stored at most once.
+ *                  - A stored value is reachable from the home index of its key by following the
+ *                    probe sequence through occupied cells and tombstones only.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef HASH_TABLE_H
+#define HASH_TABLE_H
+
+#include <cstddef>
+#include <iterator>
+#include "ErrorCode.h"
+#include "PageAllocation.h"
+#include "UnableToInsertException.h"
+
+////////////////////////////// Capacity policies ///////////////////////////
+
+// Cells embedded in the table object: capacity N is a compile-time constant.
+template <unsigned int N>
+struct FixedCapacity
+{
+  static constexpr unsigned int fixedCapacity = N;
+
+  template <class T, bool CollectStats>
+  class Storage
+  {
+  public:
+    T *cells[N];
+    unsigned long long occupied[(N + 63) / 64];
+    unsigned int collisions[CollectStats ? N : 1];
+
+    Storage(unsigned int, TableAllocation) {}
+    static constexpr unsigned int capacity() { return N; }
+    static constexpr bool usesHugePages() { return false; }
+  };
+};
+
+// Cells allocated on the heap: capacity chosen when the table is constructed.
+// With TableAllocation::HUGE_PAGES the arrays are backed by transparent huge pages (see PageAllocation.h).
+struct DynamicCapacity
+{
+  static constexpr unsigned int fixedCapacity = 0; // Not fixed.
+
+  template <class T, bool CollectStats>
+  class Storage
+  {
+  private:
+    unsigned int size;
+    TableBlock cellsBlock;
+    TableBlock occupiedBlock;
+    TableBlock collisionsBlock;
+
+  public:
+    T **cells = nullptr;
+    unsigned long long *occupied = nullptr;
+    unsigned int *collisions = nullptr;
+
+    Storage(unsigned int aCapacity, TableAllocation allocation) : size(aCapacity)
+    {
+      if (size == 0)
+      {
+        throw UnableToInsertException("A hash table needs at least one cell.");
+      }
+      // The destructor does not run if the constructor throws: release the blocks already allocated.
+      try
+      {
+        cellsBlock = allocateTable(sizeof(T *) * size, allocation);
+        occupiedBlock = allocateTable(sizeof(unsigned long long) * ((size + 63) / 64), allocation);
+        collisionsBlock = allocateTable(sizeof(unsigned int) * (CollectStats ? size : 1), allocation);
+      }
+      catch (...)
+      {
+        releaseTable(cellsBlock);
+        releaseTable(occupiedBlock);
+        throw;
+      }
+      cells = (T **)cellsBlock.memory;
+      occupied = (unsigned long long *)occupiedBlock.memory;
+      collisions = (unsigned int *)collisionsBlock.memory;
+    }
+    ~Storage()
+    {
+      releaseTable(cellsBlock);
+      releaseTable(occupiedBlock);
+      releaseTable(collisionsBlock);
+    }
+    Storage(const Storage &) = delete;
+    Storage &operator=(const Storage &) = delete;
+
+    unsigned int capacity() const { return size; }
+    bool usesHugePages() const { return cellsBlock.hugePages; }
+  };
+};
+
+////////////////////////////// Probing policies ///////////////////////////
+
+// Next cell is the following one: h, h+1, h+2, ...
+struct LinearProbing
+{
+  static constexpr bool isLinear = true;
+  // Every capacity lets the probe sequence visit every cell.
+  static constexpr bool coversCapacity(unsigned int capacity) { return true; }
+  static unsigned int capacityFor(unsigned int requested) { return requested; }
+  static unsigned int next(unsigned int index, unsigned int probe, unsigned int capacity)
+  {
+    return (index + 1) % capacity;
+  }
+};
+
+// Offsets grow by one each probe: h, h+1, h+3, h+6, ... (visits every cell when the capacity is a power of 2).
+struct QuadraticProbing
+{
+  static constexpr bool isLinear = false;
+  // Other capacities leave cells the probe sequence never visits: inserting, compacting or
+  // rehashing could then find no free cell while the table has some.
+  static constexpr bool coversCapacity(unsigned int capacity) { return capacity != 0 && (capacity & (capacity - 1)) == 0; }
+  // Description: Returns the smallest power of 2 >= requested (0 if requested is 0).
+  // Exception: Throws UnableToInsertException if requested is above 2^31.
+  static unsigned int capacityFor(unsigned int requested)
+  {
+    if (requested > (1u << 31))
+    {
+      throw UnableToInsertException("A quadratic probing table cannot hold that many cells.");
+    }
+    unsigned int capacity = 1;
+    while (capacity < requested)
+    {
+      capacity <<= 1;
+    }
+    return (requested == 0) ? 0 : capacity;
+  }
+  static unsigned int next(unsigned int index, unsigned int probe, unsigned int capacity)
+  {
+    return (unsigned int)(((unsigned long long)index + probe) % capacity);
+  }
+};
+
+// Bundles the compile-time choices of a HashTable.
+template <class Capacity = DynamicCapacity, class Probing = LinearProbing, bool CollectStats = true>
+struct TablePolicy
+{
+  typedef Capacity capacity_policy;
+  typedef Probing probing_policy;
+  static constexpr bool collectStats = CollectStats;
+};
+
+////////////////////////////// HashTable ///////////////////////////
+
+template <class Key, class Value, class Hash, class KeyOf, class Policy = TablePolicy<>>
+class HashTable
+{
+
+private:
+  typedef typename Policy::probing_policy Probing;
+  typedef typename Policy::capacity_policy::template Storage<Value, Policy::collectStats> Storage;
+
+  static_assert(Policy::capacity_policy::fixedCapacity == 0 ||
+                    Probing::coversCapacity(Policy::capacity_policy::fixedCapacity),
+                "The probe sequence must visit every cell of a FixedCapacity table (QuadraticProbing: a power of 2).");
+
+  Storage storage;               // Cells, occupancy bitmap and collision counters.
+  Hash hash;                     // Computes the hash index of a key (reduced modulo the capacity).
+  KeyOf keyOf;                   // Extracts the key of a value.
+  unsigned int elementCount = 0; // Current number of values stored.
+  unsigned int tombstoneCount = 0;
+  unsigned int compactionCount = 0;
+  unsigned long long insertProbeCount = 0; // Cells visited by the successful insertions so far.
+
+  // Description: Tombstone: a cell holding this address held a removed value. Never dereferenced.
+  static Value *deleted()
+  {
+    static char marker;
+    return reinterpret_cast<Value *>(&marker);
+  }
+
+  void setOccupied(unsigned int index) { storage.occupied[index / 64] |= 1ULL << (index % 64); }
+  void clearOccupied(unsigned int index) { storage.occupied[index / 64] &= ~(1ULL << (index % 64)); }
+
+  // Description: Places a value whose key is known to be absent, without touching the stats.
+  void place(Value *element)
+  {
+    unsigned int index = home(keyOf(*element));
+    for (unsigned int probe = 1; storage.cells[index] != nullptr && storage.cells[index] != deleted(); probe++)
+    {
+      index = Probing::next(index, probe, capacity());
+    }
+    storage.cells[index] = element;
+  }
+
+public:
+  const static unsigned int TOMBSTONE_RATIO = 8; // Compact once tombstones fill 1/TOMBSTONE_RATIO of the cells.
+  const static unsigned int SCAN_PREFETCH_DISTANCE = 16; // Cells between a value visited and the value prefetched.
+
+  // Forward iterator over the stored values (in cell order).
+  class const_iterator
+  {
+  private:
+    const HashTable *table;
+    unsigned int cell;
+
+  public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef Value value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const Value *pointer;
+    typedef const Value &reference;
+
+    const_iterator(const HashTable *aTable, unsigned int aCell) : table(aTable), cell(aCell) {}
+
+    reference operator*() const { return *table->storage.cells[cell]; }
+    pointer operator->() const { return table->storage.cells[cell]; }
+    const_iterator &operator++()
+    {
+      cell = table->nextOccupied(cell + 1);
+      // Values are visited in cell order but lie scattered in memory: the value SCAN_PREFETCH_DISTANCE
+      // cells ahead is prefetched, so that the cache misses of a scan overlap.
+      unsigned int ahead = cell + SCAN_PREFETCH_DISTANCE;
+      if (ahead < table->capacity())
+      {
+        Value *value = table->storage.cells[ahead];
+        if (value != nullptr && value != deleted())
+        {
+          __builtin_prefetch(value);
+        }
+      }
+      return *this;
+    }
+    const_iterator operator++(int)
+    {
+      const_iterator before = *this;
+      ++(*this);
+      return before;
+    }
+    bool operator==(const const_iterator &rhs) const { return cell == rhs.cell && table == rhs.table; }
+    bool operator!=(const const_iterator &rhs) const { return !(*this == rhs); }
+
+    // Description: Returns the cell index of the current value.
+    unsigned int index() const { return cell; }
+  };
+
+  // Constructor
+  // Description: Creates an empty table. aCapacity is ignored with FixedCapacity. With QuadraticProbing,
+  //              a DynamicCapacity table gets aCapacity rounded up to a power of 2.
+  // Exception: Throws UnableToInsertException if a DynamicCapacity table gets no cell, or too many.
+  explicit HashTable(unsigned int aCapacity, Hash aHash = Hash(), KeyOf aKeyOf = KeyOf(),
+                     TableAllocation allocation = TableAllocation::HEAP)
+      : storage(Probing::capacityFor(aCapacity), allocation), hash(aHash), keyOf(aKeyOf)
+  {
+    for (unsigned int i = 0; i < capacity(); i++)
+    {
+      storage.cells[i] = nullptr;
+    }
+    for (unsigned int w = 0; w < (capacity() + 63) / 64; w++)
+    {
+      storage.occupied[w] = 0;
+    }
+    for (unsigned int i = 0; i < (Policy::collectStats ? capacity() : 1); i++)
+    {
+      storage.collisions[i] = 0;
+    }
+  }
+
+  HashTable(const HashTable &) = delete;
+  HashTable &operator=(const HashTable &) = delete;
+
+  unsigned int capacity() const { return storage.capacity(); }
+  bool usesHugePages() const { return storage.usesHugePages(); }
+  unsigned int size() const { return elementCount; }
+  unsigned int tombstones() const { return tombstoneCount; }
+  unsigned int compactions() const { return compactionCount; }
+  unsigned long long insertProbes() const { return insertProbeCount; }
+
+  // Description: Returns the memory used by the cells, the occupancy bitmap and the collision counts, in bytes
+  //              (not by the values they point to).
+  unsigned long long memoryUsage() const
+  {
+    return (unsigned long long)capacity() * (sizeof(Value *) + (Policy::collectStats ? sizeof(unsigned int) : 0)) +
+           (capacity() + 63) / 64 * sizeof(unsigned long long);
+  }
+
+  // Description: Returns the home index of a key.
+  unsigned int home(const Key &key) const { return hash(key) % capacity(); }
+
+  // Description: Returns the value stored in a cell, nullptr if the cell is empty or a tombstone.
+  Value *at(unsigned int index) const
+  {
+    Value *element = storage.cells[index];
+    return (element == deleted()) ? nullptr : element;
+  }
+
+  // Description: Returns the number of times an insertion moved on from this cell's predecessor
+  //              to this cell (0 if stats are not collected).
+  unsigned int collisionsAt(unsigned int index) const
+  {
+    return Policy::collectStats ? storage.collisions[index] : 0;
+  }
+
+  // Description: Returns the index of the cell holding the value whose key is key, capacity() if none.
+  //              Follows the probe sequence until an empty cell; tombstones do not end it.
+  unsigned int findCell(const Key &key) const
+  {
+    unsigned int index = home(key);
+    for (unsigned int probe = 1; probe <= capacity() && storage.cells[index] != nullptr; probe++)
+    {
+      if (storage.cells[index] != deleted() && keyOf(*storage.cells[index]) == key)
+      {
+        return index;
+      }
+      index = Probing::next(index, probe, capacity());
+    }
+    return capacity();
+  }
+
+  // Description: Returns the value whose key is key, nullptr if none.
+  Value *find(const Key &key) const
+  {
+    unsigned int index = findCell(key);
+    return (index == capacity()) ? nullptr : storage.cells[index];
+  }
+
+  // Description: Prefetches the home cell of key (before an insert( ) or find( ) of key a little later).
+  void prefetch(const Key &key) const
+  {
+    __builtin_prefetch(&storage.cells[home(key)]);
+  }
+
+  // Description: Returns the number of cells a search of key visits (the cell holding it or the empty
+  //              cell ending its probe sequence included).
+  unsigned int probeLength(const Key &key) const
+  {
+    unsigned int index = home(key);
+    unsigned int probe = 1;
+    for (; probe <= capacity() && storage.cells[index] != nullptr; probe++)
+    {
+      if (storage.cells[index] != deleted() && keyOf(*storage.cells[index]) == key)
+      {
+        return probe;
+      }
+      index = Probing::next(index, probe, capacity());
+    }
+    return (probe > capacity()) ? capacity() : probe;
+  }
+
+  // Description: Inserts a value. Reuses the first tombstone of the probe sequence if the key is new.
+  //              Non-throwing: the outcome is returned as an ErrorCode.
+  // Postcondition: If ErrorCode::OK is returned, cell is the index of the cell now holding element.
+  //                Otherwise the table is unchanged (but for the collision counters):
+  //                ErrorCode::UNABLE_TO_INSERT if the table is full or the probe sequence has no free cell,
+  //                ErrorCode::ELEMENT_ALREADY_EXISTS if a value with the same key is stored.
+  ErrorCode tryInsert(Value &element, unsigned int &cell)
+  {
+    if (elementCount == capacity())
+    {
+      return ErrorCode::UNABLE_TO_INSERT;
+    }
+
+    Key key = keyOf(element);
+    unsigned int index = home(key);
+    unsigned int freeCell = capacity();
+    unsigned int probe = 1;
+    for (; probe <= capacity() && storage.cells[index] != nullptr; probe++)
+    {
+      if (storage.cells[index] == deleted())
+      {
+        if (freeCell == capacity())
+        {
+          freeCell = index;
+        }
+      }
+      else if (storage.cells[index] == &element || keyOf(*storage.cells[index]) == key)
+      {
+        return ErrorCode::ELEMENT_ALREADY_EXISTS;
+      }
+      index = Probing::next(index, probe, capacity());
+      if (Policy::collectStats)
+      {
+        storage.collisions[index]++;
+      }
+    }
+
+    if (freeCell != capacity())
+    {
+      index = freeCell;
+      tombstoneCount--;
+    }
+    else if (storage.cells[index] != nullptr)
+    {
+      return ErrorCode::UNABLE_TO_INSERT;
+    }
+
+    storage.cells[index] = &element;
+    setOccupied(index);
+    elementCount++;
+    insertProbeCount += probe;
+    cell = index;
+    return ErrorCode::OK;
+  }
+
+  // Description: Inserts a value. Reuses the first tombstone of the probe sequence if the key is new.
+  // Postcondition: Returns the index of the cell now holding element.
+  // Exception: Throws UnableToInsertException if the table is full or the probe sequence
+  //            has no free cell.
+  // Exception: Throws ElementAlreadyExistsException if a value with the same key is stored.
+  unsigned int insert(Value &element)
+  {
+    unsigned int cell = 0;
+    ErrorCode code = tryInsert(element, cell);
+    if (code != ErrorCode::OK)
+    {
+      throwException(code);
+    }
+    return cell;
+  }
+
+  // Description: Removes the value whose key is key, leaving a tombstone in its cell.
+  //              Compacts the table when tombstones fill 1/TOMBSTONE_RATIO of the cells.
+  // Postcondition: Returns the removed value (the caller decides what to do with it), nullptr if none.
+  Value *remove(const Key &key)
+  {
+    unsigned int index = findCell(key);
+    if (index == capacity())
+    {
+      return nullptr;
+    }
+
+    Value *element = storage.cells[index];
+    storage.cells[index] = deleted();
+    clearOccupied(index);
+    elementCount--;
+    tombstoneCount++;
+
+    if (tombstoneCount * TOMBSTONE_RATIO >= capacity())
+    {
+      compact();
+    }
+    return element;
+  }
+
+  // Description: Looks up a batch of keys: results[i] is the value whose key is keys[i], or nullptr.
+  //              Keys are processed in groups of PREFETCH_GROUP:
+  //              1. hash every key of the group and prefetch its home cell,
+  //              2. load every home cell and prefetch the value it points to,
+  //              3. resolve each lookup; by now most of the data is in cache.
+  void findMany(const Key *keys, Value **results, unsigned int count) const
+  {
+    const unsigned int PREFETCH_GROUP = 16;
+    unsigned int homes[PREFETCH_GROUP];
+
+    for (unsigned int start = 0; start < count; start += PREFETCH_GROUP)
+    {
+      unsigned int groupSize = (count - start < PREFETCH_GROUP) ? count - start : PREFETCH_GROUP;
+
+      for (unsigned int g = 0; g < groupSize; g++)
+      {
+        homes[g] = home(keys[start + g]);
+        __builtin_prefetch(&storage.cells[homes[g]]);
+      }
+
+      for (unsigned int g = 0; g < groupSize; g++)
+      {
+        Value *first = storage.cells[homes[g]];
+        if (first != nullptr && first != deleted())
+        {
+          __builtin_prefetch(first);
+          __builtin_prefetch((const char *)first + 64);
+        }
+      }
+
+      for (unsigned int g = 0; g < groupSize; g++)
+      {
+        const Key &key = keys[start + g];
+        unsigned int index = homes[g];
+        Value *found = nullptr;
+        for (unsigned int probe = 1; probe <= capacity() && storage.cells[index] != nullptr; probe++)
+        {
+          if (storage.cells[index] != deleted() && keyOf(*storage.cells[index]) == key)
+          {
+            found = storage.cells[index];
+            break;
+          }
+          index = Probing::next(index, probe, capacity());
+        }
+        results[start + g] = found;
+      }
+    }
+  }
+
+  // State of a find( ) suspended at a cache miss: beginFind( ) then resumeFind( ) until it returns true.
+  struct Lookup
+  {
+    unsigned int index = 0;     // Cell to read next (prefetched), unless candidate is set.
+    unsigned int probe = 0;     // Cells visited so far.
+    Value *candidate = nullptr; // Value whose key is compared next (prefetched).
+    Value *result = nullptr;    // Set when resumeFind( ) returns true.
+  };
+
+  // Description: Starts a find( ) of key: computes its home cell and prefetches it.
+  void beginFind(const Key &key, Lookup &lookup) const
+  {
+    lookup.index = home(key);
+    lookup.probe = 1;
+    lookup.candidate = nullptr;
+    lookup.result = nullptr;
+    __builtin_prefetch(&storage.cells[lookup.index]);
+  }
+
+  // Description: Carries on a find( ) of key up to its next cache miss: reads the cell or the value
+  //              prefetched by the previous step, prefetches the next one it needs and returns false,
+  //              or returns true once lookup.result is known (nullptr if key is not stored).
+  //              Cells of the same cache line are visited without suspending.
+  bool resumeFind(const Key &key, Lookup &lookup) const
+  {
+    while (true)
+    {
+      if (lookup.candidate == nullptr)
+      {
+        Value *element = storage.cells[lookup.index];
+        if (element == nullptr)
+        {
+          return true;
+        }
+        if (element != deleted())
+        {
+          lookup.candidate = element;
+          __builtin_prefetch(element);
+          __builtin_prefetch((const char *)element + 64);
+          return false;
+        }
+      }
+      else if (keyOf(*lookup.candidate) == key)
+      {
+        lookup.result = lookup.candidate;
+        return true;
+      }
+      lookup.candidate = nullptr;
+      if (lookup.probe >= capacity())
+      {
+        return true;
+      }
+      size_t line = (size_t)&storage.cells[lookup.index] / 64;
+      lookup.index = Probing::next(lookup.index, lookup.probe++, capacity());
+      if ((size_t)&storage.cells[lookup.index] / 64 != line)
+      {
+        __builtin_prefetch(&storage.cells[lookup.index]);
+        return false;
+      }
+    }
+  }
+
+  // Description: Returns the index of the first occupied cell at or after index, capacity() if none.
+  //              Skips 64 empty cells at a time using the occupancy bitmap.
+  unsigned int nextOccupied(unsigned int index) const
+  {
+    if (index >= capacity())
+    {
+      return capacity();
+    }
+
+    unsigned int w = index / 64;
+    unsigned long long bits = storage.occupied[w] & (~0ULL << (index % 64));
+    unsigned int words = (capacity() + 63) / 64;
+    while (bits == 0)
+    {
+      w++;
+      if (w == words)
+      {
+        return capacity();
+      }
+      bits = storage.occupied[w];
+    }
+    return w * 64 + __builtin_ctzll(bits);
+  }
+
+  const_iterator begin() const { return const_iterator(this, nextOccupied(0)); }
+  const_iterator end() const { return const_iterator(this, capacity()); }
+
+  // Description: Returns the average number of cells visited by a successful search
+  //              (1 when every value sits at its home index).
+  double averageProbeLength() const
+  {
+    if (elementCount == 0)
+    {
+      return 0;
+    }
+
+    unsigned long long cells = 0;
+    for (unsigned int i = nextOccupied(0); i < capacity(); i = nextOccupied(i + 1))
+    {
+      unsigned int index = home(keyOf(*storage.cells[i]));
+      unsigned int probe = 1;
+      while (index != i)
+      {
+        index = Probing::next(index, probe, capacity());
+        probe++;
+      }
+      cells += probe;
+    }
+    return (double)cells / elementCount;
+  }
+
+  // Description: Removes every tombstone.
+  //              With linear probing this is done in place: the sweep starts right after an empty
+  //              cell (a cluster boundary), turns the tombstones of each cluster into empty cells and
+  //              re-inserts each value of the cluster in turn; a value can only move back, into a
+  //              cell of its own probe sequence, so the values already re-inserted remain reachable.
+  //              Otherwise (or if there is no empty cell at all) the values are re-inserted from a
+  //              temporary array.
+  void compact()
+  {
+    unsigned int start = capacity();
+    if (Probing::isLinear)
+    {
+      for (unsigned int i = 0; i < capacity() && start == capacity(); i++)
+      {
+        if (storage.cells[i] == nullptr)
+        {
+          start = (i + 1) % capacity();
+        }
+      }
+    }
+
+    if (start == capacity())
+    {
+      Value **elements = new Value *[elementCount];
+      unsigned int count = 0;
+      for (unsigned int i = 0; i < capacity(); i++)
+      {
+        if (storage.cells[i] != nullptr && storage.cells[i] != deleted())
+        {
+          elements[count++] = storage.cells[i];
+        }
+        storage.cells[i] = nullptr;
+      }
+      for (unsigned int e = 0; e < count; e++)
+      {
+        place(elements[e]);
+      }
+      delete[] elements;
+    }
+    else
+    {
+      for (unsigned int step = 0; step < capacity(); step++)
+      {
+        unsigned int cell = (start + step) % capacity();
+        Value *element = storage.cells[cell];
+        storage.cells[cell] = nullptr;
+        if (element != nullptr && element != deleted())
+        {
+          place(element);
+        }
+      }
+    }
+
+    for (unsigned int w = 0; w < (capacity() + 63) / 64; w++)
+    {
+      storage.occupied[w] = 0;
+    }
+    for (unsigned int i = 0; i < capacity(); i++)
+    {
+      if (storage.cells[i] != nullptr)
+      {
+        setOccupied(i);
+      }
+    }
+
+    tombstoneCount = 0;
+    compactionCount++;
+  }
+
+  // Description: Replaces the hash function and re-inserts every value with it, from a temporary array.
+  //              Tombstones are cleared and the collision counters recounted for the new placement.
+  void rehash(Hash aHash)
+  {
+    Value **elements = new Value *[elementCount];
+    unsigned int count = 0;
+    for (unsigned int i = 0; i < capacity(); i++)
+    {
+      if (storage.cells[i] != nullptr && storage.cells[i] != deleted())
+      {
+        elements[count++] = storage.cells[i];
+      }
+      storage.cells[i] = nullptr;
+      if (Policy::collectStats)
+      {
+        storage.collisions[i] = 0;
+      }
+    }
+    for (unsigned int w = 0; w < (capacity() + 63) / 64; w++)
+    {
+      storage.occupied[w] = 0;
+    }
+
+    hash = aHash;
+    for (unsigned int e = 0; e < count; e++)
+    {
+      unsigned int index = home(keyOf(*elements[e]));
+      for (unsigned int probe = 1; storage.cells[index] != nullptr; probe++)
+      {
+        index = Probing::next(index, probe, capacity());
+        if (Policy::collectStats)
+        {
+          storage.collisions[index]++;
+        }
+      }
+      storage.cells[index] = elements[e];
+      setOccupied(index);
+    }
+    delete[] elements;
+    tombstoneCount = 0;
+  }
+
+}; // end HashTable.h
+#endif
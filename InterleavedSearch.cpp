@@ -0,0 +1,107 @@
+/*
+ * InterleavedSearch.cpp
+ *
+ * Class Description: Interleaves the searches of a List to overlap their cache misses, each search
+ *                    suspended at its next cache miss in a frame of a pool allocated once.
+ * Class Invariant: - A frame is free if and only if its result is nullptr.
+ *                  - inFlight is the number of frames that are not free.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include "InterleavedSearch.h"
+#include "PhoneKey.h"
+
+using namespace std;
+
+// Constructor
+InterleavedSearch::InterleavedSearch(const List &aList, unsigned int aWidth)
+    : list(aList), width(aWidth == 0 ? 1 : aWidth)
+{
+    frames = new Frame[width];
+}
+
+// Destructor
+InterleavedSearch::~InterleavedSearch()
+{
+    drain();
+    delete[] frames;
+}
+
+// Description: Starts a search of phone, whose result will be written to result.
+void InterleavedSearch::submit(const string &phone, Member *&result)
+{
+    while (true)
+    {
+        Frame &frame = frames[cursor];
+        cursor = (cursor + 1 == width) ? 0 : cursor + 1;
+        if (frame.result == nullptr || resume(frame))
+        {
+            // An invalid phone is searched as INVALID_PHONE_KEY, which is never stored.
+            normalizePhone(phone, frame.phoneKey);
+            frame.result = &result;
+            list.beginSearch(frame.phoneKey, frame.step);
+            inFlight++;
+            return;
+        }
+    }
+}
+
+// Description: Completes every search in flight.
+void InterleavedSearch::drain()
+{
+    while (inFlight > 0)
+    {
+        Frame &frame = frames[cursor];
+        cursor = (cursor + 1 == width) ? 0 : cursor + 1;
+        if (frame.result != nullptr)
+        {
+            resume(frame);
+        }
+    }
+}
+
+// Description: Searches phones[0 .. count - 1].
+void InterleavedSearch::searchAll(const string *phones, Member **results, unsigned int count)
+{
+    for (unsigned int i = 0; i < count; i++)
+    {
+        submit(phones[i], results[i]);
+    }
+    drain();
+}
+
+// Description: Returns the number of searches in flight.
+unsigned int InterleavedSearch::getInFlight() const
+{
+    return inFlight;
+}
+
+// Description: Returns the maximum number of searches in flight.
+unsigned int InterleavedSearch::getWidth() const
+{
+    return width;
+}
+
+// Description: Returns the number of times a search was resumed so far.
+unsigned long long InterleavedSearch::getStepCount() const
+{
+    return stepCount;
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Resumes the search of a frame; if it completes, writes its result and frees the frame.
+bool InterleavedSearch::resume(Frame &frame)
+{
+    stepCount++;
+    if (!list.resumeSearch(frame.phoneKey, frame.step))
+    {
+        return false;
+    }
+    *frame.result = frame.step.result;
+    frame.result = nullptr;
+    inFlight--;
+    return true;
+}
@@ -0,0 +1,92 @@
+/*
+ * InterleavedSearch.h
+ *
+ * Class Description: Interleaves the searches of a List to overlap their cache misses: searches are
+ *                    submitted one at a time (e.g. by request handlers) and kept in flight, up to
+ *                    getWidth( ) of them, each suspended at its next cache miss (List::beginSearch( ),
+ *                    List::resumeSearch( )): a step reads what the previous step prefetched, prefetches
+ *                    what it needs next and gives way to the next search of the ring, so that while
+ *                    one search waits for memory the others make progress.
+ *                    The state of a suspended search is a frame of a pool allocated once, with the
+ *                    scheduler: submitting a search allocates nothing (the phone is kept packed).
+ *                    The result of a search is written to the location given to submit( ) when it
+ *                    completes, at the latest by drain( ). Not thread-safe: one scheduler per thread.
+ * Class Invariant: - A frame is free if and only if its result is nullptr.
+ *                  - inFlight is the number of frames that are not free.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef INTERLEAVED_SEARCH_H
+#define INTERLEAVED_SEARCH_H
+
+#include <string>
+#include "List.h"
+#include "Member.h"
+
+using std::string;
+
+class InterleavedSearch
+{
+
+public:
+  const static unsigned int DEFAULT_WIDTH = 16; // Searches in flight (enough to cover a DRAM miss).
+
+private:
+  // A suspended search.
+  struct Frame
+  {
+    unsigned long long phoneKey = 0; // Phone searched, packed.
+    Member **result = nullptr;       // Where to write the element found; nullptr: the frame is free.
+    List::SearchStep step;
+  };
+
+  const List &list;
+  Frame *frames;     // Pool of width frames, used as a ring.
+  unsigned int width;
+  unsigned int cursor = 0; // Next frame of the ring to resume.
+  unsigned int inFlight = 0;
+  unsigned long long stepCount = 0;
+
+  // Description: Resumes the search of a frame (not free); if it completes, writes its result and frees the frame.
+  //              Returns true if the frame is free now.
+  bool resume(Frame &frame);
+
+public:
+  // Constructor
+  // Description: Creates a scheduler of searches of aList, keeping up to aWidth (at least 1) of them in flight.
+  InterleavedSearch(const List &aList, unsigned int aWidth = DEFAULT_WIDTH);
+
+  // Destructor
+  // Description: Completes the searches still in flight.
+  ~InterleavedSearch();
+
+  InterleavedSearch(const InterleavedSearch &) = delete;
+  InterleavedSearch &operator=(const InterleavedSearch &) = delete;
+
+  // Description: Starts a search of phone, whose result (the element whose phone is phone, nullptr if
+  //              there is none) will be written to result. If getWidth( ) searches are in flight, the
+  //              others are resumed in turn until one completes and frees its frame.
+  // Postcondition: result is written by this or a later submit( ), or by drain( ). The List must not be
+  //                modified until then.
+  void submit(const string &phone, Member *&result);
+
+  // Description: Completes every search in flight.
+  void drain();
+
+  // Description: Searches phones[0 .. count - 1]: results[i] is the element whose phone is phones[i],
+  //              or nullptr (as List::searchMany( )).
+  void searchAll(const string *phones, Member **results, unsigned int count);
+
+  // Description: Returns the number of searches in flight.
+  unsigned int getInFlight() const;
+
+  // Description: Returns the maximum number of searches in flight.
+  unsigned int getWidth() const;
+
+  // Description: Returns the number of times a search was resumed so far.
+  unsigned long long getStepCount() const;
+};
+
+#endif
@@ -0,0 +1,95 @@
+/*
+ * LatencyHistogram.cpp
+ *
+ * Class Description: Histogram of operation latencies in nanoseconds, in the style of HDR histograms:
+ *                    values below 64 ns have a bucket each, then every power of 2 is split into
+ *                    32 buckets, so a recorded value is known within about 3%.
+ * Class Invariant: - count is the sum of the bucket counters.
+ *                  - maximum is the largest value recorded.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <algorithm>
+
+#include "LatencyHistogram.h"
+
+using namespace std;
+
+// Constructor
+LatencyHistogram::LatencyHistogram() : count(0), maximum(0)
+{
+    for (unsigned int b = 0; b < BUCKET_COUNT; b++)
+    {
+        buckets[b].store(0, memory_order_relaxed);
+    }
+}
+
+// Description: Returns the smallest value of a bucket (inverse of bucketOf( )).
+unsigned long long LatencyHistogram::lowestValueOf(unsigned int bucket)
+{
+    if (bucket < 2 * SUB_BUCKETS)
+    {
+        return bucket;
+    }
+    unsigned int shift = bucket / SUB_BUCKETS - 1;
+    unsigned long long top = bucket % SUB_BUCKETS + SUB_BUCKETS;
+    return top << shift;
+}
+
+// Description: Adds the counts of other to this histogram.
+void LatencyHistogram::add(const LatencyHistogram &other)
+{
+    for (unsigned int b = 0; b < BUCKET_COUNT; b++)
+    {
+        buckets[b].fetch_add(other.buckets[b].load(memory_order_relaxed), memory_order_relaxed);
+    }
+    count.fetch_add(other.count.load(memory_order_relaxed), memory_order_relaxed);
+    unsigned long long otherMaximum = other.maximum.load(memory_order_relaxed);
+    if (otherMaximum > maximum.load(memory_order_relaxed))
+    {
+        maximum.store(otherMaximum, memory_order_relaxed);
+    }
+}
+
+// Description: Returns the number of values recorded.
+unsigned long long LatencyHistogram::getCount() const
+{
+    return count.load(memory_order_relaxed);
+}
+
+// Description: Returns the largest value recorded (0 if none).
+unsigned long long LatencyHistogram::getMaximum() const
+{
+    return maximum.load(memory_order_relaxed);
+}
+
+// Description: Returns the value below which a fraction "quantile" of the recorded values fall,
+//              as the middle of its bucket (0 if no value was recorded).
+unsigned long long LatencyHistogram::valueAtQuantile(double quantile) const
+{
+    unsigned long long total = getCount();
+    if (total == 0)
+    {
+        return 0;
+    }
+    unsigned long long rank = (unsigned long long)(quantile * total);
+    if (rank >= total)
+    {
+        rank = total - 1;
+    }
+
+    unsigned long long seen = 0;
+    for (unsigned int b = 0; b < BUCKET_COUNT; b++)
+    {
+        seen += buckets[b].load(memory_order_relaxed);
+        if (seen > rank)
+        {
+            unsigned long long low = lowestValueOf(b);
+            unsigned long long high = (b + 1 < BUCKET_COUNT) ? lowestValueOf(b + 1) : low;
+            return min(low + (high - low) / 2, getMaximum());
+        }
+    }
+    return getMaximum();
+}
@@ -0,0 +1,86 @@
+/*
+ * LatencyHistogram.h
+ *
+ * Class Description: Histogram of operation latencies in nanoseconds, in the style of HDR histograms:
+ *                    values below 64 ns have a bucket each, then every power of 2 is split into
+ *                    32 buckets, so a recorded value is known within about 3% over the whole
+ *                    64-bit range, in a fixed array of BUCKET_COUNT counters.
+ *                    Recording is lock-free (relaxed atomic increments); a histogram is meant
+ *                    to be written by one thread and read by any (see LatencyTracker).
+ * Class Invariant: - count is the sum of the bucket counters.
+ *                  - maximum is the largest value recorded.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef LATENCY_HISTOGRAM_H
+#define LATENCY_HISTOGRAM_H
+
+#include <atomic>
+
+using std::atomic;
+
+class LatencyHistogram
+{
+
+public:
+  const static unsigned int SUB_BUCKET_BITS = 5;                   // 32 buckets per power of 2.
+  const static unsigned int SUB_BUCKETS = 1u << SUB_BUCKET_BITS;
+  const static unsigned int BUCKET_COUNT = (64 - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+private:
+  atomic<unsigned long long> buckets[BUCKET_COUNT];
+  atomic<unsigned long long> count;
+  atomic<unsigned long long> maximum;
+
+public:
+  // Constructor
+  LatencyHistogram();
+
+  LatencyHistogram(const LatencyHistogram &) = delete;
+  LatencyHistogram &operator=(const LatencyHistogram &) = delete;
+
+  // Description: Returns the bucket of a value.
+  // Time Efficiency: O(1)
+  static unsigned int bucketOf(unsigned long long nanoseconds)
+  {
+    if (nanoseconds < 2 * SUB_BUCKETS)
+    {
+      return (unsigned int)nanoseconds;
+    }
+    unsigned int shift = 63 - __builtin_clzll(nanoseconds) - SUB_BUCKET_BITS;
+    return SUB_BUCKETS + shift * SUB_BUCKETS + (unsigned int)(nanoseconds >> shift) - SUB_BUCKETS;
+  }
+
+  // Description: Returns the smallest value of a bucket.
+  static unsigned long long lowestValueOf(unsigned int bucket);
+
+  // Description: Records one value.
+  // Time Efficiency: O(1), two relaxed atomic increments and a relaxed load of the maximum
+  //                  (plus a compare-and-swap loop when nanoseconds is a new maximum, which is rare)
+  void record(unsigned long long nanoseconds)
+  {
+    buckets[bucketOf(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    unsigned long long largest = maximum.load(std::memory_order_relaxed);
+    while (nanoseconds > largest && !maximum.compare_exchange_weak(largest, nanoseconds, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  // Description: Adds the counts of other to this histogram.
+  void add(const LatencyHistogram &other);
+
+  // Description: Returns the number of values recorded.
+  unsigned long long getCount() const;
+
+  // Description: Returns the largest value recorded (0 if none).
+  unsigned long long getMaximum() const;
+
+  // Description: Returns the value below which a fraction "quantile" (e.g. 0.99) of the recorded
+  //              values fall, as the middle of its bucket (0 if no value was recorded).
+  unsigned long long valueAtQuantile(double quantile) const;
+};
+
+#endif
@@ -0,0 +1,155 @@
+/*
+ * LatencyTracker.cpp
+ *
+ * Class Description: Per-operation latency recording for a data collection.
+ *                    Each thread records into its own set of LatencyHistograms (one per operation),
+ *                    created on its first record. Time is read with rdtsc on x86, steady_clock elsewhere.
+ * Class Invariant: - Thread slot t holds the histograms of the threads whose index is t modulo MAX_THREADS.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <iostream>
+
+#include "LatencyTracker.h"
+
+using namespace std;
+
+// Process-wide thread numbering: a thread keeps its index for every tracker.
+static atomic<unsigned int> nextThreadIndex(0);
+static thread_local unsigned int threadIndex = nextThreadIndex++;
+
+// Constructor
+LatencyTracker::LatencyTracker()
+{
+    for (unsigned int t = 0; t < MAX_THREADS; t++)
+    {
+        threads[t].store(nullptr, memory_order_relaxed);
+    }
+    nanosecondsPerTick(); // calibrate now rather than during the first operation
+}
+
+// Destructor
+LatencyTracker::~LatencyTracker()
+{
+    for (unsigned int t = 0; t < MAX_THREADS; t++)
+    {
+        delete threads[t].load(memory_order_relaxed);
+    }
+}
+
+// Description: Records an operation started at "start" and returns its duration in nanoseconds.
+unsigned long long LatencyTracker::record(Operation operation, unsigned long long start)
+{
+    unsigned long long nanoseconds = (unsigned long long)((now() - start) * nanosecondsPerTick());
+    histogramsOfThisThread().histograms[operation].record(nanoseconds);
+    return nanoseconds;
+}
+
+// Description: Calls the slow operation hook, if any.
+void LatencyTracker::reportSlow(const SlowOperation &slow) const
+{
+    if (slowHook != nullptr)
+    {
+        slowHook(slow);
+    }
+}
+
+// Description: Operations taking thresholdNanoseconds or more are passed to hook from now on.
+void LatencyTracker::setSlowOperationHook(unsigned long long thresholdNanoseconds, SlowOperationHook hook)
+{
+    slowHook = hook;
+    slowThreshold = (hook == nullptr) ? ~0ULL : thresholdNanoseconds;
+}
+
+// Description: Adds the histograms of every thread for one operation into result.
+void LatencyTracker::collect(Operation operation, LatencyHistogram &result) const
+{
+    for (unsigned int t = 0; t < MAX_THREADS; t++)
+    {
+        ThreadHistograms *histograms = threads[t].load(memory_order_acquire);
+        if (histograms != nullptr)
+        {
+            result.add(histograms->histograms[operation]);
+        }
+    }
+}
+
+// Description: Prints count, p50, p99, p99.9 and max of each operation that was recorded.
+void LatencyTracker::print(ostream &os) const
+{
+    for (unsigned int op = 0; op < OPERATION_COUNT; op++)
+    {
+        LatencyHistogram *merged = new LatencyHistogram(); // about 15 KB: kept off the stack
+        collect((Operation)op, *merged);
+        if (merged->getCount() > 0)
+        {
+            os << nameOf((Operation)op) << ": " << merged->getCount() << " operations, p50 "
+               << merged->valueAtQuantile(0.5) << " ns, p99 " << merged->valueAtQuantile(0.99) << " ns, p99.9 "
+               << merged->valueAtQuantile(0.999) << " ns, max " << merged->getMaximum() << " ns" << endl;
+        }
+        delete merged;
+    }
+}
+
+// Description: Returns the name of an operation.
+const char *LatencyTracker::nameOf(Operation operation)
+{
+    switch (operation)
+    {
+    case INSERT:
+        return "insert";
+    case SEARCH:
+        return "search";
+    case REMOVE:
+        return "remove";
+    default:
+        return "unknown";
+    }
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Returns the histograms of the calling thread, creating them on its first call.
+//              Threads beyond MAX_THREADS share slots; the histograms stay correct since their
+//              counters are atomic, only their cache lines are shared.
+LatencyTracker::ThreadHistograms &LatencyTracker::histogramsOfThisThread()
+{
+    atomic<ThreadHistograms *> &slot = threads[threadIndex % MAX_THREADS];
+    ThreadHistograms *histograms = slot.load(memory_order_acquire);
+    if (histograms == nullptr)
+    {
+        ThreadHistograms *created = new ThreadHistograms();
+        if (slot.compare_exchange_strong(histograms, created, memory_order_acq_rel))
+        {
+            histograms = created;
+        }
+        else
+        {
+            delete created; // another thread of the same slot won
+        }
+    }
+    return *histograms;
+}
+
+// Description: Returns the number of nanoseconds per tick of now( ), calibrated once per process
+//              by timing a 10 ms interval with both clocks.
+double LatencyTracker::nanosecondsPerTick()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    static const double ratio = []()
+    {
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        unsigned long long startTicks = now();
+        while (chrono::steady_clock::now() - start < chrono::milliseconds(10))
+        {
+        }
+        double nanoseconds = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+        return nanoseconds / (double)(now() - startTicks);
+    }();
+    return ratio;
+#else
+    return 1.0;
+#endif
+}
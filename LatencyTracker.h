@@ -0,0 +1,121 @@
+/*
+ * LatencyTracker.h
+ *
+ * Class Description: Per-operation latency recording for a data collection (see List::enableLatencyTracking( )).
+ *                    Each thread records into its own set of LatencyHistograms (one per operation),
+ *                    created on its first record, so that recording threads never share a cache line.
+ *                    Time is read with rdtsc on x86 (converted to nanoseconds with a ratio calibrated
+ *                    once against steady_clock), steady_clock elsewhere.
+ *                    Operations slower than a threshold can be passed to a hook, with the number
+ *                    of cells their key's probe sequence visits.
+ * Class Invariant: - Thread slot t holds the histograms of the threads whose index is t modulo MAX_THREADS.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef LATENCY_TRACKER_H
+#define LATENCY_TRACKER_H
+
+#include <atomic>
+#include <chrono>
+#include <ostream>
+#include <string>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "LatencyHistogram.h"
+
+using std::atomic;
+using std::ostream;
+using std::string;
+
+class LatencyTracker
+{
+
+public:
+  enum Operation
+  {
+    INSERT,
+    SEARCH,
+    REMOVE,
+    OPERATION_COUNT
+  };
+
+  // An operation slower than the threshold, as given to the slow operation hook.
+  struct SlowOperation
+  {
+    Operation operation;
+    string phone;             // Indexing key of the operation.
+    unsigned long long nanoseconds;
+    unsigned int probeLength; // Cells visited by a search of phone, measured after the operation.
+  };
+
+  typedef void (*SlowOperationHook)(const SlowOperation &slow);
+
+private:
+  const static unsigned int MAX_THREADS = 64;
+
+  struct ThreadHistograms
+  {
+    LatencyHistogram histograms[OPERATION_COUNT];
+  };
+
+  atomic<ThreadHistograms *> threads[MAX_THREADS];
+  unsigned long long slowThreshold = ~0ULL; // In nanoseconds; no hook call by default.
+  SlowOperationHook slowHook = nullptr;
+
+  // Description: Returns the histograms of the calling thread, creating them on its first call.
+  ThreadHistograms &histogramsOfThisThread();
+
+  // Description: Returns the number of nanoseconds per tick of now( ) (calibrated once).
+  static double nanosecondsPerTick();
+
+public:
+  // Constructor
+  LatencyTracker();
+
+  // Destructor
+  ~LatencyTracker();
+
+  LatencyTracker(const LatencyTracker &) = delete;
+  LatencyTracker &operator=(const LatencyTracker &) = delete;
+
+  // Description: Returns the current time in ticks (rdtsc cycles on x86, steady_clock nanoseconds elsewhere).
+  static unsigned long long now()
+  {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+  }
+
+  // Description: Records an operation started at "start" (from now( )) and returns its duration in nanoseconds.
+  // Time Efficiency: O(1)
+  unsigned long long record(Operation operation, unsigned long long start);
+
+  // Description: Returns true if an operation of this duration must be passed to the slow operation hook.
+  bool isSlow(unsigned long long nanoseconds) const
+  {
+    return nanoseconds >= slowThreshold;
+  }
+
+  // Description: Calls the slow operation hook, if any.
+  void reportSlow(const SlowOperation &slow) const;
+
+  // Description: From now on, operations taking thresholdNanoseconds or more are passed to hook
+  //              (nullptr: none), on the thread that ran them.
+  void setSlowOperationHook(unsigned long long thresholdNanoseconds, SlowOperationHook hook);
+
+  // Description: Adds the histograms of every thread for one operation into result.
+  void collect(Operation operation, LatencyHistogram &result) const;
+
+  // Description: Prints count, p50, p99, p99.9 and max of each operation (only operations that were recorded).
+  void print(ostream &os) const;
+
+  // Description: Returns the name of an operation.
+  static const char *nameOf(Operation operation);
+};
+
+#endif
@@ -4,6 +4,9 @@
  * Class Description: List data collection ADT.
  *                    Based on the Hashing strategy and the open addressing
  *                    collision resolution strategy called linear probing hashing.
+ *                    The hash table itself is HashTable (HashTable.h) instantiated for
+ *                    Member elements keyed by phone; List adds the Member specific parts
+ *                    (ownership of the elements, secondary indexes, printing).
  * Class Invariant: Data collection with the following characteristics:
  *                  - Each element is unique (no duplicates).
  *
@@ -13,8 +16,11 @@
 
 #include <iostream>
 #include <string>
+#include <algorithm>
 
 #include "List.h"
+#include "FrozenList.h"
+#include "PhoneKey.h"
 #include "ElementAlreadyExistsException.h"
 #include "ElementDoesNotExistException.h"
 #include "EmptyDataCollectionException.h"
@@ -23,148 +29,747 @@
 using namespace std;
 unsigned int insertCount = 0;
 
+// Progress of adaptive hashing.
+struct List::AdaptiveHashing
+{
+    HashFamily family;
+    double threshold;
+    unsigned int nextFunction = 0;      // Family position of the next function to switch to.
+    unsigned int reseeds = 0;           // Reseeds of the last function so far.
+    unsigned int insertsSinceCheck = 0;
+    unsigned long long insertProbesAtCheck = 0; // MemberTable::insertProbes( ) at the last check.
+    string currentName = "initial";
+    vector<HashSwitch> switches;
+};
+
 // Constructor
-List::List(unsigned int (*hFcn)(string))
+List::List(unsigned int (*hFcn)(string), unsigned int aCapacity, TableAllocation allocation)
+    : hashTable(aCapacity, HashFunction(hFcn), MemberPhone(), allocation)
 {
-    hashFcn = hFcn;
-    hashTable = new Member *[CAPACITY];
-    collisions = new unsigned int[CAPACITY];
-    for (int i = 0; i < CAPACITY; i++)
-    {
-        hashTable[i] = nullptr;
-        collisions[i] = 0;
-    }
 }
 
 // Destructor
 // Description: Destruct a List object, releasing heap-allocated memory.
 List::~List()
 {
-    for (int i = 0; i < CAPACITY; i++)
-    {
-        if (hashTable[i] != nullptr)
-        {
-            delete hashTable[i];
-            hashTable[i] = nullptr;
-        }
-    }
-
-    // Release all heap memory
-    if (hashTable != nullptr)
+    // The List owns its elements; the hashTable releases its own arrays.
+    for (const_iterator it = begin(); it != end(); ++it)
     {
-        delete[] hashTable;
-        hashTable = nullptr;
+        delete hashTable.at(it.index());
     }
 
-    if (collisions != nullptr)
-    {
-        delete[] collisions;
-        collisions = nullptr;
-    }
+    delete emailIndex;
+    emailIndex = nullptr;
+    delete nameIndex;
+    nameIndex = nullptr;
+    delete phoneIndex;
+    phoneIndex = nullptr;
+    delete filter;
+    filter = nullptr;
+    delete latency;
+    latency = nullptr;
+    delete adaptive;
+    adaptive = nullptr;
 }
 
 // Description: Returns the total element count currently stored in List.
 // Postcondition: List remains unchanged.
 unsigned int List::getElementCount() const
 {
-    return elementCount;
+    return hashTable.size();
+}
+
+// Description: Returns the size of the hashTable.
+// Postcondition: List remains unchanged.
+unsigned int List::getCapacity() const
+{
+    return hashTable.capacity();
+}
+
+// Description: Returns true if the hashTable is backed by huge pages.
+// Postcondition: List remains unchanged.
+bool List::usesHugePages() const
+{
+    return hashTable.usesHugePages();
 }
 
 // Description: Insert an element.
 // NOTE: You do not have to expand the hashTable when it is full.
 // Precondition: newElement must not already be in in the List.
-// Postcondition: newElement inserted and elementCount has been incremented.
+// Postcondition: newElement inserted and the element count has been incremented.
 // Exception: Throws UnableToInsertException if we cannot insert newElement in the List.
 //            For example, if the operator "new" fails, or hashTable is full (temporary solution).
 // Exception: Throws ElementAlreadyExistsException if newElement is already in the List.
 void List::insert(Member &newElement)
 {
-    if (elementCount == CAPACITY)
+    ErrorCode code = tryInsert(newElement);
+    if (code != ErrorCode::OK)
     {
-        throw UnableToInsertException("Unable to insert element. List is full.");
+        throwException(code);
     }
-    else
+}
+
+// Description: Returns a pointer to the target element if found.
+// Postcondition: List remains unchanged.
+// Exception: Throws EmptyDataCollectionException if the List is empty.
+// Exception: Throws ElementDoesNotExistException if newElement is not found in the List.
+Member *List::search(Member &target) const
+{
+    Member *found = nullptr;
+    ErrorCode code = trySearch(target, found);
+    if (code != ErrorCode::OK)
+    {
+        throwException(code);
+    }
+    return found;
+}
+
+// Description: Removes the element with the same indexing key (phone) as target.
+//              Its cell becomes a tombstone so that the probe sequences going through it stay valid.
+//              When tombstones take up more than 1/TOMBSTONE_RATIO of the cells, the table is compacted.
+// Postcondition: The stored element is deleted (the List owns its elements) and the element count
+//                has been decremented.
+// Exception: Throws EmptyDataCollectionException if the List is empty.
+// Exception: Throws ElementDoesNotExistException if target is not found in the List.
+void List::remove(Member &target)
+{
+    ErrorCode code = tryRemove(target);
+    if (code != ErrorCode::OK)
+    {
+        throwException(code);
+    }
+}
+
+// Description: Insert an element, returning the outcome as an ErrorCode.
+//              Timed when latency tracking is enabled.
+ErrorCode List::tryInsert(Member &newElement)
+{
+    if (latency == nullptr)
+    {
+        return insertElement(newElement);
+    }
+    unsigned long long start = LatencyTracker::now();
+    ErrorCode code = insertElement(newElement);
+    recordLatency(LatencyTracker::INSERT, start, newElement.getPhoneKey());
+    return code;
+}
+
+// Description: Looks up the element with the same indexing key (phone) as target,
+//              returning the outcome as an ErrorCode. Timed when latency tracking is enabled.
+ErrorCode List::trySearch(const Member &target, Member *&found) const
+{
+    if (latency == nullptr)
+    {
+        return searchElement(target, found);
+    }
+    unsigned long long start = LatencyTracker::now();
+    ErrorCode code = searchElement(target, found);
+    recordLatency(LatencyTracker::SEARCH, start, target.getPhoneKey());
+    return code;
+}
+
+// Description: Removes (and deletes) the element with the same indexing key (phone) as target,
+//              returning the outcome as an ErrorCode. Timed when latency tracking is enabled.
+ErrorCode List::tryRemove(const Member &target)
+{
+    if (latency == nullptr)
+    {
+        return removeElement(target);
+    }
+    unsigned long long phoneKey = target.getPhoneKey(); // target may be the stored element, deleted by removeElement( )
+    unsigned long long start = LatencyTracker::now();
+    ErrorCode code = removeElement(target);
+    recordLatency(LatencyTracker::REMOVE, start, phoneKey);
+    return code;
+}
+
+// Description: Insert an element, returning the outcome as an ErrorCode.
+ErrorCode List::insertElement(Member &newElement)
+{
+    // Member gives every invalid phone number the same "000-000-0000": rejected rather than all
+    // piled up on the home cell of that one key.
+    if (newElement.getPhoneKey() == INVALID_PHONE_KEY)
+    {
+        return ErrorCode::INVALID_KEY;
+    }
+
+    // A duplicate email is rejected before the element is placed, so that the
+    // hashTable and the indexes never disagree.
+    if (emailIndex != nullptr && emailIndex->find(newElement.getEmail()) != nullptr)
+    {
+        return ErrorCode::ELEMENT_ALREADY_EXISTS;
+    }
+
+    // Linear probing, duplicate (phone) detection and tombstone reuse are done by the hashTable.
+    unsigned int cell = 0;
+    ErrorCode code = hashTable.tryInsert(newElement, cell);
+    if (code != ErrorCode::OK)
+    {
+        return code;
+    }
+
+    if (emailIndex != nullptr)
+    {
+        emailIndex->insert(newElement);
+    }
+    if (nameIndex != nullptr)
+    {
+        nameIndex->insert(newElement);
+    }
+    if (phoneIndex != nullptr)
+    {
+        phoneIndex->insert(newElement.getPhoneKey(), &newElement);
+    }
+    if (filter != nullptr)
+    {
+        filter->insert(newElement.getPhoneKey());
+    }
+    if (adaptive != nullptr && ++adaptive->insertsSinceCheck >= CLUSTERING_CHECK_INTERVAL)
+    {
+        checkClustering();
+    }
+    return ErrorCode::OK;
+}
+
+// Description: Looks up the element with the same indexing key (phone) as target,
+//              returning the outcome as an ErrorCode.
+ErrorCode List::searchElement(const Member &target, Member *&found) const
+{
+    found = nullptr;
+    if (isEmpty()) // list is empty
     {
-        int index = hashFcn(newElement.getPhone());
+        return ErrorCode::EMPTY_DATA_COLLECTION;
+    }
+
+    found = find(target);
+    if (found == nullptr) // target key not found
+    {
+        return ErrorCode::ELEMENT_DOES_NOT_EXIST;
+    }
+    return ErrorCode::OK;
+}
+
+// Description: Removes (and deletes) the element with the same indexing key (phone) as target,
+//              returning the outcome as an ErrorCode.
+ErrorCode List::removeElement(const Member &target)
+{
+    if (isEmpty())
+    {
+        return ErrorCode::EMPTY_DATA_COLLECTION;
+    }
+
+    Member *stored = find(target);
+    if (stored == nullptr)
+    {
+        return ErrorCode::ELEMENT_DOES_NOT_EXIST;
+    }
+
+    if (emailIndex != nullptr)
+    {
+        emailIndex->remove(*stored);
+    }
+    if (nameIndex != nullptr)
+    {
+        nameIndex->remove(*stored);
+    }
+    if (phoneIndex != nullptr)
+    {
+        phoneIndex->remove(stored->getPhoneKey());
+    }
+
+    hashTable.remove(stored->getPhoneKey());
+    delete stored;
 
-        if (hashTable[index] == &newElement)
+    if (filter != nullptr)
+    {
+        filterStaleKeys++;
+        if (filterStaleKeys * MemberTable::TOMBSTONE_RATIO >= hashTable.capacity())
         {
-            throw ElementAlreadyExistsException("Unable to insert element. Element already exists.");
+            rebuildFilter();
         }
+    }
+    return ErrorCode::OK;
+}
 
-        while (hashTable[index] != nullptr)
+// Description: Inserts elements[0 .. count - 1] in order; codes[i] is the outcome of tryInsert( ) for elements[i].
+//              The home cells of each group of PREFETCH_GROUP elements are prefetched first.
+void List::insertMany(Member *const *elements, ErrorCode *codes, unsigned int count)
+{
+    const unsigned int PREFETCH_GROUP = 16;
+    for (unsigned int start = 0; start < count; start += PREFETCH_GROUP)
+    {
+        unsigned int end = min(count, start + PREFETCH_GROUP);
+        for (unsigned int i = start; i < end; i++)
         {
-            index = (index + 1) % CAPACITY;
-            collisions[index]++;
+            hashTable.prefetch(elements[i]->getPhoneKey());
         }
+        for (unsigned int i = start; i < end; i++)
+        {
+            codes[i] = tryInsert(*elements[i]);
+        }
+    }
+}
 
-        // if (hashTable[index] == nullptr)
-        // {
-        //     insertCount++;
-        // }
+// Description: Looks up a batch of phone numbers: results[i] is set to the element whose
+//              phone is phones[i], or nullptr if there is none (no exception is thrown).
+//              The hashTable hashes a group of keys, prefetches their home cells and the
+//              elements they point to, then resolves the probes (group prefetching).
+// Postcondition: List remains unchanged.
+void List::searchMany(const string *phones, Member **results, unsigned int count) const
+{
+    // Phones are packed a block at a time (an invalid one into INVALID_PHONE_KEY, never stored).
+    const unsigned int BLOCK = 256;
+    unsigned long long keys[BLOCK];
+    for (unsigned int start = 0; start < count; start += BLOCK)
+    {
+        unsigned int blockSize = min(count - start, BLOCK);
+        normalizePhones(phones + start, keys, blockSize);
+        hashTable.findMany(keys, results + start, blockSize);
+    }
+}
 
-        hashTable[index] = &newElement;
-        // collisions[index]++;
+// Description: Starts a resumable search of the phone packed into phoneKey.
+void List::beginSearch(unsigned long long phoneKey, SearchStep &step) const
+{
+    hashTable.beginFind(phoneKey, step);
+}
+
+// Description: Carries on a resumable search up to its next cache miss.
+bool List::resumeSearch(unsigned long long phoneKey, SearchStep &step) const
+{
+    return hashTable.resumeFind(phoneKey, step);
+}
 
-        elementCount++;
+// Description: Builds a filter over the phones of the List, sized for its capacity,
+//              and keeps it up to date from now on.
+void List::enableFilter(unsigned int bitsPerKey)
+{
+    if (filter != nullptr)
+    {
+        return;
     }
+
+    filter = new PhoneFilter(hashTable.capacity(), bitsPerKey);
+    rebuildFilter();
 }
 
-// Description: Returns a pointer to the target element if found.
-// Postcondition: List remains unchanged.
-// Exception: Throws EmptyDataCollectionException if the List is empty.
-// Exception: Throws ElementDoesNotExistException if newElement is not found in the List.
-Member *List::search(Member &target) const
+// Description: Returns the memory used by the filter in bytes, 0 if it is disabled.
+unsigned long long List::getFilterMemoryUsage() const
 {
-    int index = hashFcn(target.getPhone()); // compute hash index
+    return (filter == nullptr) ? 0 : filter->getMemoryUsage();
+}
 
-    if (isEmpty()) // list is empty
+// Description: Times insert( ), search( ) and remove( ) (and their non-throwing versions) from now on.
+void List::enableLatencyTracking()
+{
+    if (latency == nullptr)
+    {
+        latency = new LatencyTracker();
+    }
+}
+
+// Description: Returns the latency tracker, nullptr if latency tracking is disabled.
+const LatencyTracker *List::getLatencyTracker() const
+{
+    return latency;
+}
+
+// Description: Enables latency tracking and passes the operations taking thresholdNanoseconds or more to hook.
+void List::setSlowOperationHook(unsigned long long thresholdNanoseconds, LatencyTracker::SlowOperationHook hook)
+{
+    enableLatencyTracking();
+    latency->setSlowOperationHook(thresholdNanoseconds, hook);
+}
+
+// Description: Prints the latency percentiles of each operation, if latency tracking is enabled.
+void List::printLatency(ostream &os) const
+{
+    if (latency != nullptr)
+    {
+        latency->print(os);
+    }
+}
+
+// Description: Adaptive hashing: from now on, samples the probe lengths every CLUSTERING_CHECK_INTERVAL
+//              insertions and rehashes with the next function of family when they are too long.
+void List::enableAdaptiveHashing(const HashFamily &family, double clusteringThreshold)
+{
+    if (adaptive == nullptr)
+    {
+        adaptive = new AdaptiveHashing();
+    }
+    adaptive->family = family;
+    adaptive->threshold = clusteringThreshold;
+    adaptive->nextFunction = 0;
+    adaptive->reseeds = 0;
+    adaptive->insertsSinceCheck = 0;
+    adaptive->insertProbesAtCheck = hashTable.insertProbes();
+}
+
+// Description: Returns the hash function switches made by adaptive hashing, in order.
+const vector<List::HashSwitch> &List::getHashSwitches() const
+{
+    static const vector<HashSwitch> none;
+    return (adaptive == nullptr) ? none : adaptive->switches;
+}
+
+// Description: Returns the name of the hash function in use.
+string List::getHashFunctionName() const
+{
+    return (adaptive == nullptr) ? "initial" : adaptive->currentName;
+}
+
+// Description: Builds a secondary index on email and keeps it up to date from now on.
+// Exception: Throws ElementAlreadyExistsException if two stored members already share an email.
+void List::enableEmailIndex()
+{
+    if (emailIndex != nullptr)
+    {
+        return;
+    }
+
+    MemberIndex *index = new MemberIndex(emailKey, true);
+    try
+    {
+        for (const_iterator it = begin(); it != end(); ++it)
+        {
+            index->insert(*hashTable.at(it.index()));
+        }
+    }
+    catch (ElementAlreadyExistsException &)
+    {
+        delete index;
+        throw;
+    }
+    emailIndex = index;
+}
+
+// Description: Builds a secondary index on the case-folded name and keeps it up to date from now on.
+void List::enableNameIndex()
+{
+    if (nameIndex != nullptr)
+    {
+        return;
+    }
+
+    nameIndex = new MemberIndex(foldedNameKey, false);
+    for (const_iterator it = begin(); it != end(); ++it)
+    {
+        nameIndex->insert(*hashTable.at(it.index()));
+    }
+}
+
+// Description: Returns a pointer to the element whose email is email.
+// Exception: Throws EmptyDataCollectionException if the List is empty.
+// Exception: Throws ElementDoesNotExistException if no element has this email.
+Member *List::searchByEmail(const string &email) const
+{
+    if (isEmpty())
     {
         throw EmptyDataCollectionException("Data collection is empty.");
     }
-    else if (hashTable[index] == &target) // index is the target key
+
+    // No email is not a key: members without one are not found by email (the index skips them).
+    if (email.empty())
+    {
+        throw ElementDoesNotExistException("Element does not exist in hash table.");
+    }
+
+    Member *found = nullptr;
+    if (emailIndex != nullptr)
     {
-        return (hashTable[index]);
+        found = emailIndex->find(email);
     }
-    else // target key not found
+    else
     {
-        if (hashTable[index] == nullptr) // throw exception if cell is empty
+        for (const_iterator it = begin(); it != end() && found == nullptr; ++it)
         {
-            throw ElementDoesNotExistException("Element does not exist in hash table.");
+            if (it->getEmail() == email)
+            {
+                found = hashTable.at(it.index());
+            }
         }
-        else // cell is not empty -> collision
+    }
+
+    if (found == nullptr)
+    {
+        throw ElementDoesNotExistException("Element does not exist in hash table.");
+    }
+    return found;
+}
+
+// Description: Returns pointers to all elements whose name matches name, ignoring case.
+vector<Member *> List::searchByName(const string &name) const
+{
+    vector<Member *> results;
+    string key = foldCase(name);
+    // No name is not a key: members without one are not found by name (the index skips them).
+    if (key.empty())
+    {
+        return results;
+    }
+
+    if (nameIndex != nullptr)
+    {
+        nameIndex->findAll(key, results);
+    }
+    else
+    {
+        for (const_iterator it = begin(); it != end(); ++it)
         {
-            int i = 0;
-            while (hashTable[index] != &target)
+            if (foldedNameKey(*it) == key)
             {
-                index = (index + i) % CAPACITY;
-                i++;
+                results.push_back(hashTable.at(it.index()));
             }
         }
     }
-    return (hashTable[index]);
+    return results;
 }
 
-// Description: Prints all elements stored in the List (unsorted).
-// Postcondition: List remains unchanged.
-void List::printList() const
+// Description: Builds an ordered index on phone and keeps it up to date from now on.
+void List::enableOrderedIndex()
+{
+    if (phoneIndex != nullptr)
+    {
+        return;
+    }
+
+    phoneIndex = new PhoneIndex();
+    for (const_iterator it = begin(); it != end(); ++it)
+    {
+        phoneIndex->insert(it->getPhoneKey(), hashTable.at(it.index()));
+    }
+}
+
+// Description: Returns the elements whose phone is between lowPhone and highPhone (inclusive),
+//              in increasing order of phone. Enables the ordered index if needed.
+PhoneIndex::Range List::searchByPhoneRange(const string &lowPhone, const string &highPhone)
+{
+    enableOrderedIndex();
+    return phoneIndex->range(packPhone(lowPhone), packPhone(highPhone));
+}
+
+// Description: Returns the elements whose phone starts with prefix (e.g. area code "604"),
+//              in increasing order of phone. Enables the ordered index if needed.
+PhoneIndex::Range List::searchByPhonePrefix(const string &prefix)
+{
+    enableOrderedIndex();
+    unsigned long long low = 1, high = 0; // empty range unless prefix is valid
+    phonePrefixRange(prefix, low, high);
+    return phoneIndex->range(low, high);
+}
+
+// Description: Changes the email of a stored element, keeping the email index consistent.
+// Exception: Throws ElementDoesNotExistException if target is not in the List.
+// Exception: Throws ElementAlreadyExistsException if the email index is enabled and
+//            another element already has newEmail.
+void List::setEmail(Member &target, const string &newEmail)
 {
-    for (int i = 0; i < CAPACITY; i++)
+    Member *stored = find(target);
+    if (stored == nullptr)
     {
-        if (hashTable[i] != nullptr)
+        throw ElementDoesNotExistException("Element does not exist in hash table.");
+    }
+
+    if (emailIndex != nullptr)
+    {
+        Member *owner = emailIndex->find(newEmail);
+        if (owner == stored)
+        {
+            return;
+        }
+        if (owner != nullptr)
         {
-            // cout << hashTable[i]->getName() << " " << hashTable[i]->getPhone() << endl;
-            cout << i << " " << *hashTable[i];
+            throw ElementAlreadyExistsException("Unable to update element. Email already exists.");
         }
+        emailIndex->remove(*stored);
+        stored->setEmail(newEmail);
+        emailIndex->insert(*stored);
+    }
+    else
+    {
+        stored->setEmail(newEmail);
+    }
+}
+
+// Description: Changes the name of a stored element, keeping the name index consistent.
+// Exception: Throws ElementDoesNotExistException if target is not in the List.
+void List::setName(Member &target, const string &newName)
+{
+    Member *stored = find(target);
+    if (stored == nullptr)
+    {
+        throw ElementDoesNotExistException("Element does not exist in hash table.");
+    }
+
+    if (nameIndex != nullptr)
+    {
+        nameIndex->remove(*stored);
+        stored->setName(newName);
+        nameIndex->insert(*stored);
+    }
+    else
+    {
+        stored->setName(newName);
     }
 }
 
+// Description: Returns an iterator to the first element (hashTable order).
+List::const_iterator List::begin() const
+{
+    return hashTable.begin();
+}
+
+// Description: Returns the past-the-end iterator.
+List::const_iterator List::end() const
+{
+    return hashTable.end();
+}
+
+// Description: Prints all elements stored in the List (unsorted), each preceded by its hashTable index,
+//              with the credit cards masked.
+// Postcondition: List remains unchanged.
+void List::printList() const
+{
+    writeElements(cout, true);
+}
+
+// Description: Writes all elements stored in the List (unsorted) to os, one per line, in the
+//              format of operator<<(ostream &, const Member &) but with the full credit card numbers
+//              (a roster file, readable by RosterMerge). The stream is not flushed per element.
+// Postcondition: List remains unchanged.
+void List::exportTo(ostream &os) const
+{
+    writeElements(os, false);
+}
+
 ////////////////////////////// Helper functions ///////////////////////////
 
+// Description: Returns the stored element with the same indexing key (phone) as target, nullptr if none.
+//              When the filter is enabled, it is checked first: most absent phones never reach the hashTable.
+Member *List::find(const Member &target) const
+{
+    unsigned long long phoneKey = target.getPhoneKey();
+    if (filter != nullptr && !filter->mayContain(phoneKey))
+    {
+        return nullptr;
+    }
+    return hashTable.find(phoneKey);
+}
+
+// Description: Records the duration of an operation on the phone packed into phoneKey started at start and,
+//              if it was slow, reports it with the phone and its probe length (both only for slow operations).
+void List::recordLatency(LatencyTracker::Operation operation, unsigned long long start, unsigned long long phoneKey) const
+{
+    unsigned long long nanoseconds = latency->record(operation, start);
+    if (latency->isSlow(nanoseconds))
+    {
+        char phone[12];
+        formatPhoneKey(phoneKey, phone);
+        LatencyTracker::SlowOperation slow = {operation, string(phone, 12), nanoseconds, hashTable.probeLength(phoneKey)};
+        latency->reportSlow(slow);
+    }
+}
+
+// Description: Clears the filter and adds the phone of every stored element.
+void List::rebuildFilter()
+{
+    filter->clear();
+    for (const_iterator it = begin(); it != end(); ++it)
+    {
+        filter->insert(it->getPhoneKey());
+    }
+    filterStaleKeys = 0;
+}
+
+// Description: If the insertions since the last check visited more cells than the threshold times what they
+//              would with a uniform hash function, rehashes with the next function of the family (or a new seed).
+void List::checkClustering()
+{
+    double insertProbeLength = (double)(hashTable.insertProbes() - adaptive->insertProbesAtCheck) / adaptive->insertsSinceCheck;
+    adaptive->insertsSinceCheck = 0;
+    adaptive->insertProbesAtCheck = hashTable.insertProbes();
+
+    double load = min((double)(hashTable.size() + hashTable.tombstones()) / hashTable.capacity(), 0.95);
+    double expected = 0.5 * (1 + 1 / ((1 - load) * (1 - load)));
+    if (insertProbeLength < MIN_CLUSTERED_PROBE_LENGTH || insertProbeLength <= adaptive->threshold * expected)
+    {
+        return;
+    }
+
+    const HashFamily &family = adaptive->family;
+    HashFunction next(hashPhone);
+    string name;
+    if (adaptive->nextFunction < family.size())
+    {
+        const HashFamily::Function &function = family.at(adaptive->nextFunction++);
+        next = (function.seeded != nullptr) ? HashFunction(function.seeded, 1) : HashFunction(function.plain);
+        name = function.name + ((function.seeded != nullptr) ? " (seed 1)" : "");
+    }
+    else if (family.size() > 0 && family.at(family.size() - 1).seeded != nullptr && adaptive->reseeds < MAX_RESEEDS)
+    {
+        // The last function is seeded: a new seed gives a new function of the family.
+        adaptive->reseeds++;
+        const HashFamily::Function &function = family.at(family.size() - 1);
+        next = HashFunction(function.seeded, adaptive->reseeds + 1);
+        name = function.name + " (seed " + to_string(adaptive->reseeds + 1) + ")";
+    }
+    else
+    {
+        return; // Family exhausted: keep the current function.
+    }
+
+    HashSwitch change;
+    change.from = adaptive->currentName;
+    change.to = name;
+    change.elementCount = hashTable.size();
+    change.insertProbeLength = insertProbeLength;
+    change.expectedInsertProbeLength = expected;
+    change.probeLengthBefore = getAverageProbeLength();
+    hashTable.rehash(next);
+    change.probeLengthAfter = getAverageProbeLength();
+    adaptive->currentName = name;
+    adaptive->switches.push_back(change);
+}
+
+// Description: Writes every element, one per line, through a local buffer so that
+//              the stream is written in large blocks instead of once (and flushed) per element.
+//              forDisplay: each element is preceded by its hashTable index and its card is masked.
+void List::writeElements(ostream &os, bool forDisplay) const
+{
+    const unsigned int BUFFER_SIZE = 1 << 16;
+    string buffer;
+    buffer.reserve(BUFFER_SIZE + 256);
+
+    for (const_iterator it = begin(); it != end(); ++it)
+    {
+        if (forDisplay)
+        {
+            buffer += to_string(it.index());
+            buffer += ' ';
+        }
+        buffer += it->getName();
+        buffer += ", ";
+        buffer += it->getPhone();
+        buffer += ", ";
+        buffer += it->getEmail();
+        buffer += ", ";
+        buffer += forDisplay ? it->getMaskedCreditCard() : it->getCreditCard();
+        buffer += '\n';
+
+        if (buffer.size() >= BUFFER_SIZE)
+        {
+            os.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    os.write(buffer.data(), buffer.size());
+}
+
 // Description: returns true if list is empty, otherwise false
 bool List::isEmpty() const
 {
-    return elementCount == 0;
+    return hashTable.size() == 0;
 }
 
 // Description: Prints an histogram showing distribution of hash indices over the hash table.
@@ -172,10 +777,10 @@ void List::histogram()
 {
     cout << endl
          << "Histogram showing distribution of hash indices over the hash table: " << endl;
-    for (unsigned int i = 0; i < CAPACITY; i++)
+    for (unsigned int i = 0; i < hashTable.capacity(); i++)
     {
         cout << "At hashTable[" << i << "]: ";
-        for (unsigned int j = 0; j < collisions[i]; j++)
+        for (unsigned int j = 0; j < hashTable.collisionsAt(i); j++)
             cout << "*";
         cout << endl;
     }
@@ -190,19 +795,20 @@ void List::printStats()
     unsigned int moreProbes = 0;
 
     cout << endl
-         << "In the process of inserting " << this->elementCount << " elements, number of collisions ... " << endl;
-    for (unsigned int i = 0; i < CAPACITY; i++)
+         << "In the process of inserting " << hashTable.size() << " elements, number of collisions ... " << endl;
+    for (unsigned int i = 0; i < hashTable.capacity(); i++)
     {
-        if (collisions[i] == 0)
+        unsigned int collisions = hashTable.collisionsAt(i);
+        if (collisions == 0)
             emptyCell++;
-        else if (collisions[i] == 1)
+        else if (collisions == 1)
             oneProbe++;
         else
         {
-            if (collisions[i] > 1)
+            if (collisions > 1)
             {
                 moreProbes++;
-                cout << "at hashTable[" << i << "] = " << collisions[i] << endl;
+                cout << "at hashTable[" << i << "] = " << collisions << endl;
             }
         }
     }
@@ -211,10 +817,60 @@ void List::printStats()
          << "There are " << emptyCell << " empty cells." << endl;
     cout << oneProbe << " elements inserted without collisions." << endl;
     cout << "There were " << moreProbes << " collisions." << endl;
+    cout << "There are " << hashTable.tombstones() << " tombstones; the table was compacted " << hashTable.compactions() << " times." << endl;
+    cout << "Average probe length of a successful search: " << getAverageProbeLength() << endl;
+    if (filter != nullptr)
+    {
+        cout << "Filter: " << filter->getMemoryUsage() << " bytes (" << filter->getMemoryUsage() * 8.0 / hashTable.capacity()
+             << " bits per cell), " << filterStaleKeys << " removed phones not yet cleared." << endl;
+    }
+    if (adaptive != nullptr)
+    {
+        cout << "Hash function: " << adaptive->currentName << " (" << adaptive->switches.size() << " adaptive switches)." << endl;
+        for (const HashSwitch &change : adaptive->switches)
+        {
+            cout << "  " << change.from << " -> " << change.to << " at " << change.elementCount << " elements: "
+                 << change.insertProbeLength << " cells per insertion (expected " << change.expectedInsertProbeLength
+                 << "), average probe length " << change.probeLengthBefore << " before, " << change.probeLengthAfter
+                 << " after." << endl;
+        }
+    }
+    printLatency(cout);
 
     return;
 }
 
+// Description: Returns the average number of cells visited by a successful search
+//              (1 when every element sits at its home index).
+double List::getAverageProbeLength() const
+{
+    return hashTable.averageProbeLength();
+}
+
+// Description: Returns the memory used by the hashTable in bytes, not by the elements.
+unsigned long long List::getTableMemoryUsage() const
+{
+    return hashTable.memoryUsage();
+}
+
+// Description: Returns a read-only, compact copy of the List. The caller owns the FrozenList.
+FrozenList *List::freeze() const
+{
+    return new FrozenList(*this);
+}
+
+// Description: Returns the number of tombstones currently in the hashTable.
+unsigned int List::getTombstoneCount() const
+{
+    return hashTable.tombstones();
+}
+
+// Description: Returns the number of times the hashTable was compacted.
+unsigned int List::getCompactionCount() const
+{
+    return hashTable.compactions();
+}
+
 unsigned int List::returnInsertCount()
 {
     return insertCount;
@@ -4,8 +4,13 @@
  * Class Description: List data collection ADT.
  *                    Based on the Hashing strategy and the open addressing
  *                    collision resolution strategy called linear probing hashing.
+ *                    The hash table itself is HashTable (HashTable.h) instantiated for
+ *                    Member elements keyed by phone; List adds the Member specific parts
+ *                    (ownership of the elements, secondary indexes, printing).
  * Class Invariant: Data collection with the following characteristics:
  *                  - Each element is unique (no duplicates).
+ *                  - A removed element leaves a tombstone in its cell until the
+ *                    table is compacted.
  *
  * Author: AL
  * Date: Last modified: Nov. 2022
@@ -16,7 +21,19 @@
 
 // You can add #include statements if you wish.
 #include <string>
+#include <vector>
+#include <ostream>
 #include "Member.h"
+#include "ErrorCode.h"
+#include "HashTable.h"
+#include "MemberIndex.h"
+#include "PhoneIndex.h"
+#include "PhoneFilter.h"
+#include "LatencyTracker.h"
+#include "HashFamily.h"
+#include "PhoneKey.h"
+
+class FrozenList;
 
 class List
 {
@@ -26,28 +43,125 @@ private:
    * For experimentation purposes, you can add private data members to this List class.
    */
 
-  Member **hashTable = nullptr;         // HashTable - underlying data structure (array) of our Data Collection.
-                                        // HashTable is a pointer to an array of pointers to objects of Member class
-  unsigned int elementCount = 0;        // Current number of elements stored into Data Collection.
-  unsigned int (*hashFcn)(string name); // Pointer to hash function.
+  // Hash functor calling the hash function given to the constructor, or the one adaptive hashing
+  // switched to (possibly a seeded one), on the phone number of a packed key. The functions of
+  // PhoneKey.h are called on the key itself, the others on the phone formatted back (XXX-XXX-XXXX).
+  struct HashFunction
+  {
+    unsigned int (*hashFcn)(string name); // Pointer to hash function.
+    HashFamily::SeededHashFcn seededFcn = nullptr;
+    unsigned long long seed = 0;
+    HashFunction(unsigned int (*hFcn)(string)) : hashFcn(hFcn) {}
+    HashFunction(HashFamily::SeededHashFcn sFcn, unsigned long long aSeed) : hashFcn(nullptr), seededFcn(sFcn), seed(aSeed) {}
+    unsigned int operator()(unsigned long long key) const
+    {
+      if (hashFcn == hashPhone)
+      {
+        return hashPhoneKey(key);
+      }
+      if (seededFcn == hashPhoneSeeded)
+      {
+        return hashPhoneKeySeeded(key, seed);
+      }
+      char phone[12];
+      formatPhoneKey(key, phone);
+      return (seededFcn != nullptr) ? seededFcn(string(phone, 12), seed) : hashFcn(string(phone, 12));
+    }
+  };
+
+  // Key extractor: the indexing key of a member is its phone number, packed (the hot part of a Member:
+  // comparing keys along a probe sequence reads 8 bytes of each member, and copies no string).
+  struct MemberPhone
+  {
+    unsigned long long operator()(const Member &element) const { return element.getPhoneKey(); }
+  };
+
+  typedef HashTable<unsigned long long, Member, HashFunction, MemberPhone, TablePolicy<DynamicCapacity, LinearProbing, true>> MemberTable;
+
+  MemberTable hashTable; // HashTable - underlying data structure (array of pointers to objects of Member class)
+                         // of our Data Collection, with its occupancy bitmap, tombstones and collision counts.
+
+  MemberIndex *emailIndex = nullptr; // Optional secondary index on email (unique), nullptr when disabled.
+  MemberIndex *nameIndex = nullptr;  // Optional secondary index on case-folded name (non-unique), nullptr when disabled.
+  PhoneIndex *phoneIndex = nullptr;  // Optional ordered index on phone, nullptr when disabled.
+  PhoneFilter *filter = nullptr;     // Optional filter rejecting most searches of absent phones, nullptr when disabled.
+  unsigned int filterStaleKeys = 0;  // Phones removed since the filter was (re)built, still in the filter.
+  LatencyTracker *latency = nullptr; // Optional per-operation timing, nullptr when disabled.
 
-  unsigned int *collisions = nullptr; // Record the number of time hash function produce a particular hash index
+  struct AdaptiveHashing;              // Family, threshold and progress of adaptive hashing (see List.cpp).
+  AdaptiveHashing *adaptive = nullptr; // nullptr when disabled.
+
+  // Description: Untimed bodies of tryInsert( ), trySearch( ) and tryRemove( ).
+  ErrorCode insertElement(Member &newElement);
+  ErrorCode searchElement(const Member &target, Member *&found) const;
+  ErrorCode removeElement(const Member &target);
+
+  // Description: Records the duration of an operation on the phone packed into phoneKey started at start
+  //              (LatencyTracker::now( )) and reports it to the slow operation hook, with the probe length
+  //              of the phone, if it was slow.
+  void recordLatency(LatencyTracker::Operation operation, unsigned long long start, unsigned long long phoneKey) const;
+
+  // Description: Returns the stored element with the same indexing key (phone) as target, nullptr if none.
+  // Postcondition: List remains unchanged.
+  Member *find(const Member &target) const;
+
+  // Description: Clears the filter and adds the phone of every stored element.
+  void rebuildFilter();
+
+  // Description: Adaptive hashing: if the insertions since the last check visited more cells than the
+  //              threshold times what they would with a uniform hash function, rehashes with the next
+  //              function of the family (or a new seed).
+  void checkClustering();
 
   // Description: Checks if the table is empty.
   // Postcondition: List remains unchanged.
   bool isEmpty() const;
 
+  // Description: Writes every element, one per line, through a local buffer so that
+  //              the stream is written in large blocks instead of once (and flushed) per element.
+  //              forDisplay: each element is preceded by its hashTable index and its card is masked.
+  void writeElements(ostream &os, bool forDisplay) const;
+
 public:
+  // Forward iterator over the elements stored in the List (unsorted, in hashTable order).
+  // it.index() is the hashTable index of the current element. Invalidated by insert( ) and remove( ).
+  typedef MemberTable::const_iterator const_iterator;
+
+  // State of a search suspended at a cache miss (see beginSearch( ), and InterleavedSearch.h which
+  // interleaves many of them).
+  typedef MemberTable::Lookup SearchStep;
+
   /*
    * You can add more private methods to this class, but you cannot remove the public methods below nor can you change their prototype.
    * For experimentation purposes, you can add public methods to this List class.
    *
    */
 
-  const static unsigned int CAPACITY = 103; // Size of hashTable - underlying data structure (array) of List.
+  const static unsigned int CAPACITY = 103; // Default size of hashTable - underlying data structure (array) of List.
+
+  const static unsigned int CLUSTERING_CHECK_INTERVAL = 256; // Insertions between two checks of adaptive hashing.
+  const static unsigned int MIN_CLUSTERED_PROBE_LENGTH = 4;  // Fewer cells per insertion never trigger a switch.
+  const static unsigned int MAX_RESEEDS = 4;                 // Reseeds of the last (seeded) function of the family.
+  static constexpr double DEFAULT_CLUSTERING_THRESHOLD = 2.0;
+
+  // A switch of hash function made by adaptive hashing.
+  struct HashSwitch
+  {
+    string from;
+    string to;
+    unsigned int elementCount;       // Elements stored when the switch was made.
+    double insertProbeLength;        // Average cells visited by the insertions that triggered it,
+    double expectedInsertProbeLength; // the average expected at that load factor,
+    double probeLengthBefore;        // average probe length of a successful search before the switch
+    double probeLengthAfter;         // and after it.
+  };
 
   // Constructor
-  List(unsigned int (*hFcn)(string));
+  // Description: Creates an empty List of aCapacity cells. Hash indices produced by hFcn
+  //              are reduced modulo aCapacity. With TableAllocation::HUGE_PAGES, the hashTable
+  //              is backed by 2 MB transparent huge pages when the system allows it (for tables
+  //              much larger than the TLB reach), ordinary pages otherwise.
+  List(unsigned int (*hFcn)(string), unsigned int aCapacity = CAPACITY, TableAllocation allocation = TableAllocation::HEAP);
 
   // Destructor
   // Description: Destruct a List object, releasing heap-allocated memory.
@@ -57,12 +171,21 @@ public:
   // Postcondition: List remains unchanged.
   unsigned int getElementCount() const;
 
+  // Description: Returns the size of the hashTable.
+  // Postcondition: List remains unchanged.
+  unsigned int getCapacity() const;
+
+  // Description: Returns true if the hashTable is backed by huge pages.
+  // Postcondition: List remains unchanged.
+  bool usesHugePages() const;
+
   // Description: Insert an element.
   // NOTE: You do not have to expand the hashTable when it is full.
   // Precondition: newElement must not already be in in the List.
   // Postcondition: newElement inserted and elementCount has been incremented.
   // Exception: Throws UnableToInsertException if we cannot insert newElement in the List.
-  //            For example, if the operator "new" fails, or hashTable is full (temporary solution).
+  //            For example, if the operator "new" fails, or hashTable is full (temporary solution),
+  //            or the phone number of newElement is invalid ("000-000-0000").
   // Exception: Throws ElementAlreadyExistsException if newElement is already in the List.
   void insert(Member &newElement);
 
@@ -72,16 +195,199 @@ public:
   // Exception: Throws ElementDoesNotExistException if newElement is not found in the List.
   Member *search(Member &target) const;
 
-  // Description: Prints all elements stored in the List (unsorted).
+  // Description: Removes the element with the same indexing key (phone) as target.
+  // Postcondition: The stored element is deleted (the List owns its elements) and elementCount
+  //                has been decremented.
+  // Exception: Throws EmptyDataCollectionException if the List is empty.
+  // Exception: Throws ElementDoesNotExistException if target is not found in the List.
+  void remove(Member &target);
+
+  // Non-throwing API: same as insert( ), search( ) and remove( ), but the outcome is
+  // returned as an ErrorCode (ErrorCode::OK on success) instead of being thrown.
+
+  // Description: Insert an element.
+  // Postcondition: If ErrorCode::OK is returned, newElement is inserted. Otherwise the List is unchanged:
+  //                ErrorCode::ELEMENT_ALREADY_EXISTS if its phone (or email, when indexed) is already in the List,
+  //                ErrorCode::UNABLE_TO_INSERT if the hashTable has no free cell for it,
+  //                ErrorCode::INVALID_KEY if its phone is "000-000-0000" (an invalid phone number, see Member).
+  ErrorCode tryInsert(Member &newElement);
+
+  // Description: Looks up the element with the same indexing key (phone) as target.
+  // Postcondition: If ErrorCode::OK is returned, found points to the element. Otherwise found is
+  //                nullptr and the code is ErrorCode::EMPTY_DATA_COLLECTION or ErrorCode::ELEMENT_DOES_NOT_EXIST.
+  //                List remains unchanged.
+  ErrorCode trySearch(const Member &target, Member *&found) const;
+
+  // Description: Removes (and deletes) the element with the same indexing key (phone) as target.
+  // Postcondition: If ErrorCode::OK is returned, the element is removed. Otherwise the List is unchanged
+  //                and the code is ErrorCode::EMPTY_DATA_COLLECTION or ErrorCode::ELEMENT_DOES_NOT_EXIST.
+  ErrorCode tryRemove(const Member &target);
+
+  // Description: Inserts elements[0 .. count - 1] in order; codes[i] is the outcome of tryInsert( ) for
+  //              elements[i]. The home cells of a group of elements are prefetched before the group is
+  //              inserted, so that their cache misses overlap.
+  // Postcondition: The List owns the elements inserted (codes[i] == ErrorCode::OK).
+  void insertMany(Member *const *elements, ErrorCode *codes, unsigned int count);
+
+  // Description: Looks up a batch of phone numbers: results[i] is set to the element whose
+  //              phone is phones[i], or nullptr if there is none (no exception is thrown).
+  //              The hash indices of a group of keys are computed up front and their cells
+  //              prefetched, then the lookups of the group are resolved while the cache misses
+  //              of the other keys are still in flight (group prefetching).
+  // Postcondition: List remains unchanged.
+  void searchMany(const string *phones, Member **results, unsigned int count) const;
+
+  // Description: Starts a resumable search of the phone packed into phoneKey (see normalizePhone( )):
+  //              computes its home cell and prefetches it. Carry it on with resumeSearch( ), with the
+  //              same key, once the prefetch had time to land.
+  // Postcondition: List remains unchanged.
+  void beginSearch(unsigned long long phoneKey, SearchStep &step) const;
+
+  // Description: Carries on a resumable search up to its next cache miss. Returns false if it had to
+  //              prefetch (call again later), true once step.result is set: the element whose phone is
+  //              packed into phoneKey, or nullptr if there is none. The List must not be modified in between.
+  // Postcondition: List remains unchanged.
+  bool resumeSearch(unsigned long long phoneKey, SearchStep &step) const;
+
+  // Description: Builds a filter (blocked Bloom filter, see PhoneFilter.h) over the phones of the
+  //              List, sized for its capacity, and keeps it up to date from now on. A search for
+  //              a phone that is not stored is then rejected after reading one cache line of the
+  //              filter, in most cases, instead of walking the probe sequence.
+  //              Removed phones stay in the filter until it is rebuilt, which happens by itself once
+  //              they amount to 1/TOMBSTONE_RATIO of the capacity. searchMany( ) does not use the filter.
+  void enableFilter(unsigned int bitsPerKey = PhoneFilter::BITS_PER_KEY);
+
+  // Description: Returns the memory used by the filter in bytes, 0 if it is disabled.
+  unsigned long long getFilterMemoryUsage() const;
+
+  // Description: Times insert( ), search( ) and remove( ) (and their non-throwing versions) from now on,
+  //              into per-thread log-linear histograms (see LatencyTracker.h): about two clock reads,
+  //              two relaxed atomic increments and a relaxed load of the maximum per operation (and a
+  //              compare-and-swap when the operation is the slowest so far), cheap enough to leave enabled.
+  //              searchMany( ) is not timed.
+  void enableLatencyTracking();
+
+  // Description: Returns the latency tracker (for percentiles), nullptr if latency tracking is disabled.
+  const LatencyTracker *getLatencyTracker() const;
+
+  // Description: Enables latency tracking and, from now on, passes each operation taking thresholdNanoseconds
+  //              or more to hook (nullptr: none), with its phone and the number of cells a search of its
+  //              phone visits. The hook runs on the thread of the operation, after it.
+  void setSlowOperationHook(unsigned long long thresholdNanoseconds, LatencyTracker::SlowOperationHook hook);
+
+  // Description: Prints p50, p99, p99.9 and max latency of each operation, if latency tracking is enabled.
+  // Postcondition: List remains unchanged.
+  void printLatency(ostream &os) const;
+
+  // Description: Adaptive hashing: from now on, every CLUSTERING_CHECK_INTERVAL insertions, the average number
+  //              of cells they visited is compared with the one linear probing gives with a uniform hash
+  //              function at the current load factor (Knuth: (1 + 1 / (1 - load)^2) / 2). If it is more
+  //              than clusteringThreshold times higher (and at least MIN_CLUSTERED_PROBE_LENGTH), the
+  //              hashTable is rehashed, in one pass during that insertion, with the next function of
+  //              family (functions are tried in order; the last one, if seeded, is then reseeded up to
+  //              MAX_RESEEDS times). Each switch is recorded (getHashSwitches( ), printStats( )).
+  void enableAdaptiveHashing(const HashFamily &family, double clusteringThreshold = DEFAULT_CLUSTERING_THRESHOLD);
+
+  // Description: Returns the hash function switches made by adaptive hashing, in order.
+  const vector<HashSwitch> &getHashSwitches() const;
+
+  // Description: Returns the name of the hash function in use ("initial": the one given to the constructor).
+  string getHashFunctionName() const;
+
+  // Description: Builds a secondary index on email and keeps it up to date from now on.
+  //              Emails become unique: inserting a member with an email already in the List fails.
+  //              Members without an email are not indexed, so any number of them may be stored.
+  // Exception: Throws ElementAlreadyExistsException if two stored members already share an email.
+  void enableEmailIndex();
+
+  // Description: Builds a secondary index on the case-folded name and keeps it up to date from now on.
+  //              Several members may share a name.
+  void enableNameIndex();
+
+  // Description: Returns a pointer to the element whose email is email.
+  //              Uses the email index if enabled, otherwise scans the hashTable.
+  // Postcondition: List remains unchanged.
+  // Exception: Throws EmptyDataCollectionException if the List is empty.
+  // Exception: Throws ElementDoesNotExistException if no element has this email (or email is empty).
+  Member *searchByEmail(const string &email) const;
+
+  // Description: Returns pointers to all elements whose name matches name, ignoring case.
+  //              Uses the name index if enabled, otherwise scans the hashTable.
+  //              An empty name matches nothing.
+  // Postcondition: List remains unchanged.
+  vector<Member *> searchByName(const string &name) const;
+
+  // Description: Builds an ordered index on phone and keeps it up to date from now on.
+  void enableOrderedIndex();
+
+  // Description: Returns the elements whose phone is between lowPhone and highPhone (inclusive),
+  //              in increasing order of phone. Enables the ordered index if needed.
+  //              Iterate with: for (const PhoneIndex::Entry &entry : range) ... entry.element ...
+  // Postcondition: The range stays valid until the List is modified.
+  PhoneIndex::Range searchByPhoneRange(const string &lowPhone, const string &highPhone);
+
+  // Description: Returns the elements whose phone starts with prefix (e.g. area code "604"),
+  //              in increasing order of phone. Enables the ordered index if needed.
+  // Postcondition: The range stays valid until the List is modified.
+  //                The range is empty if prefix contains no digit or more than 10 digits.
+  PhoneIndex::Range searchByPhonePrefix(const string &prefix);
+
+  // Description: Changes the email of a stored element, keeping the email index consistent.
+  //              Use this rather than Member::setEmail( ) on elements stored in the List.
+  // Exception: Throws ElementDoesNotExistException if target is not in the List.
+  // Exception: Throws ElementAlreadyExistsException if the email index is enabled and
+  //            another element already has newEmail.
+  void setEmail(Member &target, const string &newEmail);
+
+  // Description: Changes the name of a stored element, keeping the name index consistent.
+  //              Use this rather than Member::setName( ) on elements stored in the List.
+  // Exception: Throws ElementDoesNotExistException if target is not in the List.
+  void setName(Member &target, const string &newName);
+
+  // Description: Returns an iterator to the first element (hashTable order).
+  const_iterator begin() const;
+
+  // Description: Returns the past-the-end iterator.
+  const_iterator end() const;
+
+  // Description: Prints all elements stored in the List (unsorted), each preceded by its hashTable index,
+  //              with the credit cards masked.
   // Postcondition: List remains unchanged.
   void printList() const;
 
+  // Description: Writes all elements stored in the List (unsorted) to os, one per line, in the
+  //              format of operator<<(ostream &, const Member &) but with the full credit card numbers
+  //              (a roster file, readable by RosterMerge). The stream is not flushed per element.
+  // Postcondition: List remains unchanged.
+  void exportTo(ostream &os) const;
+
   // Description: Prints an histogram showing distribution of hash indices over the hash table.
   void histogram();
 
   // Description: Prints various stats.
   void printStats();
 
+  // Description: Returns the average number of cells visited by a successful search
+  //              (1 when every element sits at its home index).
+  // Postcondition: List remains unchanged.
+  double getAverageProbeLength() const;
+
+  // Description: Returns the memory used by the hashTable (cells, occupancy bitmap, collision counts)
+  //              in bytes, not by the elements.
+  unsigned long long getTableMemoryUsage() const;
+
+  // Description: Returns a read-only, compact copy of the List: its elements in a dense array positioned
+  //              by a minimal perfect hash function (see FrozenList.h). The caller owns the FrozenList;
+  //              delete the List afterwards to keep only the compact form.
+  // Postcondition: List remains unchanged.
+  FrozenList *freeze() const;
+
+  // Description: Returns the number of tombstones currently in the hashTable.
+  unsigned int getTombstoneCount() const;
+
+  // Description: Returns the number of times the hashTable was compacted.
+  unsigned int getCompactionCount() const;
+
   unsigned int returnInsertCount();
 
 }; // end List.h
@@ -0,0 +1,2143 @@
+/*
+ * ListBenchmarkDriver.cpp
+ *
+ * Description: Benchmark Driver for the hashing-based data collection classes.
+ *              Usage: lbd [lookups] [members in the large tables]
+ *                     lbd check
+ *              Each benchmark builds its tables from in-memory random members
+ *              (no file I/O, except the ingest benchmark, which writes its member files
+ *              to a temporary directory) and reports timings on cout.
+ *              "lbd check" only runs the behavioural checks (and the benchmarks that carry some), on
+ *              small tables (fast enough for the sanitizer builds); lbd exits with status 1 if a
+ *              check failed.
+ *
+ * Author: Elaine Luu
+ * Created on: Oct. 2026
+ *
+ */
+
+#include "List.h"
+#include "CuckooList.h"
+#include "PhoneIndex.h"
+#include "Member.h"
+#include "PhoneKey.h"
+#include "PhoneFilter.h"
+#include "HashTable.h"
+#include "RosterMerge.h"
+#include "ShardedList.h"
+#include "VersionedList.h"
+#include "FrozenList.h"
+#include "CardVault.h"
+#include "MemberIngest.h"
+#include "RosterCodec.h"
+#include "InterleavedSearch.h"
+#include "MemberColdArena.h"
+#include "ElementDoesNotExistException.h"
+#include "UnableToInsertException.h"
+#include "UnableToOpenFileException.h"
+#include <iostream>
+#include <stdlib.h> // for rand()
+#include <chrono>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <map>
+#include <unordered_set>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <unistd.h> // for unlink(), rmdir()
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+unsigned int failedChecks = 0; // Checks failed so far (lbd then exits with status 1).
+
+// Description: Reports the outcome of a behavioural check and counts a failure.
+void check(bool passed, const string &what)
+{
+    cout << (passed ? "check passed: " : "CHECK FAILED: ") << what << endl;
+    if (!passed)
+    {
+        failedChecks++;
+    }
+}
+
+// Description: Formats a packed 10-digit key as XXX-XXX-XXXX.
+string formatPhone(unsigned long long key)
+{
+    char buffer[13];
+    for (int i = 11; i >= 0; i--)
+    {
+        if (i == 3 || i == 7)
+        {
+            buffer[i] = '-';
+        }
+        else
+        {
+            buffer[i] = (char)('0' + key % 10);
+            key /= 10;
+        }
+    }
+    buffer[12] = '\0';
+    return string(buffer);
+}
+
+// Description: Creates "num" distinct random phone numbers of the expected format.
+vector<string> randomPhones(unsigned int num, unsigned int seed)
+{
+    srand(seed);
+    unordered_set<unsigned long long> used;
+    vector<string> phones;
+    phones.reserve(num);
+    while (phones.size() < num)
+    {
+        unsigned long long key = ((unsigned long long)rand() << 31 | (unsigned long long)rand()) % 10000000000ULL;
+        if (used.insert(key).second)
+        {
+            phones.push_back(formatPhone(key));
+        }
+    }
+    return phones;
+}
+
+// Description: Creates a heap-allocated member for each phone number.
+vector<Member *> makeMembers(const vector<string> &phones)
+{
+    vector<Member *> members;
+    members.reserve(phones.size());
+    for (unsigned int i = 0; i < phones.size(); i++)
+    {
+        members.push_back(new Member("Member " + to_string(i), phones[i], "member" + to_string(i) + "@gmail.com", "0000000000000"));
+    }
+    return members;
+}
+
+// Description: Prints the p50, p99, p99.9 and max of a set of per-operation timings (ns).
+void printPercentiles(const string &label, vector<unsigned long long> &timings)
+{
+    sort(timings.begin(), timings.end());
+    unsigned int n = timings.size();
+    cout << label << ": p50 " << timings[n / 2] << " ns, p99 " << timings[(unsigned int)(n * 0.99)]
+         << " ns, p99.9 " << timings[(unsigned int)(n * 0.999)] << " ns, max " << timings[n - 1] << " ns" << endl;
+}
+
+// Description: Times "lookups" searches of random stored keys, one at a time.
+template <class Table>
+void timeLookups(const string &label, Table &table, const vector<Member> &probes, unsigned int lookups)
+{
+    vector<unsigned long long> timings(lookups);
+    srand(7);
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        Member &target = const_cast<Member &>(probes[rand() % probes.size()]);
+        Clock::time_point start = Clock::now();
+        table.search(target);
+        Clock::time_point stop = Clock::now();
+        timings[i] = chrono::duration_cast<chrono::nanoseconds>(stop - start).count();
+    }
+    printPercentiles(label, timings);
+}
+
+// Description: Compares the search tail latency of linear probing (List) against
+//              bucketized cuckoo hashing (CuckooList) at the load our driver uses
+//              (100 members in a 103-cell table), then cuckoo hashing on a large table.
+void benchCuckooVersusLinearProbing(unsigned int lookups)
+{
+    cout << "********** Tail latency: linear probing vs cuckoo hashing **********" << endl;
+
+    vector<string> phones = randomPhones(100, 1);
+    vector<Member> probes;
+    for (unsigned int i = 0; i < phones.size(); i++)
+    {
+        probes.push_back(Member(phones[i]));
+    }
+
+    List linear(hashPhone);
+    CuckooList cuckoo(List::CAPACITY);
+    vector<Member *> forLinear = makeMembers(phones);
+    vector<Member *> forCuckoo = makeMembers(phones);
+    for (unsigned int i = 0; i < phones.size(); i++)
+    {
+        linear.insert(*forLinear[i]);
+        cuckoo.insert(*forCuckoo[i]);
+    }
+    timeLookups("List (linear probing), 100 members ", linear, probes, lookups);
+    timeLookups("CuckooList, 100 members            ", cuckoo, probes, lookups);
+
+    unsigned int large = 1000000;
+    vector<string> manyPhones = randomPhones(large, 2);
+    vector<Member> manyProbes;
+    manyProbes.reserve(large);
+    for (unsigned int i = 0; i < large; i++)
+    {
+        manyProbes.push_back(Member(manyPhones[i]));
+    }
+    CuckooList bigCuckoo(large);
+    vector<Member *> forBigCuckoo = makeMembers(manyPhones);
+    for (unsigned int i = 0; i < large; i++)
+    {
+        bigCuckoo.insert(*forBigCuckoo[i]);
+    }
+    timeLookups("CuckooList, 1000000 members        ", bigCuckoo, manyProbes, lookups);
+    bigCuckoo.printStats();
+
+    cout << "********** End of tail latency benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Times building the ordered phone index from random members (batched merges)
+//              and scanning area-code ranges out of it.
+void benchOrderedIndex(unsigned int num)
+{
+    cout << "********** Ordered phone index: build and range scans **********" << endl;
+
+    vector<string> phones = randomPhones(num, 3);
+    vector<Member *> members = makeMembers(phones);
+
+    Clock::time_point start = Clock::now();
+    PhoneIndex index;
+    for (unsigned int i = 0; i < num; i++)
+    {
+        index.insert(packPhone(phones[i]), members[i]);
+    }
+    index.range(0, 0); // forces the last merge
+    double buildSeconds = chrono::duration<double>(Clock::now() - start).count();
+
+    // Scan every area code: 1000 ranges that together cover the whole index.
+    start = Clock::now();
+    unsigned long long scanned = 0;
+    unsigned long long checksum = 0;
+    for (unsigned int areaCode = 0; areaCode < 1000; areaCode++)
+    {
+        unsigned long long low = areaCode * 10000000ULL;
+        PhoneIndex::Range range = index.range(low, low + 9999999ULL);
+        for (const PhoneIndex::Entry &entry : range)
+        {
+            checksum += entry.key;
+            scanned++;
+        }
+    }
+    double scanSeconds = chrono::duration<double>(Clock::now() - start).count();
+
+    cout << "Built index of " << num << " members in " << buildSeconds * 1000 << " ms" << endl;
+    cout << "Scanned " << scanned << " entries by area code in " << scanSeconds * 1000 << " ms ("
+         << (scanned * sizeof(PhoneIndex::Entry)) / scanSeconds / 1e9 << " GB/s, checksum " << checksum % 1000 << ")" << endl;
+
+    for (unsigned int i = 0; i < num; i++)
+    {
+        delete members[i];
+    }
+    cout << "********** End of ordered phone index benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Compares a loop of List::search against List::searchMany at batch sizes
+//              8 to 1024, on a table of "num" members at load 1/2 (large enough that the
+//              cells and members it touches are not cache resident).
+void benchSearchMany(unsigned int num, unsigned int lookups)
+{
+    cout << "********** Batched lookups: search vs searchMany **********" << endl;
+
+    vector<string> phones = randomPhones(num, 4);
+    vector<Member *> members = makeMembers(phones);
+    List table(hashPhone, 2 * num);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        table.insert(*members[i]);
+    }
+
+    srand(8);
+    vector<string> keys(lookups);
+    vector<Member> probes;
+    probes.reserve(lookups);
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        keys[i] = phones[((unsigned int)rand() << 15 ^ (unsigned int)rand()) % num];
+        probes.push_back(Member(keys[i]));
+    }
+    vector<Member *> results(lookups);
+
+    Clock::time_point start = Clock::now();
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        results[i] = table.search(probes[i]);
+    }
+    double loopSeconds = chrono::duration<double>(Clock::now() - start).count();
+    cout << num << " members, " << lookups << " lookups" << endl;
+    cout << "search loop        : " << loopSeconds * 1e9 / lookups << " ns/lookup" << endl;
+
+    for (unsigned int batch = 8; batch <= 1024; batch *= 2)
+    {
+        start = Clock::now();
+        for (unsigned int i = 0; i < lookups; i += batch)
+        {
+            unsigned int count = (lookups - i < batch) ? lookups - i : batch;
+            table.searchMany(&keys[i], &results[i], count);
+        }
+        double batchSeconds = chrono::duration<double>(Clock::now() - start).count();
+        cout << "searchMany batch " << batch << (batch < 10 ? "   " : batch < 100 ? "  " : batch < 1000 ? " " : "")
+             << ": " << batchSeconds * 1e9 / lookups << " ns/lookup (speedup " << loopSeconds / batchSeconds << "x)" << endl;
+    }
+
+    cout << "********** End of batched lookups benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Compares ways of enumerating a List of "num" members: iterating over it,
+//              writing each member with operator<< (one flush per member, as printList used to),
+//              and the buffered exportTo( ). Output goes to /dev/null.
+void benchIteration(unsigned int num)
+{
+    cout << "********** Traversal and export **********" << endl;
+
+    vector<string> phones = randomPhones(num, 5);
+    vector<Member *> members = makeMembers(phones);
+    List table(hashPhone, 2 * num);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        table.insert(*members[i]);
+    }
+
+    Clock::time_point start = Clock::now();
+    unsigned int visited = 0;
+    for (List::const_iterator it = table.begin(); it != table.end(); ++it)
+    {
+        visited++;
+    }
+    double iterateSeconds = chrono::duration<double>(Clock::now() - start).count();
+
+    ofstream sink("/dev/null");
+    start = Clock::now();
+    for (List::const_iterator it = table.begin(); it != table.end(); ++it)
+    {
+        sink << it.index() << " " << *it;
+    }
+    double perMemberSeconds = chrono::duration<double>(Clock::now() - start).count();
+
+    start = Clock::now();
+    table.exportTo(sink);
+    sink.flush();
+    double exportSeconds = chrono::duration<double>(Clock::now() - start).count();
+
+    cout << "Iterated over " << visited << " members in " << iterateSeconds * 1000 << " ms" << endl;
+    cout << "operator<< per member: " << perMemberSeconds * 1000 << " ms" << endl;
+    cout << "exportTo             : " << exportSeconds * 1000 << " ms (speedup " << perMemberSeconds / exportSeconds << "x)" << endl;
+
+    cout << "********** End of traversal and export benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Churn: "cycles" times, removes a random member and inserts a new one, on a
+//              table kept at load 1/2. Prints the average probe length of a successful search,
+//              the tombstone count and the number of compactions at 20 points in time.
+void benchChurn(unsigned int num, unsigned int cycles)
+{
+    cout << "********** Churn: remove + insert cycles **********" << endl;
+
+    vector<string> phones = randomPhones(num, 6);
+    vector<Member *> members = makeMembers(phones);
+    List table(hashPhone, 2 * num);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        table.insert(*members[i]);
+    }
+
+    cout << "cycle, average probe length, tombstones, compactions" << endl;
+    srand(9);
+    unsigned long long nextKey = 0;
+    unsigned int samples = 20;
+    Clock::time_point start = Clock::now();
+    for (unsigned int cycle = 0; cycle <= cycles; cycle++)
+    {
+        if (cycle % max(1u, cycles / samples) == 0)
+        {
+            cout << cycle << ", " << table.getAverageProbeLength() << ", " << table.getTombstoneCount()
+                 << ", " << table.getCompactionCount() << endl;
+        }
+
+        unsigned int victim = ((unsigned int)rand() << 15 ^ (unsigned int)rand()) % num;
+        Member target(phones[victim]);
+        table.remove(target);
+
+        while (true)
+        {
+            phones[victim] = formatPhone(mixKey(nextKey++) % 10000000000ULL);
+            Member *newMember = new Member("Member", phones[victim], "member@gmail.com", "0000000000000");
+            try
+            {
+                table.insert(*newMember);
+                break;
+            }
+            catch (exception &)
+            {
+                delete newMember; // phone already in use, draw another one
+            }
+        }
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+    cout << cycles << " cycles in " << seconds * 1000 << " ms (" << seconds * 1e9 / cycles << " ns/cycle)" << endl;
+
+    cout << "********** End of churn benchmark **********" << endl;
+    cout << endl;
+}
+
+// Hash functor and key extractor of the HashTable instantiations below.
+struct PhoneHash
+{
+    unsigned int operator()(const string &phone) const { return hashPhone(phone); }
+};
+
+struct MemberPhone
+{
+    string operator()(const Member &element) const { return element.getPhone(); }
+};
+
+// Description: Times "lookups" HashTable::find calls of random stored keys, in total (ns per lookup).
+template <class Table>
+void timeFinds(const string &label, const Table &table, const vector<string> &phones, unsigned int lookups)
+{
+    srand(10);
+    vector<unsigned int> order(lookups);
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        order[i] = rand() % phones.size();
+    }
+    unsigned int found = 0;
+    Clock::time_point start = Clock::now();
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        found += table.find(phones[order[i]]) != nullptr;
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+    cout << label << ": " << seconds * 1e9 / lookups << " ns/lookup (" << found << " found)" << endl;
+}
+
+// Description: Compares HashTable instantiations on the driver's 103-cell table holding
+//              100 members: cells embedded in the object (FixedCapacity<103>, no stats),
+//              heap allocated cells (DynamicCapacity) and List itself.
+void benchFixedVersusDynamicCapacity(unsigned int lookups)
+{
+    cout << "********** HashTable: fixed vs dynamic capacity **********" << endl;
+
+    vector<string> phones = randomPhones(100, 11);
+    vector<Member *> members = makeMembers(phones);
+
+    HashTable<string, Member, PhoneHash, MemberPhone, TablePolicy<FixedCapacity<103>, LinearProbing, false>> fixedTable(103);
+    HashTable<string, Member, PhoneHash, MemberPhone, TablePolicy<DynamicCapacity, LinearProbing, true>> dynamicTable(103);
+    for (unsigned int i = 0; i < members.size(); i++)
+    {
+        fixedTable.insert(*members[i]);
+        dynamicTable.insert(*members[i]);
+    }
+    cout << "sizeof fixed table: " << sizeof(fixedTable) << " bytes, sizeof dynamic table: "
+         << sizeof(dynamicTable) << " bytes (+ heap cells)" << endl;
+
+    timeFinds("FixedCapacity<103>, no stats", fixedTable, phones, lookups);
+    timeFinds("DynamicCapacity, stats      ", dynamicTable, phones, lookups);
+
+    List list(hashPhone);
+    for (unsigned int i = 0; i < members.size(); i++)
+    {
+        list.insert(*new Member(*members[i]));
+    }
+    srand(10);
+    unsigned int found = 0;
+    Clock::time_point start = Clock::now();
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        Member target(phones[rand() % phones.size()]);
+        found += list.search(target) != nullptr;
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+    cout << "List (Member probe per lookup): " << seconds * 1e9 / lookups << " ns/lookup (" << found << " found)" << endl;
+
+    for (unsigned int i = 0; i < members.size(); i++)
+    {
+        delete members[i];
+    }
+
+    cout << "********** End of fixed vs dynamic capacity benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Appends a roster line for member i with the given phone and card to roster.
+void appendRosterLine(string &roster, unsigned long long i, const string &phone, unsigned long long card)
+{
+    roster += "Member ";
+    roster += to_string(i);
+    roster += ", ";
+    roster += phone;
+    roster += ", member";
+    roster += to_string(i);
+    roster += "@gmail.com, ";
+    roster += to_string(1000000000000ULL + card % 9000000000000ULL);
+    roster += '\n';
+}
+
+// Description: Merges two generated rosters of "num" lines each. The incoming roster has
+//              50% new phone numbers, 40% duplicates and 10% conflicts (different credit card),
+//              in random order. Times the merge with one thread and with one thread per CPU.
+void benchRosterMerge(unsigned int num)
+{
+    cout << "********** Roster merge (partitioned hash join) **********" << endl;
+
+    string existingRoster;
+    string incomingRoster;
+    existingRoster.reserve((unsigned long long)num * 64);
+    incomingRoster.reserve((unsigned long long)num * 64);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        appendRosterLine(existingRoster, i, formatPhone(mixKey(i) % 10000000000ULL), i);
+    }
+    srand(12);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        unsigned int kind = rand() % 10;
+        if (kind < 5)
+        {
+            unsigned long long other = num + i;
+            appendRosterLine(incomingRoster, other, formatPhone(mixKey(other) % 10000000000ULL), other);
+        }
+        else
+        {
+            unsigned long long same = ((unsigned int)rand() << 15 ^ (unsigned int)rand()) % num;
+            appendRosterLine(incomingRoster, same, formatPhone(mixKey(same) % 10000000000ULL), kind < 9 ? same : same + 1);
+        }
+    }
+    cout << num << " lines per roster (" << (existingRoster.size() + incomingRoster.size()) / 1000000 << " MB)" << endl;
+
+    unsigned int threadCounts[2] = {1, 0};
+    for (unsigned int i = 0; i < 2; i++)
+    {
+        RosterMerge merge(existingRoster, incomingRoster, threadCounts[i]);
+        Clock::time_point start = Clock::now();
+        merge.run();
+        double seconds = chrono::duration<double>(Clock::now() - start).count();
+        cout << (threadCounts[i] == 0 ? "one thread per CPU" : "1 thread") << ": " << seconds * 1000 << " ms ("
+             << seconds * 1e9 / (2.0 * num) << " ns/line), " << merge.getNew().size() << " new, "
+             << merge.getDuplicates().size() << " duplicates, " << merge.getConflicts().size() << " conflicts" << endl;
+    }
+
+    cout << "********** End of roster merge benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Compares the throwing search( ) and the non-throwing trySearch( ) on lookups
+//              of which half miss (a miss is an ElementDoesNotExistException for search( )).
+void benchErrorCodes(unsigned int num, unsigned int lookups)
+{
+    cout << "********** Misses: search (exceptions) vs trySearch (error codes) **********" << endl;
+
+    vector<string> phones = randomPhones(2 * num, 13);
+    List table(hashPhone, 2 * num);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        table.insert(*new Member("Member", phones[i], "member@gmail.com", "0000000000000"));
+    }
+    vector<Member> probes;
+    probes.reserve(lookups);
+    srand(14);
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        probes.push_back(Member(phones[((unsigned int)rand() << 15 ^ (unsigned int)rand()) % (2 * num)]));
+    }
+
+    unsigned int misses = 0;
+    Clock::time_point start = Clock::now();
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        try
+        {
+            table.search(probes[i]);
+        }
+        catch (ElementDoesNotExistException &)
+        {
+            misses++;
+        }
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+    cout << "search:    " << seconds * 1e9 / lookups << " ns/lookup (" << misses << " misses)" << endl;
+
+    misses = 0;
+    start = Clock::now();
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        Member *found = nullptr;
+        if (table.trySearch(probes[i], found) != ErrorCode::OK)
+        {
+            misses++;
+        }
+    }
+    seconds = chrono::duration<double>(Clock::now() - start).count();
+    cout << "trySearch: " << seconds * 1e9 / lookups << " ns/lookup (" << misses << " misses)" << endl;
+
+    cout << "********** End of misses benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Miss-heavy lookups (90% of the phones searched are not members) on a table of
+//              "capacity" cells at load 1/2 and 9/10, without and with the filter.
+//              Prints the lookup time, the measured false positive rate of the filter and its memory.
+void benchFilter(unsigned int capacity, unsigned int lookups)
+{
+    cout << "********** Miss-heavy lookups: filter in front of List **********" << endl;
+
+    double loads[2] = {0.5, 0.9};
+    for (unsigned int l = 0; l < 2; l++)
+    {
+        unsigned int num = (unsigned int)(capacity * loads[l]);
+        vector<string> phones = randomPhones(2 * num, 15);
+        vector<Member> probes;
+        probes.reserve(lookups);
+        srand(16);
+        for (unsigned int i = 0; i < lookups; i++)
+        {
+            unsigned int r = (unsigned int)rand() << 15 ^ (unsigned int)rand();
+            probes.push_back(Member(phones[(r % 10 == 0) ? r / 10 % num : num + r / 10 % num]));
+        }
+
+        PhoneFilter filter(capacity);
+        for (unsigned int i = 0; i < num; i++)
+        {
+            filter.insert(packPhone(phones[i]));
+        }
+        unsigned int falsePositives = 0;
+        for (unsigned int i = num; i < 2 * num; i++)
+        {
+            falsePositives += filter.mayContain(packPhone(phones[i]));
+        }
+
+        cout << "load " << loads[l] << " (" << num << " members, " << capacity << " cells):" << endl;
+        List table(hashPhone, capacity);
+        for (unsigned int i = 0; i < num; i++)
+        {
+            table.insert(*new Member("Member", phones[i], "member@gmail.com", "0000000000000"));
+        }
+        for (unsigned int withFilter = 0; withFilter < 2; withFilter++)
+        {
+            if (withFilter)
+            {
+                table.enableFilter();
+            }
+            unsigned int hits = 0;
+            Clock::time_point start = Clock::now();
+            for (unsigned int i = 0; i < lookups; i++)
+            {
+                Member *found = nullptr;
+                hits += table.trySearch(probes[i], found) == ErrorCode::OK;
+            }
+            double seconds = chrono::duration<double>(Clock::now() - start).count();
+            cout << (withFilter ? "  with filter:    " : "  without filter: ") << seconds * 1e9 / lookups
+                 << " ns/lookup (" << hits << " hits)" << endl;
+        }
+        unsigned long long tableBytes = (unsigned long long)capacity * (sizeof(Member *) + 4) + capacity / 8;
+        cout << "  false positive rate " << 100.0 * falsePositives / num << "%, filter " << table.getFilterMemoryUsage() / 1024
+             << " KiB (" << table.getFilterMemoryUsage() * 8.0 / num << " bits per member, "
+             << 100.0 * table.getFilterMemoryUsage() / tableBytes << "% of the hashTable arrays)" << endl;
+    }
+
+    cout << "********** End of miss-heavy lookups benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Runs searchBatch(first, count) from "clients" threads over [0, lookups) in batches
+//              of 1024 lookups and returns the throughput in millions of lookups per second.
+template <class SearchBatch>
+double lookupThroughput(unsigned int clients, unsigned int lookups, SearchBatch searchBatch)
+{
+    const unsigned int BATCH = 1024;
+    Clock::time_point start = Clock::now();
+    vector<thread> threads;
+    for (unsigned int c = 0; c < clients; c++)
+    {
+        threads.emplace_back([=]()
+                             {
+                                 for (unsigned int first = c * BATCH; first < lookups; first += clients * BATCH)
+                                 {
+                                     searchBatch(first, min(BATCH, lookups - first));
+                                 } });
+    }
+    for (unsigned int c = 0; c < clients; c++)
+    {
+        threads[c].join();
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+    return lookups / seconds / 1e6;
+}
+
+// Description: Lookup throughput of one List shared by all the client threads versus a ShardedList
+//              of 1 shard per NUMA node, 2 and 4 shards, for 1, 2 and 4 client threads.
+void benchSharding(unsigned int num, unsigned int lookups)
+{
+    cout << "********** Sharded List vs one shared List **********" << endl;
+
+    vector<vector<int>> nodes = ShardedList::detectNodes();
+    cout << nodes.size() << " NUMA node(s), " << thread::hardware_concurrency() << " CPU(s)" << endl;
+
+    vector<string> phones = randomPhones(num, 17);
+    vector<string> probes(lookups);
+    srand(18);
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        probes[i] = phones[((unsigned int)rand() << 15 ^ (unsigned int)rand()) % num];
+    }
+
+    unsigned int clientCounts[3] = {1, 2, 4};
+    List shared(hashPhone, 2 * num);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        shared.insert(*new Member("Member", phones[i], "member@gmail.com", "0000000000000"));
+    }
+    for (unsigned int c = 0; c < 3; c++)
+    {
+        double throughput = lookupThroughput(clientCounts[c], lookups, [&](unsigned int first, unsigned int count)
+                                             {
+                                                 Member *results[1024];
+                                                 shared.searchMany(probes.data() + first, results, count); });
+        cout << "shared List, " << clientCounts[c] << " client(s): " << throughput << " M lookups/s" << endl;
+    }
+
+    unsigned int shardCounts[3] = {(unsigned int)nodes.size(), 2, 4};
+    for (unsigned int s = 0; s < 3; s++)
+    {
+        ShardedList sharded(2 * num, shardCounts[s]);
+        vector<Member *> members = makeMembers(phones);
+        vector<ErrorCode> codes(num);
+        sharded.insertMany(members.data(), codes.data(), num);
+        for (unsigned int c = 0; c < 3; c++)
+        {
+            double throughput = lookupThroughput(clientCounts[c], lookups, [&](unsigned int first, unsigned int count)
+                                                 {
+                                                     Member *results[1024];
+                                                     sharded.searchMany(probes.data() + first, results, count); });
+            cout << "ShardedList, " << shardCounts[s] << " shard(s), " << clientCounts[c] << " client(s): "
+                 << throughput << " M lookups/s" << endl;
+        }
+    }
+
+    cout << "********** End of sharding benchmark **********" << endl;
+    cout << endl;
+}
+
+// Element of the huge page benchmark table: a packed phone number only, so that the lookups
+// measure the hashTable's cells rather than Member objects scattered over the heap.
+struct PackedPhone
+{
+    unsigned long long key;
+};
+
+struct PackedPhoneHash
+{
+    unsigned int operator()(unsigned long long key) const { return (unsigned int)(mixKey(key) >> 32); }
+};
+
+struct PackedPhoneKey
+{
+    unsigned long long operator()(const PackedPhone &element) const { return element.key; }
+};
+
+// Description: Random lookups in a table of "capacity" cells at load 1/2 (far beyond the TLB reach
+//              of 4 KB pages), with the cells on ordinary pages then on transparent huge pages.
+void benchHugePages(unsigned int capacity, unsigned int lookups)
+{
+    cout << "********** Huge pages: random lookups in a large table **********" << endl;
+    cout << "Transparent huge pages " << (hugePagesAvailable() ? "available" : "not available") << endl;
+
+    unsigned int num = capacity / 2;
+    vector<unsigned long long> keys(num);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        keys[i] = mixKey(i) % 10000000000ULL;
+    }
+    vector<unsigned long long> probes(lookups);
+    srand(19);
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        probes[i] = keys[((unsigned int)rand() << 15 ^ (unsigned int)rand()) % num];
+    }
+
+    // The elements are allocated like the cells, since a lookup reads both.
+    TableAllocation allocations[2] = {TableAllocation::HEAP, TableAllocation::HUGE_PAGES};
+    for (unsigned int a = 0; a < 2; a++)
+    {
+        TableBlock elementsBlock = allocateTable(sizeof(PackedPhone) * num, allocations[a]);
+        PackedPhone *elements = (PackedPhone *)elementsBlock.memory;
+        HashTable<unsigned long long, PackedPhone, PackedPhoneHash, PackedPhoneKey, TablePolicy<DynamicCapacity, LinearProbing, false>>
+            table(capacity, PackedPhoneHash(), PackedPhoneKey(), allocations[a]);
+        for (unsigned int i = 0; i < num; i++)
+        {
+            elements[i].key = keys[i];
+            unsigned int cell = 0;
+            table.tryInsert(elements[i], cell); // a duplicate phone number is skipped
+        }
+
+        unsigned long long found = 0;
+        Clock::time_point start = Clock::now();
+        for (unsigned int i = 0; i < lookups; i++)
+        {
+            found += table.find(probes[i]) != nullptr;
+        }
+        double seconds = chrono::duration<double>(Clock::now() - start).count();
+        cout << (a == 0 ? "new[] (4 KB pages): " : "huge pages:         ") << seconds * 1e9 / lookups << " ns/lookup ("
+             << found << " found, " << (capacity * 8ULL + num * 8ULL) / (1024 * 1024) << " MiB of cells and elements"
+             << (table.usesHugePages() ? ", on huge pages" : "") << ")" << endl;
+        releaseTable(elementsBlock);
+    }
+
+    cout << "********** End of huge pages benchmark **********" << endl;
+    cout << endl;
+}
+
+unsigned int slowOperationCount = 0;
+unsigned int longestSlowProbe = 0;
+
+// Description: Slow operation hook of benchLatencyTracking( ): counts the slow operations.
+void countSlowOperation(const LatencyTracker::SlowOperation &slow)
+{
+    slowOperationCount++;
+    longestSlowProbe = max(longestSlowProbe, slow.probeLength);
+}
+
+// Description: trySearch( ) on a List of num members (half of the phones searched are absent),
+//              without then with latency tracking, to measure its overhead.
+//              Prints the percentiles it collected and the slow operations (10 us or more) reported.
+void benchLatencyTracking(unsigned int num, unsigned int lookups)
+{
+    cout << "********** Latency tracking overhead: trySearch **********" << endl;
+
+    vector<string> phones = randomPhones(2 * num, 20);
+    List table(hashPhone, 2 * num);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        table.insert(*new Member("Member", phones[i], "member@gmail.com", "0000000000000"));
+    }
+    vector<Member> probes;
+    probes.reserve(lookups);
+    srand(21);
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        probes.push_back(Member(phones[((unsigned int)rand() << 15 ^ (unsigned int)rand()) % (2 * num)]));
+    }
+
+    for (unsigned int tracked = 0; tracked < 2; tracked++)
+    {
+        if (tracked)
+        {
+            table.setSlowOperationHook(10000, countSlowOperation);
+        }
+        unsigned int hits = 0;
+        Clock::time_point start = Clock::now();
+        for (unsigned int i = 0; i < lookups; i++)
+        {
+            Member *found = nullptr;
+            hits += table.trySearch(probes[i], found) == ErrorCode::OK;
+        }
+        double seconds = chrono::duration<double>(Clock::now() - start).count();
+        cout << (tracked ? "tracked:   " : "untracked: ") << seconds * 1e9 / lookups << " ns/lookup (" << hits << " hits)" << endl;
+    }
+    table.printLatency(cout);
+    cout << slowOperationCount << " slow operations (longest probe sequence: " << longestSlowProbe << " cells)" << endl;
+
+    cout << "********** End of latency tracking benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Lookups (all hits) in a List of num members at load 1/2 and 9/10, then in its frozen copy.
+//              Prints the lookup time and the bits per member of each index: the cells, bitmap and
+//              collision counts of the hashTable, the perfect hash function of the FrozenList.
+void benchFrozenList(unsigned int num, unsigned int lookups)
+{
+    cout << "********** Frozen (perfect hash) versus open addressing lookups **********" << endl;
+
+    vector<string> phones = randomPhones(num, 22);
+    vector<Member> probes;
+    probes.reserve(lookups);
+    srand(23);
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        probes.push_back(Member(phones[((unsigned int)rand() << 15 ^ (unsigned int)rand()) % num]));
+    }
+
+    double loads[2] = {0.5, 0.9};
+    for (unsigned int l = 0; l < 2; l++)
+    {
+        List table(hashPhone, (unsigned int)(num / loads[l]));
+        for (unsigned int i = 0; i < num; i++)
+        {
+            table.insert(*new Member("Member", phones[i], "member@gmail.com", "0000000000000"));
+        }
+
+        unsigned int hits = 0;
+        Clock::time_point start = Clock::now();
+        for (unsigned int i = 0; i < lookups; i++)
+        {
+            Member *found = nullptr;
+            hits += table.trySearch(probes[i], found) == ErrorCode::OK;
+        }
+        double seconds = chrono::duration<double>(Clock::now() - start).count();
+        cout << "List, load " << loads[l] << ":  " << seconds * 1e9 / lookups << " ns/lookup (" << hits << " hits), "
+             << table.getTableMemoryUsage() * 8.0 / num << " bits per member" << endl;
+
+        if (l == 1)
+        {
+            start = Clock::now();
+            FrozenList *frozen = table.freeze();
+            double buildSeconds = chrono::duration<double>(Clock::now() - start).count();
+
+            hits = 0;
+            start = Clock::now();
+            for (unsigned int i = 0; i < lookups; i++)
+            {
+                const Member *found = nullptr;
+                hits += frozen->trySearch(probes[i], found) == ErrorCode::OK;
+            }
+            seconds = chrono::duration<double>(Clock::now() - start).count();
+            cout << "FrozenList:     " << seconds * 1e9 / lookups << " ns/lookup (" << hits << " hits), "
+                 << frozen->getIndexBitsPerKey() << " bits per member, frozen in " << buildSeconds * 1000 << " ms" << endl;
+            delete frozen;
+        }
+    }
+
+    cout << "********** End of frozen list benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Tokenizes num random 13-digit card numbers (as randomCardGenerator( ) of the test driver)
+//              into an empty vault, tokenizes them again (all known), then detokenizes them in random order.
+void benchCardVault(unsigned int num)
+{
+    cout << "********** Card vault: tokenize / detokenize throughput **********" << endl;
+    cout << "sizeof(Member): " << sizeof(Member) << " bytes (card token: " << sizeof(unsigned long long)
+         << " bytes of the member's cold record, card string: " << sizeof(string) << " bytes)" << endl;
+
+    vector<string> cards(num);
+    srand(24);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        for (unsigned int d = 0; d < 13; d++)
+        {
+            cards[i] += (char)('0' + rand() % 10);
+        }
+    }
+
+    CardVault vault(0x0123456789abcdefULL, 0xfedcba9876543210ULL);
+    vector<unsigned long long> tokens(num);
+    for (unsigned int pass = 0; pass < 2; pass++)
+    {
+        Clock::time_point start = Clock::now();
+        for (unsigned int i = 0; i < num; i++)
+        {
+            tokens[i] = vault.tokenize(cards[i]);
+        }
+        double seconds = chrono::duration<double>(Clock::now() - start).count();
+        cout << (pass == 0 ? "tokenize (new cards):   " : "tokenize (known cards): ") << seconds * 1e9 / num << " ns/card, "
+             << num / seconds / 1e6 << " M cards/s" << endl;
+    }
+
+    vector<unsigned int> order(num);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        order[i] = ((unsigned int)rand() << 15 ^ (unsigned int)rand()) % num;
+    }
+    unsigned int matches = 0;
+    Clock::time_point start = Clock::now();
+    for (unsigned int i = 0; i < num; i++)
+    {
+        matches += vault.detokenize(tokens[order[i]]).size() == 13;
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+    cout << "detokenize:             " << seconds * 1e9 / num << " ns/card, " << num / seconds / 1e6 << " M cards/s ("
+         << matches << " cards, " << vault.getCardCount() << " in the vault, "
+         << vault.getMemoryUsage() / (1024 * 1024) << " MiB)" << endl;
+
+    cout << "********** End of card vault benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Readers search a VersionedList of num members while it is reloaded (a new generation of
+//              num members built in the background, then published) "reloads" times.
+//              Checks that every snapshot holds a complete generation; prints the read throughput
+//              and the generations still waiting for their readers at the end.
+void benchVersionedReload(unsigned int num, unsigned int reloads)
+{
+    cout << "********** Versioned List: reads during background reloads **********" << endl;
+
+    vector<string> phones = randomPhones(num, 25);
+    VersionedList::Loader load = [&phones](List &list)
+    {
+        for (unsigned int i = 0; i < phones.size(); i++)
+        {
+            list.insert(*new Member("Member", phones[i], "member@gmail.com", "0000000000000"));
+        }
+    };
+    VersionedList versioned(hashPhone, 2 * num);
+    versioned.reload(load, 2 * num);
+
+    atomic<bool> stop(false);
+    atomic<unsigned long long> reads(0), partialViews(0), generationsSeen(0);
+    vector<thread> readers;
+    for (unsigned int r = 0; r < 2; r++)
+    {
+        readers.emplace_back([&, r]()
+                             {
+                                 unsigned long long done = 0, lastGeneration = 0;
+                                 for (unsigned int i = r; !stop; i += 7919)
+                                 {
+                                     VersionedList::Snapshot view = versioned.snapshot();
+                                     Member *found = nullptr;
+                                     if (view->getElementCount() != num ||
+                                         view->trySearch(Member(phones[i % num]), found) != ErrorCode::OK)
+                                     {
+                                         partialViews++;
+                                     }
+                                     if (view.getGenerationNumber() != lastGeneration)
+                                     {
+                                         lastGeneration = view.getGenerationNumber();
+                                         generationsSeen++;
+                                     }
+                                     done++;
+                                 }
+                                 reads += done; });
+    }
+
+    Clock::time_point start = Clock::now();
+    for (unsigned int i = 0; i < reloads; i++)
+    {
+        versioned.reloadInBackground(load, 2 * num);
+        versioned.waitForReload();
+    }
+    stop = true;
+    for (unsigned int r = 0; r < readers.size(); r++)
+    {
+        readers[r].join();
+    }
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+
+    cout << reloads << " reloads of " << num << " members in " << seconds * 1000 << " ms; " << reads << " reads ("
+         << reads / seconds / 1e6 << " M reads/s), " << generationsSeen << " generation changes seen, "
+         << partialViews << " partial views" << endl;
+    cout << "Generation " << versioned.getGenerationNumber() << " current, " << versioned.reclaim()
+         << " old generations waiting for readers" << endl;
+
+    cout << "********** End of versioned List benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Checks CuckooList: num members inserted into a table sized for 16 (so that it is rebuilt,
+//              and evictions fail and are undone, many times) must all be found afterwards, and a member
+//              whose phone is invalid must be rejected.
+void checkCuckooList(unsigned int num)
+{
+    cout << "********** CuckooList: inserts through forced rehashes **********" << endl;
+
+    vector<string> phones = randomPhones(num, 32);
+    CuckooList table(16);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        table.insert(*new Member("Member", phones[i], "", ""));
+    }
+    unsigned int found = 0;
+    for (unsigned int i = 0; i < num; i++)
+    {
+        Member target(phones[i]);
+        found += table.search(target)->getPhone() == phones[i];
+    }
+    check(table.getRehashCount() > 0 && table.getElementCount() == num && found == num,
+          "every member is found after " + to_string(table.getRehashCount()) + " rehashes (" + to_string(found) +
+              " of " + to_string(num) + ")");
+
+    Member *invalid = new Member("Member", "not a phone", "", "");
+    bool rejected = false;
+    try
+    {
+        table.insert(*invalid);
+    }
+    catch (UnableToInsertException &e)
+    {
+        rejected = e.getCode() == ErrorCode::INVALID_KEY;
+    }
+    delete invalid;
+    check(rejected && table.getElementCount() == num, "a member with an invalid phone is rejected (ErrorCode::INVALID_KEY)");
+
+    cout << "********** End of CuckooList check **********" << endl;
+    cout << endl;
+}
+
+// Description: Checks the reclamation of VersionedList: a reader thread holds a Snapshot of a generation
+//              of num members while the main thread replaces it with reload( ), then update( ).
+//              The old generation must stay whole and readable through the Snapshot, both replaced
+//              generations must wait for it, and reclaim( ) must reach 0 once it is released.
+//              Then a background reload fails: waitForReload( ) must pass its exception on.
+void checkVersionedReclamation(unsigned int num)
+{
+    cout << "********** Versioned List: reclamation with a Snapshot held **********" << endl;
+
+    vector<string> phones = randomPhones(num, 31);
+    auto loader = [&phones](const string &email)
+    {
+        return [&phones, email](List &list)
+        {
+            for (unsigned int i = 0; i < phones.size(); i++)
+            {
+                list.insert(*new Member("Member", phones[i], email, ""));
+            }
+        };
+    };
+    VersionedList versioned(hashPhone, 2 * num);
+    versioned.reload(loader("old@gmail.com"), 2 * num);
+    unsigned long long oldGeneration = versioned.getGenerationNumber();
+
+    atomic<bool> holding(false), replaced(false);
+    bool oldReadable = false, sameGeneration = false;
+    thread reader([&]()
+                  {
+                      VersionedList::Snapshot view = versioned.snapshot();
+                      holding = true;
+                      while (!replaced)
+                      {
+                          this_thread::yield();
+                      }
+                      unsigned int found = 0;
+                      for (unsigned int i = 0; i < num; i++)
+                      {
+                          Member *member = nullptr;
+                          Member target(phones[i]);
+                          found += view->trySearch(target, member) == ErrorCode::OK && member->getEmail() == "old@gmail.com";
+                      }
+                      oldReadable = view->getElementCount() == num && found == num;
+                      sameGeneration = view.getGenerationNumber() == oldGeneration; });
+    while (!holding)
+    {
+        this_thread::yield();
+    }
+
+    versioned.reload(loader("new@gmail.com"), 2 * num);
+    string removed = phones[0];
+    versioned.update([&removed](List &list)
+                     {
+                         Member target(removed);
+                         list.remove(target);
+                     });
+    unsigned int waitingWhileHeld = versioned.reclaim();
+    replaced = true;
+    reader.join();
+    unsigned int waitingAfterRelease = versioned.reclaim();
+
+    VersionedList::Snapshot latest = versioned.snapshot();
+    check(oldReadable && sameGeneration, "the held generation stays whole and readable after reload( ) and update( )");
+    check(waitingWhileHeld == 2, "both replaced generations wait for the held Snapshot (" + to_string(waitingWhileHeld) + " waiting)");
+    check(waitingAfterRelease == 0, "reclaim( ) deletes them once it is released (" + to_string(waitingAfterRelease) + " waiting)");
+    check(latest.getGenerationNumber() == oldGeneration + 2 && latest->getElementCount() == num - 1,
+          "the current generation has the update");
+
+    versioned.reloadInBackground([](List &)
+                                 { throw UnableToOpenFileException(); },
+                                 2 * num);
+    bool passedOn = false;
+    try
+    {
+        versioned.waitForReload();
+    }
+    catch (UnableToOpenFileException &)
+    {
+        passedOn = true;
+    }
+    versioned.waitForReload(); // the exception is passed on once
+    check(passedOn && versioned.getGenerationNumber() == oldGeneration + 2,
+          "a failed background reload publishes nothing and waitForReload( ) passes its exception on");
+
+    cout << "********** End of versioned List reclamation check **********" << endl;
+    cout << endl;
+}
+
+// Reference model of a List in the checks: the name and email of the member stored under each packed phone.
+struct ReferenceMember
+{
+    string name;
+    string email;
+};
+typedef map<unsigned long long, ReferenceMember> ReferenceList;
+
+// Description: Returns a name for the members of the checks: one of 50, in upper or lower case, or none.
+string randomName()
+{
+    unsigned int choice = rand() % 101;
+    if (choice == 100)
+    {
+        return "";
+    }
+    return ((choice & 1) ? "MEMBER " : "member ") + to_string(choice / 2);
+}
+
+// Description: Applies "operations" random inserts (tryInsert( )), removes (tryRemove( )), setName( ) and
+//              setEmail( ) calls to table and to reference alike, on phones drawn from phones. Emails are
+//              distinct, or empty. Returns the number of operations whose outcome the reference did not expect.
+unsigned int churnAgainstReference(List &table, ReferenceList &reference, const vector<string> &phones,
+                                   unsigned int operations)
+{
+    unsigned int mismatches = 0;
+    for (unsigned int op = 0; op < operations; op++)
+    {
+        const string &phone = phones[((unsigned int)rand() << 15 ^ (unsigned int)rand()) % phones.size()];
+        unsigned long long key = packPhone(phone);
+        bool present = reference.count(key) != 0;
+        unsigned int kind = rand() % 10;
+        if (kind < 4)
+        {
+            string email = (rand() % 3 == 0) ? "" : "member" + to_string(key) + "." + to_string(op) + "@gmail.com";
+            Member *newMember = new Member(randomName(), phone, email, "");
+            string name = newMember->getName();
+            ErrorCode code = table.tryInsert(*newMember);
+            mismatches += code != (present ? ErrorCode::ELEMENT_ALREADY_EXISTS : ErrorCode::OK);
+            if (code == ErrorCode::OK)
+            {
+                reference[key] = ReferenceMember{name, email};
+            }
+            else
+            {
+                delete newMember;
+            }
+        }
+        else if (kind < 8)
+        {
+            Member target(phone);
+            ErrorCode code = table.tryRemove(target);
+            mismatches += code != (present ? ErrorCode::OK
+                                           : (reference.empty() ? ErrorCode::EMPTY_DATA_COLLECTION : ErrorCode::ELEMENT_DOES_NOT_EXIST));
+            reference.erase(key);
+        }
+        else if (present)
+        {
+            Member target(phone);
+            Member *stored = table.search(target);
+            if (kind == 8)
+            {
+                string name = randomName();
+                table.setName(*stored, name);
+                reference[key].name = name;
+            }
+            else
+            {
+                string email = (rand() % 3 == 0) ? "" : "renamed" + to_string(key) + "." + to_string(op) + "@gmail.com";
+                table.setEmail(*stored, email);
+                reference[key].email = email;
+            }
+        }
+    }
+    return mismatches;
+}
+
+// Description: Checks the basic operations of List against a reference (std::map) through enough removes
+//              to leave tombstones and compact the table, with the filter enabled: the outcome of each
+//              operation, search( ) of every phone (no false negative from the filter, no false positive),
+//              iteration, searchMany( ) and InterleavedSearch.
+void checkListOperations(unsigned int num)
+{
+    cout << "********** List: operations against a reference **********" << endl;
+
+    srand(44);
+    vector<string> phones = randomPhones(num, 45);
+    List table(hashPhone, num);
+    table.enableFilter();
+    ReferenceList reference;
+    unsigned int mismatches = churnAgainstReference(table, reference, phones, 16 * num);
+    check(mismatches == 0, "the outcome of " + to_string(16 * num) + " inserts, removes and updates matches the reference (" +
+                               to_string(mismatches) + " mismatches)");
+    check(table.getCompactionCount() > 0, "removes left tombstones and the table was compacted (" +
+                                              to_string(table.getCompactionCount()) + " compactions, " +
+                                              to_string(table.getTombstoneCount()) + " tombstones now)");
+    check(table.getElementCount() == reference.size(), "the element count matches the reference (" +
+                                                           to_string(table.getElementCount()) + " elements)");
+
+    unsigned int wrongSearches = 0;
+    for (unsigned int i = 0; i < num; i++)
+    {
+        Member target(phones[i]);
+        Member *found = nullptr;
+        ErrorCode code = table.trySearch(target, found);
+        ReferenceList::const_iterator expected = reference.find(target.getPhoneKey());
+        if (expected == reference.end())
+        {
+            wrongSearches += code == ErrorCode::OK;
+        }
+        else
+        {
+            wrongSearches += code != ErrorCode::OK || found->getPhoneKey() != expected->first ||
+                             found->getName() != expected->second.name || found->getEmail() != expected->second.email;
+        }
+    }
+    check(wrongSearches == 0, "search( ) of every phone matches the reference, filter enabled (" +
+                                  to_string(wrongSearches) + " wrong)");
+
+    vector<unsigned long long> iterated;
+    for (List::const_iterator it = table.begin(); it != table.end(); ++it)
+    {
+        iterated.push_back(it->getPhoneKey());
+    }
+    sort(iterated.begin(), iterated.end());
+    vector<unsigned long long> expectedKeys;
+    for (const ReferenceList::value_type &entry : reference)
+    {
+        expectedKeys.push_back(entry.first);
+    }
+    check(iterated == expectedKeys, "iteration visits every stored element once (" + to_string(iterated.size()) + " visited)");
+
+    vector<Member *> batch(num), interleaved(num);
+    table.searchMany(phones.data(), batch.data(), num);
+    InterleavedSearch scheduler(table, 8);
+    scheduler.searchAll(phones.data(), interleaved.data(), num);
+    unsigned int wrongBatch = 0, wrongInterleaved = 0;
+    for (unsigned int i = 0; i < num; i++)
+    {
+        bool stored = reference.count(packPhone(phones[i])) != 0;
+        wrongBatch += stored ? (batch[i] == nullptr || batch[i]->getPhone() != phones[i]) : batch[i] != nullptr;
+        wrongInterleaved += interleaved[i] != batch[i];
+    }
+    check(wrongBatch == 0, "searchMany( ) matches the reference (" + to_string(wrongBatch) + " wrong)");
+    check(wrongInterleaved == 0, "InterleavedSearch finds what searchMany( ) finds (" + to_string(wrongInterleaved) + " wrong)");
+
+    Member invalid("Member", "not a phone", "", "");
+    ErrorCode invalidCode = ErrorCode::OK;
+    try
+    {
+        table.insert(invalid);
+    }
+    catch (UnableToInsertException &e)
+    {
+        invalidCode = e.getCode();
+    }
+    check(table.tryInsert(invalid) == ErrorCode::INVALID_KEY && invalidCode == ErrorCode::INVALID_KEY,
+          "a member with an invalid phone is rejected with ErrorCode::INVALID_KEY, by insert( ) and tryInsert( )");
+
+    cout << "********** End of List operations check **********" << endl;
+    cout << endl;
+}
+
+// Description: Checks the email and name indexes and the ordered phone index against a reference:
+//              the indexes are enabled halfway through random inserts, removes and updates (so that they are
+//              both built from the table and kept up to date), then every email, every name, random phone
+//              ranges and prefixes are looked up.
+void checkSecondaryIndexes(unsigned int num)
+{
+    cout << "********** List: secondary indexes against a reference **********" << endl;
+
+    srand(46);
+    vector<string> phones = randomPhones(num, 47);
+    List table(hashPhone, num);
+    ReferenceList reference;
+    unsigned int mismatches = churnAgainstReference(table, reference, phones, 4 * num);
+    table.enableEmailIndex();
+    table.enableNameIndex();
+    table.enableOrderedIndex();
+    mismatches += churnAgainstReference(table, reference, phones, 4 * num);
+    check(mismatches == 0, "the outcome of every operation matches the reference (" + to_string(mismatches) + " mismatches)");
+
+    unsigned int wrongEmails = 0;
+    multimap<string, unsigned long long> byName;
+    for (const ReferenceList::value_type &entry : reference)
+    {
+        if (!entry.second.email.empty())
+        {
+            wrongEmails += table.searchByEmail(entry.second.email)->getPhoneKey() != entry.first;
+        }
+        if (!entry.second.name.empty())
+        {
+            byName.insert(make_pair(foldCase(entry.second.name), entry.first));
+        }
+    }
+    check(wrongEmails == 0, "searchByEmail( ) finds the owner of every email (" + to_string(wrongEmails) + " wrong)");
+
+    unsigned int wrongNames = 0;
+    for (unsigned int i = 0; i < 50; i++)
+    {
+        string name = ((i & 1) ? "Member " : "MEMBER ") + to_string(i);
+        vector<unsigned long long> found, expected;
+        for (Member *member : table.searchByName(name))
+        {
+            found.push_back(member->getPhoneKey());
+        }
+        for (multimap<string, unsigned long long>::const_iterator it = byName.lower_bound(foldCase(name));
+             it != byName.upper_bound(foldCase(name)); ++it)
+        {
+            expected.push_back(it->second);
+        }
+        sort(found.begin(), found.end());
+        sort(expected.begin(), expected.end());
+        wrongNames += found != expected;
+    }
+    check(wrongNames == 0 && table.searchByName("").empty(),
+          "searchByName( ) returns exactly the members of each name, ignoring case (" + to_string(wrongNames) + " of 50 wrong)");
+
+    unsigned int wrongRanges = 0;
+    for (unsigned int i = 0; i < 200; i++)
+    {
+        unsigned long long low = packPhone(phones[rand() % num]);
+        unsigned long long high = min(low + (unsigned long long)rand() % 100000000ULL, 9999999999ULL);
+        PhoneIndex::Range range = table.searchByPhoneRange(formatPhone(low), formatPhone(high));
+        ReferenceList::const_iterator expected = reference.lower_bound(low);
+        for (const PhoneIndex::Entry &entry : range)
+        {
+            wrongRanges += expected == reference.end() || entry.key != expected->first || entry.element->getPhoneKey() != entry.key;
+            if (expected != reference.end())
+            {
+                ++expected;
+            }
+        }
+        wrongRanges += expected != reference.upper_bound(high);
+    }
+    check(wrongRanges == 0, "200 phone ranges return exactly the stored phones in them, in order (" + to_string(wrongRanges) + " wrong)");
+
+    unsigned int wrongPrefixes = 0;
+    for (unsigned int i = 0; i < 200; i++)
+    {
+        string prefix = phones[rand() % num].substr(0, (i & 1) ? 3 : 6); // "604" or "604-85"
+        unsigned long long low = 0, scale = 10000000000ULL;
+        for (char c : prefix)
+        {
+            if (c != '-')
+            {
+                low = low * 10 + (c - '0');
+                scale /= 10;
+            }
+        }
+        low *= scale;
+        unsigned long long high = low + scale - 1;
+        PhoneIndex::Range range = table.searchByPhonePrefix(prefix);
+        unsigned int expected = (unsigned int)distance(reference.lower_bound(low), reference.upper_bound(high));
+        wrongPrefixes += range.size() != expected || (range.size() > 0 && (range.first->key < low || (range.last - 1)->key > high));
+    }
+    check(wrongPrefixes == 0, "200 phone prefixes return exactly the stored phones starting with them (" +
+                                  to_string(wrongPrefixes) + " wrong)");
+
+    string takenEmail;
+    vector<string> unusedPhones;
+    for (const ReferenceList::value_type &entry : reference)
+    {
+        takenEmail = entry.second.email.empty() ? takenEmail : entry.second.email;
+    }
+    for (unsigned long long key = 6048531423ULL; unusedPhones.size() < 3; key++)
+    {
+        if (reference.count(key) == 0)
+        {
+            unusedPhones.push_back(formatPhone(key));
+        }
+    }
+    Member duplicate("Member", unusedPhones[0], takenEmail, "");
+    bool duplicateRejected = table.tryInsert(duplicate) == ErrorCode::ELEMENT_ALREADY_EXISTS;
+    unsigned int withoutEmail = 0;
+    for (unsigned int i = 1; i < 3; i++)
+    {
+        withoutEmail += table.tryInsert(*new Member("Member", unusedPhones[i], "", "")) == ErrorCode::OK;
+    }
+    check(duplicateRejected && withoutEmail == 2, "a taken email is rejected, and any number of members may have no email");
+
+    cout << "********** End of secondary indexes check **********" << endl;
+    cout << endl;
+}
+
+// Description: Checks that the frozen copy of a List of num members (with names and emails) finds every
+//              member with its fields, finds no other phone, and holds nothing else.
+void checkFrozenList(unsigned int num)
+{
+    cout << "********** FrozenList: every member found **********" << endl;
+
+    srand(48);
+    vector<string> phones = randomPhones(2 * num, 49);
+    List table(hashPhone, 2 * num);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        table.insert(*new Member(randomName(), phones[i], "member" + to_string(i) + "@gmail.com", ""));
+    }
+    FrozenList *frozen = table.freeze();
+
+    unsigned int wrong = 0;
+    for (unsigned int i = 0; i < 2 * num; i++)
+    {
+        Member target(phones[i]);
+        const Member *found = frozen->find(phones[i]);
+        if (i < num)
+        {
+            Member *stored = table.search(target);
+            wrong += found == nullptr || found->getPhoneKey() != target.getPhoneKey() || found->getName() != stored->getName() ||
+                     found->getEmail() != stored->getEmail();
+        }
+        else
+        {
+            wrong += found != nullptr;
+        }
+    }
+    unsigned int visited = 0;
+    for (const Member *member = frozen->begin(); member != frozen->end(); ++member)
+    {
+        Member target(member->getPhone());
+        Member *stored = nullptr;
+        visited += table.trySearch(target, stored) == ErrorCode::OK;
+    }
+    check(wrong == 0, "the frozen copy finds all " + to_string(num) + " members and none of " + to_string(num) +
+                          " other phones (" + to_string(wrong) + " wrong)");
+    check(frozen->getElementCount() == num && visited == num, "the frozen copy holds the members of the List and nothing else");
+    delete frozen;
+
+    cout << "********** End of FrozenList check **********" << endl;
+    cout << endl;
+}
+
+// Description: Checks that num random card numbers (with repeats) come back from their tokens, that a card
+//              always gets the same token and distinct cards distinct tokens, and that a member's card
+//              round-trips through CardVault::global( ) and is masked as documented.
+void checkCardVault(unsigned int num)
+{
+    cout << "********** Card vault: tokenize / detokenize round trip **********" << endl;
+
+    srand(50);
+    CardVault vault(0x0123456789abcdefULL, 0xfedcba9876543210ULL);
+    map<string, unsigned long long> tokenOf;
+    map<unsigned long long, string> cardOf;
+    unsigned int wrong = 0;
+    for (unsigned int i = 0; i < num; i++)
+    {
+        string card;
+        unsigned int digits = 13 + rand() % 4;
+        for (unsigned int d = 0; d < digits; d++)
+        {
+            card += (char)('0' + rand() % ((i & 1) ? 2 : 10)); // odd i: few distinct cards, so repeats
+        }
+        unsigned long long token = vault.tokenize(card);
+        map<string, unsigned long long>::const_iterator known = tokenOf.find(card);
+        wrong += token == 0 || (known != tokenOf.end() && known->second != token) ||
+                 (known == tokenOf.end() && cardOf.count(token) != 0);
+        tokenOf[card] = token;
+        cardOf[token] = card;
+    }
+    for (const map<unsigned long long, string>::value_type &entry : cardOf)
+    {
+        wrong += vault.detokenize(entry.first) != entry.second;
+    }
+    bool unknownRejected = false;
+    try
+    {
+        vault.detokenize(cardOf.rbegin()->first + 1);
+    }
+    catch (ElementDoesNotExistException &)
+    {
+        unknownRejected = true;
+    }
+    check(wrong == 0 && vault.getCardCount() == tokenOf.size(),
+          to_string(tokenOf.size()) + " distinct cards round-trip through their tokens (" + to_string(wrong) + " wrong)");
+    check(vault.tokenize("") == 0 && vault.detokenize(0) == "" && unknownRejected,
+          "no card is token 0, and a token not issued is rejected");
+
+    Member member("Zoey Combs", "604-853-1423", "zoey@gmail.com", "1234567890123");
+    check(member.getCreditCard() == "1234567890123" && member.getMaskedCreditCard() == "*********0123",
+          "a member's card round-trips through the global vault and is masked to its last 4 digits");
+
+    cout << "********** End of card vault check **********" << endl;
+    cout << endl;
+}
+
+// Description: Checks the phone normalizer against a table of accepted and rejected inputs, and the batch
+//              mode (normalizePhones( )) against the single one.
+void checkPhoneNormalizer()
+{
+    cout << "********** Phone normalization: accepted and rejected formats **********" << endl;
+
+    const string accepted[] = {"604-853-1423", "604.853.1423", "604 853 1423", "6048531423", "(604) 853-1423",
+                               "(604)853-1423", "+1 604 853 1423", "+1-604-853-1423", "+1 (604) 853-1423",
+                               "1-604-853-1423", "16048531423", "+16048531423", "  604-853-1423  ", "\t(604) 853-1423\n"};
+    const string rejected[] = {"", "   ", "604-853-142", "604-853-14234", "604--853-1423", "604 - 853-1423",
+                               "+604 853 1423", "+ 1 604 853 1423", "2-604-853-1423", "26048531423", "(604 853-1423",
+                               "604) 853-1423", "-604-853-1423", "604-853-1423-", "604-853-1423x", "abc-def-ghij",
+                               "000-000-0000"};
+    vector<string> inputs;
+    vector<unsigned long long> expected;
+    unsigned int wrong = 0;
+    for (const string &phone : accepted)
+    {
+        unsigned long long key = 0;
+        wrong += !normalizePhone(phone, key) || key != 6048531423ULL || canonicalPhone(phone) != "604-853-1423";
+        inputs.push_back(phone);
+        expected.push_back(6048531423ULL);
+    }
+    for (const string &phone : rejected)
+    {
+        unsigned long long key = 1;
+        bool isValid = normalizePhone(phone, key);
+        if (isValid || key != INVALID_PHONE_KEY || canonicalPhone(phone) != INVALID_PHONE)
+        {
+            cout << "accepted: \"" << phone << "\"" << endl;
+            wrong++;
+        }
+        inputs.push_back(phone);
+        expected.push_back(INVALID_PHONE_KEY);
+    }
+    check(wrong == 0, to_string(sizeof(accepted) / sizeof(accepted[0])) + " formats accepted, " +
+                          to_string(sizeof(rejected) / sizeof(rejected[0])) + " inputs rejected (" + to_string(wrong) + " wrong)");
+
+    vector<unsigned long long> keys(inputs.size());
+    unsigned int valid = normalizePhones(inputs.data(), keys.data(), (unsigned int)inputs.size());
+    check(keys == expected && valid == sizeof(accepted) / sizeof(accepted[0]), "normalizePhones( ) agrees with normalizePhone( )");
+
+    cout << "********** End of phone normalization check **********" << endl;
+    cout << endl;
+}
+
+// Description: Checks that the cold fields of a member (name, email, card) survive copy and move construction
+//              and assignment, that copies are independent, and that every cold record is released.
+void checkColdFields()
+{
+    cout << "********** Hot/cold members: cold fields through copies and moves **********" << endl;
+
+    unsigned int recordsBefore = MemberColdArena::global().getRecordCount();
+    {
+        auto holds = [](const Member &member, const string &name)
+        {
+            return member.getPhone() == "604-853-1423" && member.getName() == name && member.getEmail() == "zoey@gmail.com" &&
+                   member.getCreditCard() == "1234567890123";
+        };
+        Member original("Zoey Combs", "604-853-1423", "zoey@gmail.com", "1234567890123");
+        Member copy(original);
+        copy.setName("Ann Lee");
+        check(holds(original, "Zoey Combs") && holds(copy, "Ann Lee"), "a copy has the fields of the original, and its own");
+
+        Member moved(std::move(copy));
+        check(holds(moved, "Ann Lee") && copy.getName() == "" && copy.getEmail() == "" && copy.getCreditCard() == "",
+              "a move takes over the fields, and leaves none behind");
+
+        Member assigned("604-111-2222");
+        assigned = original;
+        Member &self = assigned;
+        assigned = self;
+        Member moveAssigned("Louis Pace", "604-111-3333", "louis@gmail.com", "");
+        moveAssigned = std::move(moved);
+        check(holds(assigned, "Zoey Combs") && holds(moveAssigned, "Ann Lee") && holds(original, "Zoey Combs"),
+              "copy, self and move assignment keep the fields");
+
+        Member empty;
+        assigned = empty;
+        check(assigned.getName() == "" && assigned.getCreditCard() == "" && holds(original, "Zoey Combs"),
+              "assigning a member without cold fields clears them");
+    }
+    unsigned int recordsAfter = MemberColdArena::global().getRecordCount();
+    check(recordsAfter == recordsBefore, "every cold record is released (" + to_string(recordsAfter) + " left, " +
+                                             to_string(recordsBefore) + " before)");
+
+    cout << "********** End of cold fields check **********" << endl;
+    cout << endl;
+}
+
+// Description: Loads num members from the four member files (as written by the test driver, in a
+//              temporary directory) into a List: with the ifstream loop the test driver used to have,
+//              then with MemberIngest through the pread( ) pool and through io_uring.
+//              An untimed load first brings the files into the page cache and the cards into the vault.
+void benchIngest(unsigned int num)
+{
+    cout << "********** Member file ingest: ifstream vs MemberIngest **********" << endl;
+
+    char directory[] = "/tmp/lbdIngestXXXXXX";
+    if (mkdtemp(directory) == nullptr)
+    {
+        cout << "Unable to create a temporary directory" << endl;
+        return;
+    }
+    string files[MemberIngest::FILE_COUNT] = {string(directory) + "/names.txt", string(directory) + "/randomKeys.txt",
+                                              string(directory) + "/randomEmails.txt", string(directory) + "/randomCardNums.txt"};
+    {
+        vector<string> phones = randomPhones(num, 26);
+        ofstream names(files[0]), keys(files[1]), emails(files[2]), cards(files[3]);
+        srand(27);
+        for (unsigned int i = 0; i < num; i++)
+        {
+            names << "First" << i << " Last" << i % 1000 << '\n';
+            keys << phones[i] << '\n';
+            emails << "first" << i << ".last" << i % 1000 << "@gmail.com\n";
+            for (unsigned int d = 0; d < 13; d++)
+            {
+                cards << (char)('0' + rand() % 10);
+            }
+            cards << '\n';
+        }
+    }
+
+    for (unsigned int run = 0; run < 4; run++)
+    {
+        List table(hashPhone, 2 * num);
+        Clock::time_point start = Clock::now();
+        string mode;
+        if (run == 1)
+        {
+            mode = "ifstream:            ";
+            ifstream names(files[0]), keys(files[1]), emails(files[2]), cards(files[3]);
+            string first, last, phone, email, card;
+            while (names >> first >> last && keys >> phone && emails >> email && cards >> card)
+            {
+                table.insert(*new Member(first + " " + last, phone, email, card));
+            }
+        }
+        else
+        {
+            MemberIngest ingest(files[0], files[1], files[2], files[3], run != 2);
+            ingest.loadInto(table);
+            mode = ingest.usesIoUring() ? "MemberIngest io_uring: " : "MemberIngest pread:    ";
+        }
+        double seconds = chrono::duration<double>(Clock::now() - start).count();
+        if (run > 0)
+        {
+            cout << mode << seconds * 1000 << " ms (" << table.getElementCount() << " members, "
+                 << num / seconds / 1e6 << " M members/s)" << endl;
+        }
+    }
+
+    for (unsigned int f = 0; f < MemberIngest::FILE_COUNT; f++)
+    {
+        unlink(files[f].c_str());
+    }
+    rmdir(directory);
+
+    cout << "********** End of ingest benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Checks a binary roster written from source: loading it must give back every member of source
+//              (name, phone, email and credit card), and loading a truncated copy, or a copy with one byte
+//              of a block flipped, must throw UnableToOpenFileException.
+void checkRosterCodec(const List &source, const string &binaryRoster)
+{
+    RosterCodec codec;
+    List loaded(hashPhone, 2 * source.getElementCount());
+    istringstream in(binaryRoster);
+    codec.loadInto(in, loaded);
+    unsigned int equal = 0;
+    for (List::const_iterator it = source.begin(); it != source.end(); ++it)
+    {
+        Member *found = nullptr;
+        if (loaded.trySearch(*it, found) == ErrorCode::OK && found->getName() == it->getName() &&
+            found->getPhone() == it->getPhone() && found->getEmail() == it->getEmail() &&
+            found->getCreditCard() == it->getCreditCard())
+        {
+            equal++;
+        }
+    }
+    check(codec.getLoadedCount() == source.getElementCount() && loaded.getElementCount() == source.getElementCount() &&
+              equal == source.getElementCount(),
+          "the binary roster loads back " + to_string(equal) + " of " + to_string(source.getElementCount()) +
+              " members equal to the source");
+
+    string truncated = binaryRoster.substr(0, binaryRoster.size() / 2);
+    string flipped = binaryRoster;
+    flipped[flipped.size() / 2] ^= 0x10;
+    const string *corrupted[] = {&truncated, &flipped};
+    const char *labels[] = {"truncated", "with a flipped byte"};
+    for (unsigned int c = 0; c < 2; c++)
+    {
+        List target(hashPhone, 2 * source.getElementCount());
+        istringstream corruptedIn(*corrupted[c]);
+        bool thrown = false;
+        try
+        {
+            codec.loadInto(corruptedIn, target);
+        }
+        catch (UnableToOpenFileException &)
+        {
+            thrown = true;
+        }
+        check(thrown, string("a roster ") + labels[c] + " throws UnableToOpenFileException");
+    }
+}
+
+// Description: Writes a List of num members as a text roster (List::exportTo( )) and as a binary roster
+//              (RosterCodec), then loads each back into a List; prints sizes and throughputs.
+//              The text roster is loaded by splitting its lines on ", ", as a client would.
+//              The binary roster is then checked (see checkRosterCodec( )).
+void benchRosterCodec(unsigned int num)
+{
+    cout << "********** Roster export/import: text vs binary (RosterCodec) **********" << endl;
+
+    List source(hashPhone, 2 * num);
+    {
+        vector<string> phones = randomPhones(num, 28);
+        srand(29);
+        for (unsigned int i = 0; i < num; i++)
+        {
+            string first = "First" + to_string(i % 5000), last = "Last" + to_string(i % 997);
+            string card;
+            for (unsigned int d = 0; d < 13; d++)
+            {
+                card += (char)('0' + rand() % 10);
+            }
+            source.insert(*new Member(first + " " + last, phones[i], first + "." + last + "@gmail.com", card));
+        }
+    }
+
+    ostringstream text;
+    Clock::time_point start = Clock::now();
+    source.exportTo(text);
+    double seconds = chrono::duration<double>(Clock::now() - start).count();
+    string textRoster = text.str();
+    cout << "text export:   " << seconds * 1000 << " ms, " << textRoster.size() / (1024.0 * 1024) << " MiB" << endl;
+
+    ostringstream binary;
+    RosterCodec codec;
+    start = Clock::now();
+    codec.writeList(binary, source);
+    seconds = chrono::duration<double>(Clock::now() - start).count();
+    string binaryRoster = binary.str();
+    cout << "binary export: " << seconds * 1000 << " ms, " << binaryRoster.size() / (1024.0 * 1024) << " MiB ("
+         << codec.getRawBytes() / (1024.0 * 1024) << " MiB before zlib), "
+         << (double)textRoster.size() / binaryRoster.size() << "x smaller than text" << endl;
+
+    {
+        List table(hashPhone, 2 * num);
+        start = Clock::now();
+        istringstream in(textRoster);
+        string line;
+        while (getline(in, line))
+        {
+            size_t phone = line.find(", "), email = line.find(", ", phone + 2), card = line.find(", ", email + 2);
+            table.insert(*new Member(line.substr(0, phone), line.substr(phone + 2, email - phone - 2),
+                                     line.substr(email + 2, card - email - 2), line.substr(card + 2)));
+        }
+        seconds = chrono::duration<double>(Clock::now() - start).count();
+        cout << "text import:   " << seconds * 1000 << " ms (" << table.getElementCount() << " members, "
+             << num / seconds / 1e6 << " M members/s)" << endl;
+    }
+    {
+        List table(hashPhone, 2 * num);
+        start = Clock::now();
+        istringstream in(binaryRoster);
+        codec.loadInto(in, table);
+        seconds = chrono::duration<double>(Clock::now() - start).count();
+        cout << "binary import: " << seconds * 1000 << " ms (" << codec.getLoadedCount() << " members, "
+             << num / seconds / 1e6 << " M members/s)" << endl;
+    }
+    checkRosterCodec(source, binaryRoster);
+
+    cout << "********** End of roster codec benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Compares, on a table much larger than the caches, a loop of List::search( ) with
+//              searches interleaved by InterleavedSearch (each suspended at its cache misses) at
+//              several widths, and with searchMany( ) (group prefetching) for reference.
+void benchInterleavedSearch(unsigned int num, unsigned int lookups)
+{
+    cout << "********** Interleaved lookups: search vs InterleavedSearch **********" << endl;
+
+    vector<string> phones = randomPhones(num, 30);
+    vector<Member *> members = makeMembers(phones);
+    List table(hashPhone, 2 * num);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        table.insert(*members[i]);
+    }
+    cout << num << " members (" << (table.getTableMemoryUsage() + num * sizeof(Member)) / (1024 * 1024)
+         << " MiB of cells and members), " << lookups << " lookups" << endl;
+
+    srand(31);
+    vector<string> keys(lookups);
+    vector<Member> probes;
+    probes.reserve(lookups);
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        keys[i] = phones[((unsigned int)rand() << 15 ^ (unsigned int)rand()) % num];
+        probes.push_back(Member(keys[i]));
+    }
+    vector<Member *> results(lookups);
+
+    Clock::time_point start = Clock::now();
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        results[i] = table.search(probes[i]);
+    }
+    double loopSeconds = chrono::duration<double>(Clock::now() - start).count();
+    cout << "search loop              : " << loopSeconds * 1e9 / lookups << " ns/lookup" << endl;
+
+    for (unsigned int width = 2; width <= 64; width *= 2)
+    {
+        InterleavedSearch scheduler(table, width);
+        fill(results.begin(), results.end(), nullptr);
+        start = Clock::now();
+        for (unsigned int i = 0; i < lookups; i++)
+        {
+            scheduler.submit(keys[i], results[i]);
+        }
+        scheduler.drain();
+        double seconds = chrono::duration<double>(Clock::now() - start).count();
+        unsigned int found = count_if(results.begin(), results.end(), [](Member *m) { return m != nullptr; });
+        cout << "interleaved width " << width << (width < 10 ? "      " : "     ") << ": " << seconds * 1e9 / lookups
+             << " ns/lookup (speedup " << loopSeconds / seconds << "x, " << (double)scheduler.getStepCount() / lookups
+             << " steps/lookup, " << found << " found)" << endl;
+    }
+
+    start = Clock::now();
+    for (unsigned int i = 0; i < lookups; i += 64)
+    {
+        table.searchMany(&keys[i], &results[i], (lookups - i < 64) ? lookups - i : 64);
+    }
+    double batchSeconds = chrono::duration<double>(Clock::now() - start).count();
+    cout << "searchMany batch 64      : " << batchSeconds * 1e9 / lookups << " ns/lookup (speedup "
+         << loopSeconds / batchSeconds << "x)" << endl;
+
+    cout << "********** End of interleaved lookups benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Writes canonical phone XXX-XXX-XXXX in one of the formats found in member feeds.
+//              Format 5 drops the last digit: the phone is invalid.
+string phoneInFormat(const string &phone, unsigned int format)
+{
+    string area = phone.substr(0, 3), exchange = phone.substr(4, 3), line = phone.substr(8, 4);
+    switch (format)
+    {
+    case 0:
+        return phone;
+    case 1:
+        return "(" + area + ") " + exchange + "-" + line;
+    case 2:
+        return area + exchange + line;
+    case 3:
+        return "+1 " + area + " " + exchange + " " + line;
+    case 4:
+        return "1-" + phone;
+    default:
+        return phone.substr(0, 11);
+    }
+}
+
+// Description: Measures the throughput of the phone normalizer (normalizePhones( ), batch mode) on each
+//              input format, then on a mix of them, against packPhone( ) (canonical format only, no
+//              validation) and the construction of a search member (Member(string)), which normalizes too.
+void benchPhoneNormalizer(unsigned int num)
+{
+    cout << "********** Phone normalization: input formats **********" << endl;
+
+    const char *formatNames[] = {"XXX-XXX-XXXX   ", "(XXX) XXX-XXXX ", "XXXXXXXXXX     ", "+1 XXX XXX XXXX",
+                                 "1-XXX-XXX-XXXX ", "invalid        "};
+    const unsigned int formatCount = 6;
+    vector<string> canonical = randomPhones(num, 37);
+    vector<unsigned long long> expected(num);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        expected[i] = packPhone(canonical[i]);
+    }
+    vector<unsigned long long> keys(num);
+    cout << num << " phones per run" << endl;
+
+    Clock::time_point start = Clock::now();
+    unsigned long long checksum = 0;
+    for (unsigned int i = 0; i < num; i++)
+    {
+        checksum += packPhone(canonical[i]);
+    }
+    double packSeconds = chrono::duration<double>(Clock::now() - start).count();
+    cout << "packPhone (no validation)      : " << packSeconds * 1e9 / num << " ns/phone, " << num / packSeconds / 1e6
+         << " M phones/s (checksum " << checksum % 1000 << ")" << endl;
+
+    vector<string> phones(num);
+    for (unsigned int format = 0; format <= formatCount; format++)
+    {
+        // format == formatCount: the formats in turn.
+        for (unsigned int i = 0; i < num; i++)
+        {
+            phones[i] = phoneInFormat(canonical[i], format == formatCount ? i % formatCount : format);
+        }
+        start = Clock::now();
+        unsigned int valid = normalizePhones(phones.data(), keys.data(), num);
+        double seconds = chrono::duration<double>(Clock::now() - start).count();
+        unsigned int wrong = 0;
+        for (unsigned int i = 0; i < num; i++)
+        {
+            bool invalid = (format == formatCount ? i % formatCount : format) == formatCount - 1;
+            wrong += keys[i] != (invalid ? INVALID_PHONE_KEY : expected[i]);
+        }
+        cout << "normalizePhones " << (format == formatCount ? "mixed          " : formatNames[format]) << ": "
+             << seconds * 1e9 / num << " ns/phone, " << num / seconds / 1e6 << " M phones/s (" << valid
+             << " valid, " << wrong << " wrong keys)" << endl;
+    }
+
+    // phones holds the mix of formats.
+    start = Clock::now();
+    unsigned int invalidMembers = 0;
+    for (unsigned int i = 0; i < num; i++)
+    {
+        Member probe(phones[i]);
+        invalidMembers += probe.getPhoneKey() == INVALID_PHONE_KEY;
+    }
+    double memberSeconds = chrono::duration<double>(Clock::now() - start).count();
+    cout << "Member(string) mixed           : " << memberSeconds * 1e9 / num << " ns/phone (" << invalidMembers
+         << " invalid)" << endl;
+
+    cout << "********** End of phone normalization benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Measures the lookup path and scans of a List of num members with names and emails, now that
+//              a Member is its packed phone (hot part) and the index of its name, email and card token in
+//              MemberColdArena::global( ) (cold part): searches and searchMany( ) (hot part only), then
+//              scans reading the key, the phone (formatted from the key) and the name (cold record).
+void benchHotColdMembers(unsigned int num, unsigned int lookups)
+{
+    cout << "********** Hot/cold members: lookups and scans **********" << endl;
+
+    vector<string> phones = randomPhones(num, 41);
+    unsigned int coldRecordsBefore = MemberColdArena::global().getRecordCount();
+    List table(hashPhone, 2 * num);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        table.insert(*new Member("Member " + to_string(i), phones[i], "member" + to_string(i) + "@gmail.com", ""));
+    }
+    cout << num << " members: " << sizeof(Member) << " bytes of hot part each (was 3 strings and a token), "
+         << MemberColdArena::global().getRecordCount() - coldRecordsBefore << " cold records of "
+         << sizeof(MemberColdArena::Record) << " bytes (" << MemberColdArena::global().getMemoryUsage() / (1024 * 1024)
+         << " MiB of arena)" << endl;
+
+    srand(43);
+    vector<string> keys(lookups);
+    vector<Member> probes;
+    probes.reserve(lookups);
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        keys[i] = phones[((unsigned int)rand() << 15 ^ (unsigned int)rand()) % num];
+        probes.push_back(Member(keys[i]));
+    }
+
+    Clock::time_point start = Clock::now();
+    unsigned int found = 0;
+    for (unsigned int i = 0; i < lookups; i++)
+    {
+        found += table.search(probes[i]) != nullptr;
+    }
+    double searchSeconds = chrono::duration<double>(Clock::now() - start).count();
+    cout << "search            : " << searchSeconds * 1e9 / lookups << " ns/lookup (" << found << " found)" << endl;
+
+    vector<Member *> results(lookups);
+    start = Clock::now();
+    for (unsigned int i = 0; i < lookups; i += 64)
+    {
+        table.searchMany(&keys[i], &results[i], (lookups - i < 64) ? lookups - i : 64);
+    }
+    double batchSeconds = chrono::duration<double>(Clock::now() - start).count();
+    cout << "searchMany (64)   : " << batchSeconds * 1e9 / lookups << " ns/lookup" << endl;
+
+    unsigned long long checksum = 0;
+    start = Clock::now();
+    for (List::const_iterator it = table.begin(); it != table.end(); ++it)
+    {
+        checksum += it->getPhoneKey();
+    }
+    double keySeconds = chrono::duration<double>(Clock::now() - start).count();
+    start = Clock::now();
+    for (List::const_iterator it = table.begin(); it != table.end(); ++it)
+    {
+        checksum += it->getPhone()[11];
+    }
+    double phoneSeconds = chrono::duration<double>(Clock::now() - start).count();
+    start = Clock::now();
+    for (List::const_iterator it = table.begin(); it != table.end(); ++it)
+    {
+        checksum += it->getName().size();
+    }
+    double nameSeconds = chrono::duration<double>(Clock::now() - start).count();
+    cout << "scan, phone key   : " << keySeconds * 1e9 / num << " ns/member (hot part)" << endl;
+    cout << "scan, getPhone( ) : " << phoneSeconds * 1e9 / num << " ns/member (hot part, formatted)" << endl;
+    cout << "scan, getName( )  : " << nameSeconds * 1e9 / num << " ns/member (cold record, checksum "
+         << checksum % 1000 << ")" << endl;
+
+    cout << "********** End of hot/cold members benchmark **********" << endl;
+    cout << endl;
+}
+
+// Description: Measures members with a cold record created and destroyed by 1, 2 and 4 threads at once
+//              (as by the shard workers of ShardedList or the lookup server): num members in all, each
+//              thread creating its share, then destroying them. The allocations and releases of cold
+//              records come from per-thread caches, so they should scale with the cores.
+void benchColdArenaThreads(unsigned int num)
+{
+    cout << "********** Hot/cold members: cold records from several threads **********" << endl;
+    cout << thread::hardware_concurrency() << " cores" << endl;
+
+    const unsigned int threadCounts[] = {1, 2, 4};
+    for (unsigned int threadCount : threadCounts)
+    {
+        unsigned int share = num / threadCount;
+        vector<thread> threads;
+        Clock::time_point start = Clock::now();
+        for (unsigned int t = 0; t < threadCount; t++)
+        {
+            threads.emplace_back([share, t]()
+                                 {
+                                     vector<Member *> members(share);
+                                     for (unsigned int i = 0; i < share; i++)
+                                     {
+                                         members[i] = new Member("Member " + to_string(i), "604-853-1423",
+                                                                 "member" + to_string(t) + "@gmail.com", "");
+                                     }
+                                     for (unsigned int i = 0; i < share; i++)
+                                     {
+                                         delete members[i];
+                                     } });
+        }
+        for (unsigned int t = 0; t < threadCount; t++)
+        {
+            threads[t].join();
+        }
+        double seconds = chrono::duration<double>(Clock::now() - start).count();
+        cout << threadCount << " thread" << (threadCount == 1 ? ": " : "s:") << " " << share * threadCount / seconds / 1e6
+             << " M members created and destroyed/s" << endl;
+    }
+    cout << MemberColdArena::global().getRecordCount() << " cold records left" << endl;
+
+    cout << "********** End of cold records benchmark **********" << endl;
+    cout << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1 && string(argv[1]) == "check")
+    {
+        checkListOperations(4000);
+        checkSecondaryIndexes(4000);
+        checkFrozenList(4000);
+        checkCardVault(4000);
+        checkPhoneNormalizer();
+        checkColdFields();
+        checkCuckooList(20000);
+        checkVersionedReclamation(2000);
+        benchRosterCodec(2000);
+        return (failedChecks == 0) ? 0 : 1;
+    }
+
+    unsigned int lookups = (argc > 1) ? stoul(argv[1]) : 1000000;
+    unsigned int members = (argc > 2) ? stoul(argv[2]) : 4000000;
+
+    checkListOperations(100000);
+    checkSecondaryIndexes(100000);
+    checkFrozenList(100000);
+    checkCardVault(100000);
+    checkPhoneNormalizer();
+    checkColdFields();
+    benchCuckooVersusLinearProbing(lookups);
+    checkCuckooList(members / 4);
+    benchOrderedIndex(1000000);
+    benchSearchMany(members, lookups);
+    benchIteration(1000000);
+    benchChurn(65536, 2000000);
+    benchFixedVersusDynamicCapacity(lookups);
+    benchRosterMerge(members);
+    benchErrorCodes(100000, lookups);
+    benchFilter(members, lookups);
+    benchSharding(members, lookups);
+    benchHugePages(4 * members, lookups);
+    benchLatencyTracking(members, lookups);
+    benchFrozenList(members, lookups);
+    benchCardVault(members);
+    checkVersionedReclamation(members / 4);
+    benchVersionedReload(members / 4, 4);
+    benchIngest(members);
+    benchRosterCodec(members);
+    benchInterleavedSearch(members, lookups);
+    benchPhoneNormalizer(members);
+    benchHotColdMembers(members, lookups);
+    benchColdArenaThreads(members);
+    return (failedChecks == 0) ? 0 : 1;
+}
@@ -10,6 +10,9 @@
 
 #include "List.h"
 #include "Member.h"
+#include "MemberIngest.h"
+#include "HashFamily.h"
+#include "PhoneKey.h"
 #include <iostream>
 #include <stdlib.h> // for rand()
 #include <time.h>   // for time()
@@ -205,14 +208,15 @@ void emailGenerator()
     return;
 }
 
-// Description: takes name, phone number, email address, and credit card number as input
-//             from a function and bundles them into a member data structure.
-void createMemberAndInsert(string name, string phone, string email, string card, List *member)
+// Description: reads the files containing the names, phone numbers, email addresses, and credit card numbers
+//             and inserts the members they describe into the list, through MemberIngest
+//             (asynchronous chunked reads, parsing overlapped with the reads, batched insertion).
+void readFilesAndCreateMembers(List *member)
 {
-    Member *newMember = new Member(name, phone, email, card);
     try
     {
-        member->insert(*newMember);
+        MemberIngest ingest("names.txt", "randomKeys.txt", "randomEmails.txt", "randomCardNums.txt");
+        ingest.loadInto(*member);
     }
     catch (exception &e)
     {
@@ -220,47 +224,6 @@ void createMemberAndInsert(string name, string phone, string email, string card,
     }
 }
 
-// Description: reads the files containing the names, phone numbers, email addresses, and credit card numbers
-//             and passes them to the createMember function to create a member data structure.
-void readFilesAndCreateMembers(List *member)
-{
-    // open file "names.txt" for reading
-    ifstream inFile;
-    inFile.open("names.txt");
-
-    // open file "randomKeys.txt" for reading
-    ifstream inFile2;
-    inFile2.open("randomKeys.txt");
-
-    // open file "randomEmails.txt" for reading
-    ifstream inFile3;
-    inFile3.open("randomEmails.txt");
-
-    // open file "randomCardNums.txt" for reading
-    ifstream inFile4;
-    inFile4.open("randomCardNums.txt");
-
-    string first_name;
-    string last_name;
-    string phone;
-    string email;
-    string card;
-
-    while (inFile >> first_name >> last_name && inFile2 >> phone && inFile3 >> email && inFile4 >> card)
-    {
-        // for testing purposes
-        // cout << "Inserting: " << first_name << " " << last_name << " " << phone << " " << email << " " << card << endl;
-        // cout << endl;
-        string name = first_name + " " + last_name;
-        createMemberAndInsert(name, phone, email, card, member);
-    }
-
-    inFile.close();
-    inFile2.close();
-    inFile3.close();
-    inFile4.close();
-}
-
 // Description: takes a quantity of members to be created as input and calls the requisite functions to do that
 void createMembers(unsigned int num, List *member)
 {
@@ -351,9 +314,57 @@ void callHashFoldBoundary()
     hfbTest = nullptr;
 }
 
+// Description: Lets a List pick its hash function: it starts with hashModulo on a table much larger than
+//              List::CAPACITY (where hashModulo, hashFoldShift and hashFoldBoundary cluster every key
+//              in the first cells) and, as the clustering shows up in its probe lengths, rehashes with
+//              the next function of the family until the probe lengths are those of a uniform hash.
+void callAdaptiveHashing()
+{
+    const unsigned int num = 20000;
+    List *adaptiveTest = new List(hashModulo, 2 * num + 1);
+
+    HashFamily family;
+    family.add("hashFoldShift", hashFoldShift);
+    family.add("hashFoldBoundary", hashFoldBoundary);
+    family.add("hashPhone", hashPhone);
+    family.addSeeded("hashPhoneSeeded", hashPhoneSeeded);
+    adaptiveTest->enableAdaptiveHashing(family);
+
+    cout << "********** Testing adaptive hash function selection **********" << endl;
+    cout << endl;
+
+    cout << "Inserting " << num << " members into the list, starting with the hashModulo methodology" << endl;
+    srand(7);
+    for (unsigned int i = 0; i < num; i++)
+    {
+        string phone = to_string(100 + rand() % 900) + "-" + to_string(100 + rand() % 900) + "-" + to_string(1000 + i % 9000);
+        Member *newMember = new Member("Member " + to_string(i), phone, "member" + to_string(i) + "@gmail.com", "1234567890123");
+        if (adaptiveTest->tryInsert(*newMember) != ErrorCode::OK)
+        {
+            delete newMember;
+        }
+    }
+    for (const List::HashSwitch &change : adaptiveTest->getHashSwitches())
+    {
+        cout << change.from << " -> " << change.to << " at " << change.elementCount << " elements: "
+             << change.insertProbeLength << " cells per insertion (expected " << change.expectedInsertProbeLength
+             << "), average probe length " << change.probeLengthBefore << " before, " << change.probeLengthAfter
+             << " after" << endl;
+    }
+    cout << "Hash function in use: " << adaptiveTest->getHashFunctionName() << ", average probe length "
+         << adaptiveTest->getAverageProbeLength() << " for " << adaptiveTest->getElementCount() << " members" << endl;
+    cout << endl;
+
+    cout << "********** End of Testing adaptive hash function selection **********" << endl;
+
+    delete adaptiveTest;
+    adaptiveTest = nullptr;
+}
+
 int main()
 {
     callHashModulo();
+    callAdaptiveHashing();
     // callHashFoldShift();
     // callHashFoldBoundary();
     return 0;
@@ -0,0 +1,121 @@
+/*
+ * LookupClient.cpp
+ *
+ * Class Description: Blocking TCP client of the lookup server (LookupServer), speaking the binary
+ *                    protocol of LookupProtocol.h.
+ * Class Invariant: - input[consumed, end) holds the bytes received and not yet returned by receive( ).
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <cerrno>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "LookupClient.h"
+#include "UnableToOpenFileException.h"
+
+using namespace std;
+
+// Constructor
+LookupClient::LookupClient(const string &host, unsigned short port)
+{
+    addrinfo hints{};
+    hints.ai_family = AF_INET;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo *addresses = nullptr;
+    if (getaddrinfo(host.c_str(), to_string(port).c_str(), &hints, &addresses) != 0)
+    {
+        throw UnableToOpenFileException("Unable to resolve the lookup server's address.");
+    }
+    for (addrinfo *address = addresses; address != nullptr && fd < 0; address = address->ai_next)
+    {
+        fd = socket(address->ai_family, address->ai_socktype | SOCK_CLOEXEC, address->ai_protocol);
+        if (fd >= 0 && connect(fd, address->ai_addr, address->ai_addrlen) < 0)
+        {
+            ::close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(addresses);
+    if (fd < 0)
+    {
+        throw UnableToOpenFileException("Unable to connect to the lookup server.");
+    }
+    int noDelay = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+}
+
+// Destructor
+LookupClient::~LookupClient()
+{
+    if (fd >= 0)
+    {
+        ::close(fd);
+    }
+}
+
+// Description: Sends the frames of requests.
+void LookupClient::send(const string &requests)
+{
+    size_t sent = 0;
+    while (sent < requests.size())
+    {
+        ssize_t written = ::send(fd, requests.data() + sent, requests.size() - sent, MSG_NOSIGNAL);
+        if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        if (written <= 0)
+        {
+            throw UnableToOpenFileException("Unable to send to the lookup server.");
+        }
+        sent += written;
+    }
+}
+
+// Description: Waits for the next response and returns its code.
+ErrorCode LookupClient::receive(vector<string> &fields)
+{
+    LookupFrame frame;
+    while (true)
+    {
+        const char *first = input.data() + consumed;
+        FrameStatus status = nextFrame(first, input.data() + input.size(), frame);
+        if (status == FrameStatus::COMPLETE)
+        {
+            consumed = first - input.data();
+            break;
+        }
+        if (status == FrameStatus::MALFORMED)
+        {
+            throw UnableToOpenFileException("Malformed response from the lookup server.");
+        }
+        input.erase(0, consumed);
+        consumed = 0;
+        size_t kept = input.size();
+        input.resize(kept + READ_SIZE);
+        ssize_t received = recv(fd, &input[kept], READ_SIZE, 0);
+        input.resize(kept + (received > 0 ? received : 0));
+        if (received == 0 || (received < 0 && errno != EINTR))
+        {
+            throw UnableToOpenFileException("Connection to the lookup server lost.");
+        }
+    }
+
+    fields.clear();
+    const char *next = frame.fields;
+    while (next != frame.end)
+    {
+        fields.emplace_back();
+        if (!readField(next, frame.end, fields.back()))
+        {
+            throw UnableToOpenFileException("Malformed response from the lookup server.");
+        }
+    }
+    return (ErrorCode)frame.code;
+}
@@ -0,0 +1,59 @@
+/*
+ * LookupClient.h
+ *
+ * Class Description: Blocking TCP client of the lookup server (LookupServer), speaking the binary
+ *                    protocol of LookupProtocol.h.
+ *                    Requests are appended to a string with appendInsertRequest( ),
+ *                    appendSearchRequest( ) or appendRemoveRequest( ) and sent together by send( )
+ *                    (pipelining); receive( ) then returns their responses one at a time, in order.
+ * Class Invariant: - input[consumed, end) holds the bytes received and not yet returned by receive( ).
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef LOOKUP_CLIENT_H
+#define LOOKUP_CLIENT_H
+
+#include <string>
+#include <vector>
+#include "ErrorCode.h"
+#include "LookupProtocol.h"
+
+using std::string;
+using std::vector;
+
+class LookupClient
+{
+
+public:
+  const static unsigned int READ_SIZE = 64 * 1024; // Bytes read per recv( ).
+
+private:
+  int fd = -1;
+  string input;
+  size_t consumed = 0;
+
+public:
+  // Constructor
+  // Description: Connects to the lookup server at host (IPv4 address or name):port.
+  // Exception: Throws UnableToOpenFileException if the server cannot be reached.
+  LookupClient(const string &host, unsigned short port);
+
+  // Destructor
+  ~LookupClient();
+
+  LookupClient(const LookupClient &) = delete;
+  LookupClient &operator=(const LookupClient &) = delete;
+
+  // Description: Sends the frames of requests (made with the append*Request( ) functions).
+  // Exception: Throws UnableToOpenFileException if the connection fails.
+  void send(const string &requests);
+
+  // Description: Waits for the next response and returns its code; fields receives its fields
+  //              (name, phone, email and masked credit card for a successful search, none otherwise).
+  // Exception: Throws UnableToOpenFileException if the connection fails or closes, or the response is malformed.
+  ErrorCode receive(vector<string> &fields);
+};
+
+#endif
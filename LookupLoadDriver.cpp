@@ -0,0 +1,274 @@
+/*
+ * LookupLoadDriver.cpp
+ *
+ * Description: Load generator for the lookup server (LookupServer).
+ *              Usage: lld [members] [requests per level] [host] [port]
+ *              Without host, serves a List of "members" random members on 127.0.0.1 (any free port)
+ *              in this process; with host and port, inserts them into that server first.
+ *              Then, for each level of concurrency (connections, each on its own thread) and of
+ *              pipelining (requests sent together by a connection before it reads their responses),
+ *              sends searches (one in MISS_RATIO for a phone that is not stored) and reports the
+ *              throughput and the latency percentiles of the requests (time from the send of a
+ *              request to the receipt of its response). Every response is checked.
+ *              Finally each connection removes and inserts back its share of the members.
+ *
+ * Author: Elaine Luu
+ * Created on: Oct. 2026
+ *
+ */
+
+#include "LatencyHistogram.h"
+#include "List.h"
+#include "LookupClient.h"
+#include "LookupServer.h"
+#include "Member.h"
+#include "PhoneKey.h"
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+const unsigned int MISS_RATIO = 8;
+const unsigned int CONNECTIONS[] = {1, 4, 16, 64};
+const unsigned int PIPELINE_DEPTHS[] = {1, 32};
+
+// Description: Formats a packed 10-digit key as XXX-XXX-XXXX.
+string formatPhone(unsigned long long key)
+{
+    char buffer[13];
+    for (int i = 11; i >= 0; i--)
+    {
+        if (i == 3 || i == 7)
+        {
+            buffer[i] = '-';
+        }
+        else
+        {
+            buffer[i] = (char)('0' + key % 10);
+            key /= 10;
+        }
+    }
+    buffer[12] = '\0';
+    return string(buffer);
+}
+
+// Description: Returns the phone of member i (even keys: odd keys are never stored, for misses;
+//              never key 0, "000-000-0000", which is not a valid phone number).
+string memberPhone(unsigned long long i)
+{
+    return formatPhone(((i + 1) * 2654435761ULL % 5000000000ULL) * 2);
+}
+
+// Description: Returns member i.
+Member *makeMember(unsigned int i)
+{
+    return new Member("Member " + to_string(i), memberPhone(i), "member" + to_string(i) + "@gmail.com",
+                      "4" + to_string(100000000000ULL + i));
+}
+
+// Description: Sends the searches of one connection, depth at a time, and records their latencies.
+//              Returns the number of responses that are not the expected ones.
+unsigned long long searchLoad(const string &host, unsigned short port, unsigned int members, unsigned int requests,
+                              unsigned int depth, unsigned int seed, LatencyHistogram &latencies)
+{
+    LookupClient client(host, port);
+    unsigned long long errors = 0;
+    unsigned long long state = seed * 0x9E3779B97F4A7C15ULL + 1;
+    vector<string> phones(depth);
+    vector<bool> stored(depth);
+    vector<string> fields;
+    string frames;
+    for (unsigned int done = 0; done < requests; done += depth)
+    {
+        unsigned int count = (requests - done < depth) ? requests - done : depth;
+        frames.clear();
+        for (unsigned int r = 0; r < count; r++)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            unsigned long long draw = state >> 33;
+            stored[r] = draw % MISS_RATIO != 0;
+            phones[r] = stored[r] ? memberPhone(draw / MISS_RATIO % members) : formatPhone(draw % 5000000000ULL * 2 + 1);
+            appendSearchRequest(frames, phones[r]);
+        }
+        Clock::time_point sent = Clock::now();
+        client.send(frames);
+        for (unsigned int r = 0; r < count; r++)
+        {
+            ErrorCode code = client.receive(fields);
+            latencies.record(chrono::duration_cast<chrono::nanoseconds>(Clock::now() - sent).count());
+            bool expected = stored[r] ? code == ErrorCode::OK && fields.size() == 4 && fields[1] == phones[r]
+                                      : code == ErrorCode::ELEMENT_DOES_NOT_EXIST;
+            errors += !expected;
+        }
+    }
+    return errors;
+}
+
+// Description: Removes members [first, last) and inserts them back, depth requests at a time.
+//              Returns the number of responses that are not OK.
+unsigned long long churnLoad(const string &host, unsigned short port, unsigned int first, unsigned int last,
+                             unsigned int depth)
+{
+    LookupClient client(host, port);
+    unsigned long long errors = 0;
+    vector<string> fields;
+    string frames;
+    for (unsigned int begin = first; begin < last; begin += depth)
+    {
+        unsigned int end = (last - begin < depth) ? last : begin + depth;
+        frames.clear();
+        for (unsigned int i = begin; i < end; i++)
+        {
+            appendRemoveRequest(frames, memberPhone(i));
+        }
+        for (unsigned int i = begin; i < end; i++)
+        {
+            unique_ptr<Member> member(makeMember(i));
+            appendInsertRequest(frames, *member);
+        }
+        client.send(frames);
+        for (unsigned int r = 0; r < 2 * (end - begin); r++)
+        {
+            errors += client.receive(fields) != ErrorCode::OK;
+        }
+    }
+    return errors;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int members = (argc > 1) ? stoul(argv[1]) : 1000000;
+    unsigned int requests = (argc > 2) ? stoul(argv[2]) : 200000;
+    string host = (argc > 3) ? argv[3] : "127.0.0.1";
+    unsigned short port = (argc > 4) ? stoul(argv[4]) : 0;
+
+    try
+    {
+        List list(hashPhone, 2 * members + 1);
+        unique_ptr<LookupServer> server;
+        Clock::time_point start = Clock::now();
+        if (argc <= 3)
+        {
+            for (unsigned int i = 0; i < members; i++)
+            {
+                list.insert(*makeMember(i));
+            }
+            server.reset(new LookupServer(list, host, 0));
+            server->start();
+            port = server->getPort();
+            cout << "In-process server on " << host << ":" << port << " (" << server->getLoopCount() << " loops), "
+                 << members << " members inserted in " << chrono::duration<double>(Clock::now() - start).count()
+                 << " s" << endl;
+        }
+        else
+        {
+            LookupClient client(host, port);
+            string frames;
+            vector<string> fields;
+            unsigned int inserted = 0;
+            for (unsigned int begin = 0; begin < members; begin += 1024)
+            {
+                unsigned int end = (members - begin < 1024) ? members : begin + 1024;
+                frames.clear();
+                for (unsigned int i = begin; i < end; i++)
+                {
+                    unique_ptr<Member> member(makeMember(i));
+                    appendInsertRequest(frames, *member);
+                }
+                client.send(frames);
+                for (unsigned int i = begin; i < end; i++)
+                {
+                    inserted += client.receive(fields) == ErrorCode::OK;
+                }
+            }
+            cout << "Server " << host << ":" << port << ": " << inserted << " of " << members << " members inserted ("
+                 << members - inserted << " already there) in " << chrono::duration<double>(Clock::now() - start).count()
+                 << " s" << endl;
+        }
+
+        unsigned long long failures = 0;
+        cout << fixed << "connections  depth  requests/s    p50 (us)   p99 (us)  p99.9 (us)  max (us)  errors" << endl;
+        for (unsigned int connections : CONNECTIONS)
+        {
+            for (unsigned int depth : PIPELINE_DEPTHS)
+            {
+                LatencyHistogram latencies;
+                atomic<unsigned long long> errors{0};
+                vector<thread> threads;
+                start = Clock::now();
+                for (unsigned int c = 0; c < connections; c++)
+                {
+                    threads.push_back(thread([&, c]() {
+                        try
+                        {
+                            errors += searchLoad(host, port, members, requests / connections, depth, c + 1, latencies);
+                        }
+                        catch (exception &e)
+                        {
+                            cout << "Exception: " << e.what() << endl;
+                            errors += requests / connections;
+                        }
+                    }));
+                }
+                for (thread &t : threads)
+                {
+                    t.join();
+                }
+                double seconds = chrono::duration<double>(Clock::now() - start).count();
+                cout << setw(11) << connections << setw(7) << depth << setw(12) << setprecision(0)
+                     << latencies.getCount() / seconds << setprecision(1) << setw(12)
+                     << latencies.valueAtQuantile(0.5) / 1000.0 << setw(11) << latencies.valueAtQuantile(0.99) / 1000.0
+                     << setw(12) << latencies.valueAtQuantile(0.999) / 1000.0 << setw(10)
+                     << latencies.getMaximum() / 1000.0 << setw(8) << errors.load() << endl;
+                failures += errors;
+            }
+        }
+
+        const unsigned int churnConnections = 4;
+        atomic<unsigned long long> errors{0};
+        vector<thread> threads;
+        start = Clock::now();
+        for (unsigned int c = 0; c < churnConnections; c++)
+        {
+            threads.push_back(thread([&, c]() {
+                try
+                {
+                    errors += churnLoad(host, port, (unsigned long long)members * c / churnConnections,
+                                        (unsigned long long)members * (c + 1) / churnConnections, 32);
+                }
+                catch (exception &e)
+                {
+                    cout << "Exception: " << e.what() << endl;
+                    errors += 1;
+                }
+            }));
+        }
+        for (thread &t : threads)
+        {
+            t.join();
+        }
+        double seconds = chrono::duration<double>(Clock::now() - start).count();
+        cout << "Removed and inserted back " << members << " members over " << churnConnections << " connections: "
+             << 2.0 * members / seconds << " requests/s, " << errors.load() << " errors" << endl;
+        failures += errors;
+
+        if (server)
+        {
+            server->stop();
+            cout << "Requests served: " << server->getRequestCount() << endl;
+        }
+        return failures == 0 ? 0 : 1;
+    }
+    catch (exception &e)
+    {
+        cout << "Exception: " << e.what() << endl;
+        return 1;
+    }
+}
@@ -0,0 +1,108 @@
+/*
+ * LookupProtocol.cpp
+ *
+ * Description: Binary protocol of the lookup server and its client: length prefixed frames
+ *              of a code and length prefixed fields.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include "LookupProtocol.h"
+
+// Description: Extracts the frame starting at first, if [first, last) holds all of it, and moves first past it.
+FrameStatus nextFrame(const char *&first, const char *last, LookupFrame &frame)
+{
+    if (last - first < 4)
+    {
+        return FrameStatus::INCOMPLETE;
+    }
+    const unsigned char *bytes = (const unsigned char *)first;
+    unsigned int length = (unsigned int)bytes[0] | (unsigned int)bytes[1] << 8 | (unsigned int)bytes[2] << 16 |
+                          (unsigned int)bytes[3] << 24;
+    if (length == 0 || length > MAX_FRAME_SIZE)
+    {
+        return FrameStatus::MALFORMED;
+    }
+    if ((unsigned long long)(last - first) < 4ULL + length)
+    {
+        return FrameStatus::INCOMPLETE;
+    }
+    frame.code = bytes[4];
+    frame.fields = first + FRAME_HEADER_SIZE;
+    frame.end = first + 4 + length;
+    first = frame.end;
+    return FrameStatus::COMPLETE;
+}
+
+// Description: Reads the next field of a frame into field and moves next past it.
+bool readField(const char *&next, const char *end, string &field)
+{
+    if (end - next < 2)
+    {
+        return false;
+    }
+    unsigned int length = (unsigned int)(unsigned char)next[0] | (unsigned int)(unsigned char)next[1] << 8;
+    if ((unsigned int)(end - next - 2) < length)
+    {
+        return false;
+    }
+    field.assign(next + 2, length);
+    next += 2 + length;
+    return true;
+}
+
+// Description: Appends a frame header with the given code to out and returns its position.
+unsigned int beginFrame(string &out, unsigned char code)
+{
+    unsigned int start = (unsigned int)out.size();
+    out.append(4, '\0');
+    out.push_back((char)code);
+    return start;
+}
+
+// Description: Appends a field (its first 65535 bytes) to out.
+void appendField(string &out, const string &field)
+{
+    unsigned int length = field.size() < 0xFFFF ? (unsigned int)field.size() : 0xFFFF;
+    out.push_back((char)length);
+    out.push_back((char)(length >> 8));
+    out.append(field, 0, length);
+}
+
+// Description: Sets the length of the frame started at position start of out.
+void endFrame(string &out, unsigned int start)
+{
+    unsigned int length = (unsigned int)out.size() - start - 4;
+    for (unsigned int b = 0; b < 4; b++)
+    {
+        out[start + b] = (char)(length >> (8 * b));
+    }
+}
+
+// Description: Appends an INSERT request for member (with its full credit card) to out.
+void appendInsertRequest(string &out, const Member &member)
+{
+    unsigned int start = beginFrame(out, (unsigned char)LookupOperation::INSERT);
+    appendField(out, member.getName());
+    appendField(out, member.getPhone());
+    appendField(out, member.getEmail());
+    appendField(out, member.getCreditCard());
+    endFrame(out, start);
+}
+
+// Description: Appends a SEARCH request to out.
+void appendSearchRequest(string &out, const string &phone)
+{
+    unsigned int start = beginFrame(out, (unsigned char)LookupOperation::SEARCH);
+    appendField(out, phone);
+    endFrame(out, start);
+}
+
+// Description: Appends a REMOVE request to out.
+void appendRemoveRequest(string &out, const string &phone)
+{
+    unsigned int start = beginFrame(out, (unsigned char)LookupOperation::REMOVE);
+    appendField(out, phone);
+    endFrame(out, start);
+}
@@ -0,0 +1,88 @@
+/*
+ * LookupProtocol.h
+ *
+ * Description: Binary protocol of the lookup server (LookupServer) and its client (LookupClient).
+ *              A connection carries frames; a client may send any number of requests without
+ *              waiting (pipelining) and the server answers them in order.
+ *              Frame: 4-byte little endian length of the rest of the frame (at most MAX_FRAME_SIZE),
+ *                     1-byte code, then fields, each a 2-byte little endian length and its bytes.
+ *              Requests (code: LookupOperation):
+ *                  INSERT name, phone, email, credit card
+ *                  SEARCH phone
+ *                  REMOVE phone
+ *              A phone may be given in any format accepted by normalizePhone( ) (PhoneKey.h).
+ *              Responses (code: the ErrorCode of the operation, as by the List's tryInsert( ),
+ *              trySearch( ) and tryRemove( )): no field, except a successful SEARCH:
+ *                  name, phone, email, masked credit card (Member::getMaskedCreditCard( )).
+ *              The server closes a connection that sends a malformed frame.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef LOOKUP_PROTOCOL_H
+#define LOOKUP_PROTOCOL_H
+
+#include <string>
+#include <vector>
+#include "ErrorCode.h"
+#include "Member.h"
+
+using std::string;
+using std::vector;
+
+const unsigned int MAX_FRAME_SIZE = 4096;  // Bytes after the length of a frame.
+const unsigned int FRAME_HEADER_SIZE = 5; // Length, code.
+
+enum class LookupOperation : unsigned char
+{
+  INSERT = 1,
+  SEARCH = 2,
+  REMOVE = 3
+};
+
+// A frame received, pointing into the receive buffer.
+struct LookupFrame
+{
+  unsigned char code = 0;
+  const char *fields = nullptr; // First field.
+  const char *end = nullptr;    // End of the frame.
+};
+
+// Outcomes of nextFrame( ).
+enum class FrameStatus
+{
+  COMPLETE,   // A frame was extracted.
+  INCOMPLETE, // [first, last) holds part of a frame only: wait for more bytes.
+  MALFORMED   // The length is out of bounds.
+};
+
+// Description: Extracts the frame starting at first, if [first, last) holds all of it, and moves first past it.
+// Time Efficiency: O(1)
+FrameStatus nextFrame(const char *&first, const char *last, LookupFrame &frame);
+
+// Description: Reads the next field of a frame into field and moves next past it.
+//              Returns false if the frame has no complete field left at next.
+// Time Efficiency: O(length of the field)
+bool readField(const char *&next, const char *end, string &field);
+
+// Description: Appends a frame header with the given code to out and returns its position,
+//              for endFrame( ) once the fields are appended.
+unsigned int beginFrame(string &out, unsigned char code);
+
+// Description: Appends a field (its first 65535 bytes) to out.
+void appendField(string &out, const string &field);
+
+// Description: Sets the length of the frame started at position start of out.
+void endFrame(string &out, unsigned int start);
+
+// Description: Appends an INSERT request for member (with its full credit card) to out.
+void appendInsertRequest(string &out, const Member &member);
+
+// Description: Appends a SEARCH request to out.
+void appendSearchRequest(string &out, const string &phone);
+
+// Description: Appends a REMOVE request to out.
+void appendRemoveRequest(string &out, const string &phone);
+
+#endif
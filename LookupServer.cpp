@@ -0,0 +1,551 @@
+/*
+ * LookupServer.cpp
+ *
+ * Class Description: TCP server exposing the insert( ), search( ) and remove( ) of a List over the
+ *                    binary protocol of LookupProtocol.h, with one epoll loop per core.
+ * Class Invariant: - A connection is accessed by the thread of its loop only.
+ *                  - Responses are sent in the order of the requests of their connection.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <arpa/inet.h>
+#include <cerrno>
+#include <mutex>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "LookupServer.h"
+#include "PhoneKey.h"
+#include "UnableToOpenFileException.h"
+
+using namespace std;
+
+// Requests parsed from a connection's input before they are served (bounds the output produced
+// past MAX_PENDING_OUTPUT before the connection is paused).
+static const unsigned int MAX_BATCH = 1024;
+
+// Constructor
+LookupServer::LookupServer(List &aList, const string &anAddress, unsigned short aPort, unsigned int aLoopCount)
+    : list(aList), address(anAddress), port(aPort), loopCount(aLoopCount)
+{
+    if (loopCount == 0)
+    {
+        loopCount = thread::hardware_concurrency();
+    }
+    if (loopCount == 0)
+    {
+        loopCount = 1;
+    }
+}
+
+// Destructor
+LookupServer::~LookupServer()
+{
+    stop();
+}
+
+// Description: Opens the listening sockets and starts the loops.
+void LookupServer::start()
+{
+    if (loops != nullptr)
+    {
+        return;
+    }
+    loops = new Loop[loopCount];
+    bool opened = true;
+    for (unsigned int l = 0; l < loopCount && opened; l++)
+    {
+        Loop &loop = loops[l];
+        loop.listenFd = listenOn(port);
+        loop.epollFd = epoll_create1(EPOLL_CLOEXEC);
+        loop.wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (loop.listenFd < 0 || loop.epollFd < 0 || loop.wakeFd < 0)
+        {
+            opened = false;
+            break;
+        }
+        if (port == 0)
+        {
+            // The other loops bind the port the system chose for the first.
+            sockaddr_in bound{};
+            socklen_t length = sizeof(bound);
+            getsockname(loop.listenFd, (sockaddr *)&bound, &length);
+            port = ntohs(bound.sin_port);
+        }
+        // The listening socket and the wake up eventfd are told apart from the connections by their data.ptr.
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, loop.listenFd, &event);
+        event.data.ptr = &loop;
+        epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, loop.wakeFd, &event);
+    }
+    if (!opened)
+    {
+        stop();
+        throw UnableToOpenFileException("Unable to listen on the lookup server's port.");
+    }
+    for (unsigned int l = 0; l < loopCount; l++)
+    {
+        loops[l].worker = thread(&LookupServer::run, this, ref(loops[l]));
+    }
+}
+
+// Description: Stops the loops and closes every connection and socket.
+void LookupServer::stop()
+{
+    if (loops == nullptr)
+    {
+        return;
+    }
+    stopping = true;
+    for (unsigned int l = 0; l < loopCount; l++)
+    {
+        if (loops[l].wakeFd >= 0)
+        {
+            unsigned long long one = 1;
+            ssize_t written = write(loops[l].wakeFd, &one, sizeof(one));
+            (void)written;
+        }
+    }
+    for (unsigned int l = 0; l < loopCount; l++)
+    {
+        Loop &loop = loops[l];
+        if (loop.worker.joinable())
+        {
+            loop.worker.join();
+        }
+        while (!loop.connections.empty())
+        {
+            close(loop, loop.connections.begin()->second);
+        }
+        for (int fd : {loop.listenFd, loop.wakeFd, loop.epollFd})
+        {
+            if (fd >= 0)
+            {
+                ::close(fd);
+            }
+        }
+    }
+    delete[] loops;
+    loops = nullptr;
+    stopping = false;
+}
+
+// Description: Returns the port the server listens on.
+unsigned short LookupServer::getPort() const
+{
+    return port;
+}
+
+// Description: Returns the number of loops.
+unsigned int LookupServer::getLoopCount() const
+{
+    return loopCount;
+}
+
+// Description: Returns the number of requests served so far.
+unsigned long long LookupServer::getRequestCount() const
+{
+    return requestCount.load(memory_order_relaxed);
+}
+
+// Description: Returns the number of open connections.
+unsigned int LookupServer::getConnectionCount() const
+{
+    return connectionCount.load(memory_order_relaxed);
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Body of the thread of a loop: accepts connections and serves them until stopping.
+void LookupServer::run(Loop &loop)
+{
+    epoll_event events[MAX_EVENTS];
+    while (!stopping)
+    {
+        int ready = epoll_wait(loop.epollFd, events, MAX_EVENTS, -1);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            break;
+        }
+        for (int e = 0; e < ready && !stopping; e++)
+        {
+            void *source = events[e].data.ptr;
+            if (source == nullptr)
+            {
+                accept(loop);
+            }
+            else if (source != &loop)
+            {
+                Connection *connection = (Connection *)source;
+                if (!handle(loop, *connection, events[e].events))
+                {
+                    close(loop, connection);
+                }
+            }
+        }
+    }
+}
+
+// Description: Accepts the pending connections of a loop's listening socket.
+void LookupServer::accept(Loop &loop)
+{
+    while (true)
+    {
+        int fd = accept4(loop.listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0)
+        {
+            // EAGAIN: no more pending connections; anything else (e.g. EMFILE) is retried on the next event.
+            return;
+        }
+        int noDelay = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+        Connection *connection = new Connection();
+        connection->fd = fd;
+        connection->events = EPOLLIN;
+        epoll_event event{};
+        event.events = connection->events;
+        event.data.ptr = connection;
+        if (epoll_ctl(loop.epollFd, EPOLL_CTL_ADD, fd, &event) < 0)
+        {
+            ::close(fd);
+            delete connection;
+            continue;
+        }
+        loop.connections[fd] = connection;
+        connectionCount.fetch_add(1, memory_order_relaxed);
+    }
+}
+
+// Description: Reads what a connection has received, serves its complete requests and sends the responses.
+//              Returns false if the connection is to be closed.
+bool LookupServer::handle(Loop &loop, Connection &connection, unsigned int events)
+{
+    if (events & (EPOLLERR | EPOLLHUP))
+    {
+        return false;
+    }
+    if (events & EPOLLIN)
+    {
+        // Level triggered: one recv( ) per event, whatever is left is reported again.
+        size_t kept = connection.input.size();
+        connection.input.resize(kept + READ_SIZE);
+        ssize_t received = recv(connection.fd, &connection.input[kept], READ_SIZE, 0);
+        connection.input.resize(kept + (received > 0 ? received : 0));
+        if (received == 0)
+        {
+            connection.peerClosed = true;
+        }
+        else if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+        {
+            return false;
+        }
+    }
+    // Serving stops while the output is over MAX_PENDING_OUTPUT: resume as soon as the client has taken it,
+    // since the requests left in the input may be all it sends.
+    while (true)
+    {
+        size_t unserved = connection.input.size();
+        if (!serve(connection) || !flush(connection))
+        {
+            return false;
+        }
+        if (connection.input.size() == unserved || connection.output.size() - connection.sent >= MAX_PENDING_OUTPUT)
+        {
+            break;
+        }
+    }
+    if (connection.peerClosed && connection.sent == connection.output.size())
+    {
+        // Everything asked is answered (a trailing partial frame is dropped).
+        return false;
+    }
+    watch(loop, connection);
+    return true;
+}
+
+// Description: Serves the complete requests of a connection's input, appending the responses to its output.
+//              Returns false if a frame is malformed.
+bool LookupServer::serve(Connection &connection)
+{
+    const char *first = connection.input.data();
+    const char *last = first + connection.input.size();
+    vector<LookupFrame> frames;
+    bool complete = true;
+    while (complete && connection.output.size() - connection.sent < MAX_PENDING_OUTPUT)
+    {
+        frames.clear();
+        LookupFrame frame;
+        while (frames.size() < MAX_BATCH)
+        {
+            FrameStatus status = nextFrame(first, last, frame);
+            if (status == FrameStatus::MALFORMED)
+            {
+                return false;
+            }
+            if (status == FrameStatus::INCOMPLETE)
+            {
+                complete = false;
+                break;
+            }
+            frames.push_back(frame);
+        }
+        if (frames.empty())
+        {
+            break;
+        }
+        // Consecutive requests of the same operation are served as one batch.
+        size_t begin = 0;
+        while (begin < frames.size())
+        {
+            size_t end = begin + 1;
+            while (end < frames.size() && frames[end].code == frames[begin].code)
+            {
+                end++;
+            }
+            if (!serveBatch((LookupOperation)frames[begin].code, frames, begin, end, connection.output))
+            {
+                return false;
+            }
+            begin = end;
+        }
+        requestCount.fetch_add(frames.size(), memory_order_relaxed);
+    }
+    connection.input.erase(0, first - connection.input.data());
+    return true;
+}
+
+// Description: Serves a batch of requests of the same operation: frames[first, last).
+//              Returns false if a frame is malformed.
+bool LookupServer::serveBatch(LookupOperation operation, const vector<LookupFrame> &frames, size_t first,
+                              size_t last, string &output)
+{
+    unsigned int count = (unsigned int)(last - first);
+    vector<string> phones(count);
+    vector<unsigned long long> keys;
+    if (operation == LookupOperation::SEARCH || operation == LookupOperation::REMOVE)
+    {
+        for (unsigned int i = 0; i < count; i++)
+        {
+            const char *next = frames[first + i].fields;
+            if (!readField(next, frames[first + i].end, phones[i]) || next != frames[first + i].end)
+            {
+                return false;
+            }
+        }
+        // Phones in any accepted format are looked up in the canonical one; an invalid phone matches nothing.
+        keys.resize(count);
+        normalizePhones(phones.data(), keys.data(), count);
+        for (unsigned int i = 0; i < count; i++)
+        {
+            phones[i].resize(12);
+            formatPhoneKey(keys[i], &phones[i][0]);
+        }
+    }
+
+    if (operation == LookupOperation::SEARCH)
+    {
+        vector<Member *> results(count);
+        shared_lock<shared_mutex> lock(listLock);
+        list.searchMany(phones.data(), results.data(), count);
+        ErrorCode missing = list.getElementCount() == 0 ? ErrorCode::EMPTY_DATA_COLLECTION : ErrorCode::ELEMENT_DOES_NOT_EXIST;
+        // The members are read while the lock keeps them from being removed.
+        for (unsigned int i = 0; i < count; i++)
+        {
+            const Member *found = results[i];
+            unsigned int start = beginFrame(output, (unsigned char)(found != nullptr ? ErrorCode::OK : missing));
+            if (found != nullptr)
+            {
+                appendField(output, found->getName());
+                appendField(output, found->getPhone());
+                appendField(output, found->getEmail());
+                appendField(output, found->getMaskedCreditCard());
+            }
+            endFrame(output, start);
+        }
+        return true;
+    }
+
+    vector<ErrorCode> codes(count);
+    if (operation == LookupOperation::INSERT)
+    {
+        // The members (and their vault tokens) are made before the List is locked.
+        vector<Member *> members(count, nullptr);
+        string fields[4];
+        bool wellFormed = true;
+        for (unsigned int i = 0; i < count && wellFormed; i++)
+        {
+            const char *next = frames[first + i].fields;
+            for (unsigned int f = 0; f < 4 && wellFormed; f++)
+            {
+                wellFormed = readField(next, frames[first + i].end, fields[f]);
+            }
+            if (wellFormed && next == frames[first + i].end)
+            {
+                members[i] = new Member(fields[0], fields[1], fields[2], fields[3]);
+            }
+            else
+            {
+                wellFormed = false;
+            }
+        }
+        if (!wellFormed)
+        {
+            for (Member *member : members)
+            {
+                delete member;
+            }
+            return false;
+        }
+        {
+            unique_lock<shared_mutex> lock(listLock);
+            list.insertMany(members.data(), codes.data(), count);
+        }
+        for (unsigned int i = 0; i < count; i++)
+        {
+            if (codes[i] != ErrorCode::OK)
+            {
+                delete members[i];
+            }
+        }
+    }
+    else if (operation == LookupOperation::REMOVE)
+    {
+        vector<Member> targets;
+        targets.reserve(count);
+        for (unsigned int i = 0; i < count; i++)
+        {
+            targets.emplace_back(phones[i]);
+        }
+        unique_lock<shared_mutex> lock(listLock);
+        for (unsigned int i = 0; i < count; i++)
+        {
+            if (keys[i] == INVALID_PHONE_KEY)
+            {
+                codes[i] = list.getElementCount() == 0 ? ErrorCode::EMPTY_DATA_COLLECTION : ErrorCode::ELEMENT_DOES_NOT_EXIST;
+            }
+            else
+            {
+                codes[i] = list.tryRemove(targets[i]);
+            }
+        }
+    }
+    else
+    {
+        return false;
+    }
+    for (unsigned int i = 0; i < count; i++)
+    {
+        unsigned int start = beginFrame(output, (unsigned char)codes[i]);
+        endFrame(output, start);
+    }
+    return true;
+}
+
+// Description: Sends as much of a connection's output as the socket takes. Returns false on error.
+bool LookupServer::flush(Connection &connection)
+{
+    while (connection.sent < connection.output.size())
+    {
+        ssize_t written = send(connection.fd, connection.output.data() + connection.sent,
+                               connection.output.size() - connection.sent, MSG_NOSIGNAL);
+        if (written > 0)
+        {
+            connection.sent += written;
+        }
+        else if (written < 0 && errno == EINTR)
+        {
+            continue;
+        }
+        else if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            break;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    if (connection.sent == connection.output.size())
+    {
+        connection.output.clear();
+        connection.sent = 0;
+    }
+    else if (connection.sent >= MAX_PENDING_OUTPUT)
+    {
+        connection.output.erase(0, connection.sent);
+        connection.sent = 0;
+    }
+    return true;
+}
+
+// Description: Registers a connection for the events it waits for now (input unless paused, output if pending).
+void LookupServer::watch(Loop &loop, Connection &connection)
+{
+    size_t pending = connection.output.size() - connection.sent;
+    unsigned int events = 0;
+    if (!connection.peerClosed && pending < MAX_PENDING_OUTPUT)
+    {
+        events |= EPOLLIN;
+    }
+    if (pending > 0)
+    {
+        events |= EPOLLOUT;
+    }
+    if (events != connection.events)
+    {
+        epoll_event event{};
+        event.events = events;
+        event.data.ptr = &connection;
+        epoll_ctl(loop.epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+        connection.events = events;
+    }
+}
+
+// Description: Closes a connection and forgets it.
+void LookupServer::close(Loop &loop, Connection *connection)
+{
+    epoll_ctl(loop.epollFd, EPOLL_CTL_DEL, connection->fd, nullptr);
+    ::close(connection->fd);
+    loop.connections.erase(connection->fd);
+    delete connection;
+    connectionCount.fetch_sub(1, memory_order_relaxed);
+}
+
+// Description: Opens a non-blocking listening socket bound to address:port with SO_REUSEPORT.
+int LookupServer::listenOn(unsigned short aPort) const
+{
+    sockaddr_in socketAddress{};
+    socketAddress.sin_family = AF_INET;
+    socketAddress.sin_port = htons(aPort);
+    if (inet_pton(AF_INET, address.c_str(), &socketAddress.sin_addr) != 1)
+    {
+        return -1;
+    }
+    int fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    int on = 1;
+    setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+    if (setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) < 0 ||
+        bind(fd, (sockaddr *)&socketAddress, sizeof(socketAddress)) < 0 || listen(fd, SOMAXCONN) < 0)
+    {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
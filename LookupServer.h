@@ -0,0 +1,149 @@
+/*
+ * LookupServer.h
+ *
+ * Class Description: TCP server exposing the insert( ), search( ) and remove( ) of a List over the
+ *                    binary protocol of LookupProtocol.h.
+ *                    Event driven: each of its loops (one per core by default) is a thread waiting
+ *                    on its own epoll instance, with its own listening socket bound to the common
+ *                    port with SO_REUSEPORT, so that the kernel spreads the incoming connections
+ *                    over the loops and a connection is served by one loop only.
+ *                    Sockets are non-blocking. The requests a connection has pipelined are served
+ *                    in order, consecutive requests of the same operation as one batch: one
+ *                    List::searchMany( ), List::insertMany( ) or series of List::tryRemove( ) under
+ *                    one acquisition of the List's lock (shared for searches, exclusive for inserts
+ *                    and removes), and their responses sent with as few writes as possible.
+ *                    A connection that has more than MAX_PENDING_OUTPUT bytes of responses waiting
+ *                    for the client to read them is not read from until it catches up.
+ *                    The List must not be used by anything else while the server runs.
+ * Class Invariant: - A connection is accessed by the thread of its loop only.
+ *                  - Responses are sent in the order of the requests of their connection.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef LOOKUP_SERVER_H
+#define LOOKUP_SERVER_H
+
+#include <atomic>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "List.h"
+#include "LookupProtocol.h"
+
+using std::atomic;
+using std::shared_mutex;
+using std::string;
+using std::thread;
+using std::unordered_map;
+using std::vector;
+
+class LookupServer
+{
+
+public:
+  const static unsigned int MAX_EVENTS = 256;                  // Events handled per epoll_wait( ).
+  const static unsigned int READ_SIZE = 64 * 1024;             // Bytes read per recv( ).
+  const static unsigned int MAX_PENDING_OUTPUT = 1024 * 1024;  // Bytes of unsent responses before a connection is paused.
+
+private:
+  struct Connection
+  {
+    int fd = -1;
+    string input;           // Received, not yet served (at most a partial frame, unless paused).
+    string output;          // Responses not yet sent, from position sent on.
+    size_t sent = 0;
+    unsigned int events = 0; // Events the connection is registered for.
+    bool peerClosed = false; // The client will send nothing more.
+  };
+
+  struct Loop
+  {
+    int epollFd = -1;
+    int listenFd = -1;
+    int wakeFd = -1; // eventfd written by stop( ).
+    thread worker;
+    unordered_map<int, Connection *> connections;
+  };
+
+  List &list;
+  shared_mutex listLock; // Shared for searches, exclusive for inserts and removes.
+  string address;
+  unsigned short port;
+  unsigned int loopCount;
+  Loop *loops = nullptr;
+  atomic<bool> stopping{false};
+  atomic<unsigned long long> requestCount{0};
+  atomic<unsigned int> connectionCount{0};
+
+  // Description: Body of the thread of a loop: accepts connections and serves them until stopping.
+  void run(Loop &loop);
+
+  // Description: Accepts the pending connections of a loop's listening socket.
+  void accept(Loop &loop);
+
+  // Description: Reads what a connection has received, serves its complete requests and sends the responses.
+  //              Returns false if the connection is to be closed.
+  bool handle(Loop &loop, Connection &connection, unsigned int events);
+
+  // Description: Serves the complete requests of a connection's input, appending the responses to its output.
+  //              Returns false if a frame is malformed.
+  bool serve(Connection &connection);
+
+  // Description: Serves a batch of requests of the same operation: frames[first, last).
+  //              Returns false if a frame is malformed.
+  bool serveBatch(LookupOperation operation, const vector<LookupFrame> &frames, size_t first, size_t last,
+                  string &output);
+
+  // Description: Sends as much of a connection's output as the socket takes. Returns false on error.
+  static bool flush(Connection &connection);
+
+  // Description: Registers a connection for the events it waits for now (input unless paused, output if pending).
+  static void watch(Loop &loop, Connection &connection);
+
+  // Description: Closes a connection and forgets it.
+  void close(Loop &loop, Connection *connection);
+
+  // Description: Opens a non-blocking listening socket bound to address:port with SO_REUSEPORT.
+  //              Returns -1 on failure.
+  int listenOn(unsigned short aPort) const;
+
+public:
+  // Constructor
+  // Description: Prepares a server for aList on anAddress (IPv4, e.g. "127.0.0.1" or "0.0.0.0") and
+  //              aPort (0: any free port, see getPort( )), with aLoopCount loops (0: one per core).
+  //              Nothing is opened until start( ).
+  LookupServer(List &aList, const string &anAddress = "127.0.0.1", unsigned short aPort = 0, unsigned int aLoopCount = 0);
+
+  // Destructor
+  // Description: Stops the server.
+  ~LookupServer();
+
+  LookupServer(const LookupServer &) = delete;
+  LookupServer &operator=(const LookupServer &) = delete;
+
+  // Description: Opens the listening sockets and starts the loops.
+  // Exception: Throws UnableToOpenFileException if a listening socket cannot be opened (e.g. port in use).
+  void start();
+
+  // Description: Stops the loops and closes every connection and socket (waits for the loops to finish
+  //              the requests they are serving). Does nothing if the server is not running.
+  void stop();
+
+  // Description: Returns the port the server listens on (the port chosen by the system if 0 was asked).
+  unsigned short getPort() const;
+
+  // Description: Returns the number of loops.
+  unsigned int getLoopCount() const;
+
+  // Description: Returns the number of requests served so far.
+  unsigned long long getRequestCount() const;
+
+  // Description: Returns the number of open connections.
+  unsigned int getConnectionCount() const;
+};
+
+#endif
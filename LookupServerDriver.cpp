@@ -0,0 +1,72 @@
+/*
+ * LookupServerDriver.cpp
+ *
+ * Description: Serves a List of members over the network with LookupServer until interrupted.
+ *              Usage: lsd [port] [capacity] [loops] [address]
+ *              The List (capacity: size of its hash table, default 1000003) is filled from the
+ *              member files of the test driver (names.txt, randomKeys.txt, randomEmails.txt,
+ *              randomCardNums.txt), if they can be read, then served on address:port (default
+ *              127.0.0.1:7410; 0: any free port) by "loops" event loops (default: one per core).
+ *              Ctrl-C (SIGINT) or SIGTERM stops the server and prints the requests served.
+ *
+ * Author: Elaine Luu
+ * Created on: Oct. 2026
+ *
+ */
+
+#include "List.h"
+#include "LookupServer.h"
+#include "MemberIngest.h"
+#include "PhoneKey.h"
+#include <iostream>
+#include <signal.h>
+#include <string>
+
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+    unsigned short port = (argc > 1) ? stoul(argv[1]) : 7410;
+    unsigned int capacity = (argc > 2) ? stoul(argv[2]) : 1000003;
+    unsigned int loops = (argc > 3) ? stoul(argv[3]) : 0;
+    string address = (argc > 4) ? argv[4] : "127.0.0.1";
+
+    // The signals are blocked before the loops start, so that every thread inherits the mask
+    // and only sigwait( ) below receives them.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    List members(hashPhone, capacity);
+    try
+    {
+        MemberIngest ingest;
+        ingest.loadInto(members);
+    }
+    catch (exception &e)
+    {
+        cout << "Exception: " << e.what() << " (serving an empty list)" << endl;
+    }
+
+    try
+    {
+        LookupServer server(members, address, port, loops);
+        server.start();
+        cout << "Serving " << members.getElementCount() << " members on " << address << ":" << server.getPort()
+             << " with " << server.getLoopCount() << " loops (Ctrl-C to stop)" << endl;
+
+        int received = 0;
+        sigwait(&signals, &received);
+        server.stop();
+        cout << "Stopped: " << server.getRequestCount() << " requests served, " << members.getElementCount()
+             << " members" << endl;
+    }
+    catch (exception &e)
+    {
+        cout << "Exception: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
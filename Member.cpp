@@ -3,177 +3,201 @@
  *
  * Class Description: Models a Fitness Studio Registration System.
  * Class Invariant: Each member has a unique cell phone number.
+ *                  It is kept packed (PhoneKey.h) in the member itself, the hot part read by the lookup
+ *                  path; name, email and credit card token, the cold part, are a record of
+ *                  MemberColdArena::global( ) owned by the member (none while they are all empty).
  *                  This cell phone number must have 12 digits.
- *                  This cell phone number must have the following format: XXX-XXX-XXXX.
+ *                  This cell phone number must have the following format: XXX-XXX-XXXX
+ *                  (other formats are canonicalized; "000-000-0000" marks an invalid one).
  *                  This cell phone number cannot be modified.
  *
  * Author: Elaine Luu
- * Last modified: Sept. 21, 2022
+ * Last modified: Oct. 2026
  */
 
 #include <iostream>
 #include <string>
 #include "Member.h"
+#include "CardVault.h"
+#include "PhoneKey.h"
+
+// Description: Returns the packed key of aPhone, INVALID_PHONE_KEY if it is not a valid phone number.
+static unsigned long long phoneKeyOf(const string &aPhone)
+{
+    unsigned long long key;
+    normalizePhone(aPhone, key);
+    return key;
+}
 
 // Default Constructor
 // Description: Create a member with a cell phone number of "000-000-0000".
 // Postcondition: All data members set to an empty string,
 //                except the cell phone number which is set to "000-000-0000".
 Member::Member()
-    : name(""), phone("000-000-0000"), email(""), creditCard("") {}
+    : phoneKey(INVALID_PHONE_KEY), coldIndex(0) {}
 
 // Parameterized Constructor
 // Description: Create a member with the given cell phone number.
-// Postcondition: If aPhone does not have 12 digits, then aPhone is set to "000-000-0000".
-//                All other data members set to an empty string.
+// Postcondition: The cell phone number is aPhone in the canonical format XXX-XXX-XXXX if aPhone is a
+//                phone number in one of the formats accepted by normalizePhone( ) (e.g. "(604) 853-1423",
+//                "+1 604 853 1423"), "000-000-0000" otherwise.
+//                All other data members set to an empty string (no cold record: a search member
+//                costs no allocation).
 Member::Member(string aPhone)
-    : name(""), phone(aPhone), email(""), creditCard("")
-{
+    : phoneKey(phoneKeyOf(aPhone)), coldIndex(0) {}
 
-    // flag to check for invalid phone number
-    bool invalidPhone = false;
-
-    // if the length of phone number (including dash) is not 12, invalid phone number (000-000-0000)
-    if (aPhone.length() != 12)
-    {
-        invalidPhone = true;
-        aPhone = "000-000-0000";
-        setPhone(aPhone);
-    }
-
-    for (int i = 0; i < aPhone.length(); i++)
+// Parameterized Constructor
+// Description: Create a member with the given name, cell phone number, email and credit card number.
+// Postcondition: The cell phone number is aPhone in the canonical format XXX-XXX-XXXX if aPhone is a
+//                phone number in one of the formats accepted by normalizePhone( ), "000-000-0000" otherwise.
+Member::Member(string aName, string aPhone, string anEmail, string aCreditCard) //
+    : phoneKey(phoneKeyOf(aPhone)), coldIndex(0)
+{
+    unsigned long long cardToken = CardVault::global().tokenize(aCreditCard);
+    if (!aName.empty() || !anEmail.empty() || cardToken != 0)
     {
-
-        // if phone number is not a digit at every position other than 3 and 7, invalid phone number (000-000-0000)
-        if (!isdigit(aPhone[i]) && i != 3 && i != 7)
-        {
-            invalidPhone = true;
-            break;
-        }
-        // if phone number has no dash at either position 3 or 7, invalid phone number (000-000-0000)
-        if ((i == 3 && aPhone[i] != '-') || (i == 7 && aPhone[i] != '-'))
-        {
-            invalidPhone = true;
-            break;
-        }
-        else
-        {
-            invalidPhone = false;
-        }
+        MemberColdArena::Record &record = coldRecord();
+        record.name = move(aName);
+        record.email = move(anEmail);
+        record.cardToken = cardToken;
     }
+}
 
-    // setting phone number conditions
-    if (invalidPhone == false)
-    {
-        setPhone(aPhone);
-    }
-    // phone number set to 000-000-0000 if invalid
-    if (invalidPhone == true)
+// Copy Constructor
+// Description: Create a member with the same fields as other (and a cold record of its own).
+Member::Member(const Member &other)
+    : phoneKey(other.phoneKey), coldIndex(0)
+{
+    if (other.coldIndex != 0)
     {
-        aPhone = "000-000-0000";
-        setPhone(aPhone);
+        coldRecord() = MemberColdArena::global().at(other.coldIndex);
     }
 }
 
-// Parameterized Constructor
-// Description: Create a member with the given name, cell phone number, email and credit card number.
-// Postcondition: If aPhone does not have 12 digits, then aPhone is set to "000-000-0000".
-Member::Member(string aName, string aPhone, string anEmail, string aCreditCard) //
-    : name(aName), phone(aPhone), email(anEmail), creditCard(aCreditCard)
+// Move Constructor
+// Description: Create a member taking over the fields of other (its cold record included).
+Member::Member(Member &&other) noexcept
+    : phoneKey(other.phoneKey), coldIndex(other.coldIndex)
 {
+    other.coldIndex = 0;
+}
 
-    // flag to check for invalid phone number
-    bool invalidPhone = false;
-
-    // if the length of phone number (including dash) is not 12, invalid phone number (000-000-0000)
-    if (aPhone.length() != 12)
+// Destructor
+// Description: Releases the cold record of the member.
+Member::~Member()
+{
+    if (coldIndex != 0)
     {
-        invalidPhone = true;
-        aPhone = "000-000-0000";
-        setPhone(aPhone);
+        MemberColdArena::global().release(coldIndex);
     }
+}
 
-    for (int i = 0; i < aPhone.length(); i++)
+// Description: Copy assignment operator.
+Member &Member::operator=(const Member &other)
+{
+    if (this != &other)
     {
-
-        // if phone number is not a digit at every position other than 3 and 7, invalid phone number (000-000-0000)
-        if (!isdigit(aPhone[i]) && i != 3 && i != 7)
+        phoneKey = other.phoneKey;
+        if (other.coldIndex != 0)
         {
-            invalidPhone = true;
-            break;
+            coldRecord() = MemberColdArena::global().at(other.coldIndex);
         }
-        // if phone number has no dash at either position 3 or 7, invalid phone number (000-000-0000)
-        if ((i == 3 && aPhone[i] != '-') || (i == 7 && aPhone[i] != '-'))
+        else if (coldIndex != 0)
         {
-            invalidPhone = true;
-            break;
-        }
-        else
-        {
-            invalidPhone = false;
+            MemberColdArena::global().release(coldIndex);
+            coldIndex = 0;
         }
     }
+    return *this;
+}
 
-    // setting phone number conditions
-    if (invalidPhone == false)
-    {
-        setPhone(aPhone);
-    }
-    // phone number set to 000-000-0000 if invalid
-    if (invalidPhone == true)
+// Description: Move assignment operator.
+Member &Member::operator=(Member &&other) noexcept
+{
+    if (this != &other)
     {
-        aPhone = "000-000-0000";
-        setPhone(aPhone);
+        if (coldIndex != 0)
+        {
+            MemberColdArena::global().release(coldIndex);
+        }
+        phoneKey = other.phoneKey;
+        coldIndex = other.coldIndex;
+        other.coldIndex = 0;
     }
+    return *this;
 }
 
 // Getters and setter
 // Description: Returns member's name
 string Member::getName() const
 {
-    return name;
+    return (coldIndex == 0) ? string() : MemberColdArena::global().at(coldIndex).name;
 }
 
-// Description: Returns member's phone
+// Description: Returns member's phone, formatted from its packed key
 string Member::getPhone() const
 {
-    return phone;
+    char phone[SIZE_OF_PHONE_NUMBER];
+    formatPhoneKey(phoneKey, phone);
+    return string(phone, SIZE_OF_PHONE_NUMBER);
 }
 
 // Description: Returns member's email
 string Member::getEmail() const
 {
-    return email;
+    return (coldIndex == 0) ? string() : MemberColdArena::global().at(coldIndex).email;
 }
 
-// Description: Returns member's credit card
+// Description: Returns member's credit card (detokenized from the vault)
 string Member::getCreditCard() const
 {
-    return creditCard;
+    return CardVault::global().detokenize(getCardToken());
+}
+
+// Description: Returns member's credit card with every digit but the last 4 masked
+string Member::getMaskedCreditCard() const
+{
+    return CardVault::mask(getCreditCard());
+}
+
+// Description: Returns the token of member's credit card, 0 if none
+unsigned long long Member::getCardToken() const
+{
+    return (coldIndex == 0) ? 0 : MemberColdArena::global().at(coldIndex).cardToken;
 }
 
 // Description: Sets the member's name
 void Member::setName(const string aName)
 {
-    name = aName;
+    coldRecord().name = aName;
 }
 
 // Description: Sets the member's email
 void Member::setEmail(const string anEmail)
 {
-    email = anEmail;
+    coldRecord().email = anEmail;
 }
 
 // Description: Sets the member's credit card number
 void Member::setCreditCard(const string aCreditcard)
 {
-    creditCard = aCreditcard;
+    coldRecord().cardToken = CardVault::global().tokenize(aCreditcard);
 }
 
 // Description: Sets the member's cell phone number - Private method
 void Member::setPhone(const string aPhone)
 {
-    phone = aPhone;
+    phoneKey = phoneKeyOf(aPhone);
+}
+
+// Description: Returns the cold record of the member, allocating it first if there is none - Private method
+MemberColdArena::Record &Member::coldRecord()
+{
+    if (coldIndex == 0)
+    {
+        coldIndex = MemberColdArena::global().allocate();
+    }
+    return MemberColdArena::global().at(coldIndex);
 }
 
 /////////////////////
@@ -184,7 +208,7 @@ void Member::setPhone(const string aPhone)
 bool Member::operator==(const Member &rhs)
 {
 
-    return this->phone == rhs.getPhone();
+    return this->phoneKey == rhs.phoneKey;
 }
 
 // Description: Greater than operator. Compares "this" Member object with "rhs" Member object.
@@ -193,7 +217,7 @@ bool Member::operator==(const Member &rhs)
 bool Member::operator>(const Member &rhs)
 {
 
-    return this->phone > rhs.getPhone();
+    return this->phoneKey > rhs.phoneKey; // the key orders as the XXX-XXX-XXXX phone
 }
 
 // Description: Less than operator. Compares "this" Member object with "rhs" Member object.
@@ -202,16 +226,16 @@ bool Member::operator>(const Member &rhs)
 bool Member::operator<(const Member &rhs)
 {
 
-    return this->phone < rhs.getPhone();
+    return this->phoneKey < rhs.phoneKey;
 }
 
 // For testing purposes!
-// Description: Prints the content of "this".
-// Example: Louis Pace, 604-853-1423, louis@nowhere.com, 1234 5678 9098 7654
+// Description: Prints the content of "this", with the credit card masked.
+// Example: Louis Pace, 604-853-1423, louis@nowhere.com, *********7654
 ostream &operator<<(ostream &os, const Member &p)
 {
 
-    os << p.name << ", " << p.phone << ", " << p.email << ", " << p.creditCard << endl;
+    os << p.getName() << ", " << p.getPhone() << ", " << p.getEmail() << ", " << p.getMaskedCreditCard() << endl;
 
     return os;
 }
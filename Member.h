@@ -3,18 +3,23 @@
  *
  * Class Description: Models a Fitness Studio Registration System.
  * Class Invariant: Each member has a unique cell phone number.
+ *                  It is kept packed (PhoneKey.h) in the member itself, the hot part read by the lookup
+ *                  path; name, email and credit card token, the cold part, are a record of
+ *                  MemberColdArena::global( ) owned by the member (none while they are all empty).
  *                  This cell phone number must have 12 digits.
- *                  This cell phone number must have the following format: XXX-XXX-XXXX.
+ *                  This cell phone number must have the following format: XXX-XXX-XXXX
+ *                  (other formats are canonicalized; "000-000-0000" marks an invalid one).
  *                  This cell phone number cannot be modified.
  *
  * Author: Elaine Luu
- * Last modified: Sept. 21, 2022
+ * Last modified: Oct. 2026
  */
 
 #ifndef MEMBER_H
 #define MEMBER_H
 
 #include <string>
+#include "MemberColdArena.h"
 
 using namespace std;
 
@@ -26,15 +31,16 @@ class Member
 private:
     const static int SIZE_OF_PHONE_NUMBER = 12;
 
-    string name;
-    string phone;
-    string email;
-    string creditCard;
+    unsigned long long phoneKey; // Packed phone number, INVALID_PHONE_KEY (0) for "000-000-0000".
+    unsigned int coldIndex;      // Record of name, email and card token in MemberColdArena::global( ), 0 if none.
 
     // Description: Sets the member's cell phone number - Private method
     // Reflection: Why is this method not part of the public interface?
     void setPhone(const string aPhone);
 
+    // Description: Returns the cold record of the member, allocating it first if there is none.
+    MemberColdArena::Record &coldRecord();
+
 public:
     // Default Constructor
     // Description: Create a member with a cell phone number of "000-000-0000".
@@ -44,15 +50,37 @@ public:
 
     // Parameterized Constructor
     // Description: Create a member with the given cell phone number.
-    // Postcondition: If aPhone does not have 12 digits, then aPhone is set to "000-000-0000".
+    // Postcondition: The cell phone number is aPhone in the canonical format XXX-XXX-XXXX if aPhone is
+    //                a phone number in one of the formats accepted by normalizePhone( ) (PhoneKey.h),
+    //                e.g. "(604) 853-1423" or "+1 604 853 1423", "000-000-0000" otherwise.
     //                All other data members set to an empty string.
     Member(string aPhone);
 
     // Parameterized Constructor
     // Description: Create a member with the given name, cell phone number, email and credit card number.
-    // Postcondition: If aPhone does not have 12 digits, then aPhone is set to "000-000-0000".
+    // Postcondition: The cell phone number is aPhone in the canonical format XXX-XXX-XXXX if aPhone is
+    //                a phone number in one of the formats accepted by normalizePhone( ), "000-000-0000" otherwise.
+    //                List rejects a member whose phone number is "000-000-0000" (ErrorCode::INVALID_KEY).
     Member(string aName, string aPhone, string anEmail, string aCreditCard);
 
+    // Copy Constructor
+    // Description: Create a member with the same fields as other (and a cold record of its own).
+    Member(const Member &other);
+
+    // Move Constructor
+    // Description: Create a member taking over the fields of other, left with no name, email or card.
+    Member(Member &&other) noexcept;
+
+    // Destructor
+    // Description: Releases the cold record of the member.
+    ~Member();
+
+    // Description: Copy assignment operator (see the copy constructor).
+    Member &operator=(const Member &other);
+
+    // Description: Move assignment operator (see the move constructor).
+    Member &operator=(Member &&other) noexcept;
+
     // Getters and setters
     // Description: Returns member's name.
     string getName() const;
@@ -60,19 +88,34 @@ public:
     // Description: Returns member's phone.
     string getPhone() const;
 
+    // Description: Returns member's phone packed into its 10-digit key (see PhoneKey.h),
+    //              INVALID_PHONE_KEY (0) for "000-000-0000". Reads the hot part only.
+    // Time Efficiency: O(1)
+    unsigned long long getPhoneKey() const
+    {
+        return phoneKey;
+    }
+
     // Description: Returns member's email.
     string getEmail() const;
 
-    // Description: Returns member's credit card.
+    // Description: Returns member's credit card (detokenized from CardVault::global( )).
     string getCreditCard() const;
 
+    // Description: Returns member's credit card with every digit but the last 4 masked.
+    // Example: *********0123
+    string getMaskedCreditCard() const;
+
+    // Description: Returns the token of member's credit card in CardVault::global( ), 0 if none.
+    unsigned long long getCardToken() const;
+
     // Description: Sets the member's name.
     void setName(const string aName);
 
     // Description: Sets the member's email.
     void setEmail(const string anEmail);
 
-    // Description: Sets the member's credit card number.
+    // Description: Sets the member's credit card number (tokenized into CardVault::global( )).
     void setCreditCard(const string aCreditCard);
 
     // Overloaded Operators
@@ -91,8 +134,8 @@ public:
     bool operator<(const Member &rhs);
 
     // For testing purposes!
-    // Description: Prints the content of "this".
-    // Example: Louis Pace, 604-853-1423, louis@nowhere.com, 1234 5678 9098 7654
+    // Description: Prints the content of "this", with the credit card masked.
+    // Example: Louis Pace, 604-853-1423, louis@nowhere.com, *********7654
     friend ostream &operator<<(ostream &os, const Member &p);
 
 }; // end of Member.h
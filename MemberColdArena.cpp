@@ -0,0 +1,232 @@
+/*
+ * MemberColdArena.cpp
+ *
+ * Class Description: Arena of the cold fields of members (name, email, credit card token), in
+ *                    chunks that are never moved, reached by index without a lock. Each thread
+ *                    allocates from and releases to its own cache of indexes.
+ * Class Invariant: - An index is either free (in freeIndexes, or in the cache or the lease of a thread),
+ *                    or owned by exactly one Member.
+ *                  - indexCount is 1 + the number of indexes ever handed out or leased; chunks[c] is set
+ *                    for every c <= (indexCount - 1) >> CHUNK_BITS.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <algorithm>
+
+#include "MemberColdArena.h"
+#include "UnableToInsertException.h"
+
+using namespace std;
+
+// Free indexes and lease of one thread: the indexes it allocates from and releases to without the lock.
+struct MemberColdArena::ThreadCache
+{
+    MemberColdArena *arena = nullptr; // Arena the indexes belong to, nullptr if none yet.
+    vector<unsigned int> freeIndexes;  // Released indexes, reused first (their records are likely in cache).
+    unsigned int leaseNext = 0;        // Next never used index of the lease.
+    unsigned int leaseEnd = 0;         // End of the lease (leaseNext == leaseEnd: lease used up).
+
+    // Description: Gives the free indexes back to the arena.
+    ~ThreadCache()
+    {
+        if (arena != nullptr)
+        {
+            arena->giveBack(*this);
+        }
+    }
+};
+
+// Cache of the calling thread (for the arena it used last), created on first use.
+static thread_local MemberColdArena::ThreadCache *threadCache = nullptr;
+// Set once the thread's cache was given back at thread exit: later calls (e.g. members destroyed
+// by static objects) go to the arena directly.
+static thread_local bool threadExiting = false;
+
+// Gives the cache of a thread back to its arena when the thread exits.
+struct ThreadCacheReaper
+{
+    ~ThreadCacheReaper()
+    {
+        delete threadCache;
+        threadCache = nullptr;
+        threadExiting = true;
+    }
+};
+static thread_local ThreadCacheReaper threadCacheReaper;
+
+// Constructor
+MemberColdArena::MemberColdArena()
+{
+    chunks = new atomic<Record *>[MAX_CHUNKS];
+    for (unsigned int c = 0; c < MAX_CHUNKS; c++)
+    {
+        chunks[c].store(nullptr, memory_order_relaxed);
+    }
+}
+
+// Destructor
+MemberColdArena::~MemberColdArena()
+{
+    for (unsigned int c = 0; c < MAX_CHUNKS; c++)
+    {
+        delete[] chunks[c].load(memory_order_relaxed);
+    }
+    delete[] chunks;
+}
+
+// Description: Returns the arena used by Member (created on first use).
+//              It is never destroyed, so that members destroyed at exit (e.g. by a static List)
+//              still find it.
+MemberColdArena &MemberColdArena::global()
+{
+    static MemberColdArena *arena = new MemberColdArena();
+    return *arena;
+}
+
+// Description: Returns the index of an empty record, now owned by the caller.
+//              A free index of the thread's cache is reused first; otherwise the next index of its lease.
+//              The arena is only locked to refill the cache or the lease.
+// Exception: Throws UnableToInsertException if the arena holds 2^32 - 1 records.
+unsigned int MemberColdArena::allocate()
+{
+    ThreadCache local; // for a thread that is exiting: given back at once
+    ThreadCache *cache = cacheOfThisThread();
+    if (cache == nullptr)
+    {
+        local.arena = this;
+        cache = &local;
+    }
+
+    if (cache->freeIndexes.empty() && cache->leaseNext == cache->leaseEnd)
+    {
+        refill(*cache);
+    }
+    unsigned int index;
+    if (!cache->freeIndexes.empty())
+    {
+        index = cache->freeIndexes.back();
+        cache->freeIndexes.pop_back();
+    }
+    else
+    {
+        index = cache->leaseNext++;
+    }
+    recordCount.fetch_add(1, memory_order_relaxed);
+    return index;
+}
+
+// Description: Empties the record of index and frees index, into the thread's cache. The strings give
+//              their memory back. A cache holding CACHE_LIMIT indexes gives half of them back to the arena.
+void MemberColdArena::release(unsigned int index)
+{
+    Record &record = at(index);
+    string().swap(record.name);
+    string().swap(record.email);
+    record.cardToken = 0;
+    recordCount.fetch_sub(1, memory_order_relaxed);
+
+    ThreadCache local; // for a thread that is exiting: given back at once
+    ThreadCache *cache = cacheOfThisThread();
+    if (cache == nullptr)
+    {
+        local.arena = this;
+        cache = &local;
+    }
+
+    cache->freeIndexes.push_back(index);
+    if (cache->freeIndexes.size() >= CACHE_LIMIT)
+    {
+        lock_guard<mutex> guard(lock);
+        freeIndexes.insert(freeIndexes.end(), cache->freeIndexes.end() - CACHE_LIMIT / 2, cache->freeIndexes.end());
+        cache->freeIndexes.resize(cache->freeIndexes.size() - CACHE_LIMIT / 2);
+    }
+}
+
+// Description: Returns the number of records owned.
+unsigned int MemberColdArena::getRecordCount() const
+{
+    return recordCount.load(memory_order_relaxed);
+}
+
+// Description: Returns the memory used by the chunks and the directory in bytes.
+unsigned long long MemberColdArena::getMemoryUsage() const
+{
+    lock_guard<mutex> guard(lock);
+    unsigned long long chunkCount = (indexCount == 0) ? MAX_CHUNKS : (indexCount == 1) ? 0 : ((indexCount - 1) >> CHUNK_BITS) + 1;
+    return sizeof(atomic<Record *>) * MAX_CHUNKS + chunkCount * CHUNK_SIZE * sizeof(Record) +
+           sizeof(unsigned int) * freeIndexes.capacity();
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Refills the cache of a thread: with up to LEASE_SIZE free indexes given back by the threads if
+//              there are any, otherwise with a lease of the next LEASE_SIZE never used indexes (allocating
+//              the chunks they fall in).
+// Exception: Throws UnableToInsertException if every index is owned.
+void MemberColdArena::refill(ThreadCache &cache)
+{
+    lock_guard<mutex> guard(lock);
+    if (!freeIndexes.empty())
+    {
+        unsigned int count = min<size_t>(LEASE_SIZE, freeIndexes.size());
+        cache.freeIndexes.insert(cache.freeIndexes.end(), freeIndexes.end() - count, freeIndexes.end());
+        freeIndexes.resize(freeIndexes.size() - count);
+        return;
+    }
+    if (indexCount == 0) // wrapped around: every index is owned or leased
+    {
+        throw UnableToInsertException("The member arena is full.");
+    }
+
+    unsigned long long end = min<unsigned long long>((unsigned long long)indexCount + LEASE_SIZE, 1ULL << 32);
+    for (unsigned long long c = indexCount >> CHUNK_BITS; c <= (end - 1) >> CHUNK_BITS; c++)
+    {
+        if (chunks[c].load(memory_order_relaxed) == nullptr)
+        {
+            chunks[c].store(new Record[CHUNK_SIZE], memory_order_release);
+        }
+    }
+    cache.leaseNext = indexCount;
+    cache.leaseEnd = (unsigned int)end; // 0 if the lease ends at 2^32
+    indexCount = (unsigned int)end;
+}
+
+// Description: Gives every free index of a thread (its cache and the rest of its lease) back to the arena.
+void MemberColdArena::giveBack(ThreadCache &cache)
+{
+    lock_guard<mutex> guard(lock);
+    freeIndexes.insert(freeIndexes.end(), cache.freeIndexes.begin(), cache.freeIndexes.end());
+    for (unsigned int index = cache.leaseNext; index != cache.leaseEnd; index++)
+    {
+        freeIndexes.push_back(index);
+    }
+    cache.freeIndexes.clear();
+    cache.leaseNext = cache.leaseEnd = 0;
+}
+
+// Description: Returns the cache of the calling thread, switched to this arena (the indexes of the arena it
+//              used before given back), nullptr once the thread is exiting.
+MemberColdArena::ThreadCache *MemberColdArena::cacheOfThisThread()
+{
+    if (threadExiting)
+    {
+        return nullptr;
+    }
+    if (threadCache == nullptr)
+    {
+        (void)&threadCacheReaper; // registers the reaper of this thread
+        threadCache = new ThreadCache();
+        threadCache->freeIndexes.reserve(CACHE_LIMIT);
+    }
+    if (threadCache->arena != this)
+    {
+        if (threadCache->arena != nullptr)
+        {
+            threadCache->arena->giveBack(*threadCache);
+        }
+        threadCache->arena = this;
+    }
+    return threadCache;
+}
@@ -0,0 +1,117 @@
+/*
+ * MemberColdArena.h
+ *
+ * Class Description: Arena of the cold fields of members (name, email, credit card token): the fields
+ *                    the lookup path never reads. Member keeps only its packed phone number and the
+ *                    index of its record here, so that the members the hash table compares keys against
+ *                    are 16 bytes instead of three strings and a token.
+ *                    Records live in chunks of CHUNK_SIZE, allocated as the arena grows and never moved:
+ *                    a record is reached through a fixed directory of chunks, without a lock.
+ *                    Index 0 is never allocated: it stands for "no record" (empty name and email, no card).
+ *                    allocate( ) and release( ) may be called concurrently, and do not take the arena's
+ *                    lock in the common case: each thread keeps a cache of free indexes and a lease of
+ *                    LEASE_SIZE never used indexes, and only goes to the arena to refill the cache or
+ *                    the lease, or to give back CACHE_LIMIT / 2 free indexes once it holds CACHE_LIMIT.
+ *                    A thread gives back its cache and the rest of its lease when it exits, so an arena
+ *                    must outlive the threads that used it (global( ) is never destroyed).
+ *                    A record is read and written by the owner of its index only (as the fields of a
+ *                    Member were).
+ * Class Invariant: - An index is either free (in freeIndexes, or in the cache or the lease of a thread),
+ *                    or owned by exactly one Member.
+ *                  - indexCount is 1 + the number of indexes ever handed out or leased; chunks[c] is set
+ *                    for every c <= (indexCount - 1) >> CHUNK_BITS.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef MEMBER_COLD_ARENA_H
+#define MEMBER_COLD_ARENA_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using std::atomic;
+using std::mutex;
+using std::string;
+using std::vector;
+
+class MemberColdArena
+{
+
+public:
+  // Cold fields of one member.
+  struct Record
+  {
+    string name;
+    string email;
+    unsigned long long cardToken = 0; // Token in CardVault::global( ), 0 if none.
+  };
+
+  // Free indexes and lease of one thread (see MemberColdArena.cpp).
+  struct ThreadCache;
+
+  const static unsigned int CHUNK_BITS = 14;
+  const static unsigned int CHUNK_SIZE = 1u << CHUNK_BITS; // Records per chunk.
+  const static unsigned int MAX_CHUNKS = 1u << 18;         // Up to 2^32 records.
+  const static unsigned int LEASE_SIZE = 256;              // Indexes a thread takes from the arena at a time.
+  const static unsigned int CACHE_LIMIT = 2 * LEASE_SIZE;  // Free indexes a thread keeps at most.
+
+private:
+  atomic<Record *> *chunks;            // Directory of MAX_CHUNKS chunks, nullptr until allocated.
+  unsigned int indexCount = 1;         // Next index never handed out or leased (0 is reserved).
+  atomic<unsigned int> recordCount{0}; // Indexes owned.
+  vector<unsigned int> freeIndexes;    // Released indexes given back by the threads, reused first.
+  mutable mutex lock;                  // Guards indexCount and freeIndexes.
+
+  // Description: Refills the cache of a thread with free indexes, or else with a new lease.
+  // Exception: Throws UnableToInsertException if every index is owned.
+  void refill(ThreadCache &cache);
+
+  // Description: Gives every free index of a thread (cache and rest of its lease) back to the arena.
+  void giveBack(ThreadCache &cache);
+
+  // Description: Returns the cache of the calling thread for this arena, nullptr once the thread is exiting.
+  ThreadCache *cacheOfThisThread();
+
+public:
+  // Constructor
+  // Description: Creates an empty arena (no chunk allocated yet).
+  MemberColdArena();
+
+  // Destructor
+  ~MemberColdArena();
+
+  MemberColdArena(const MemberColdArena &) = delete;
+  MemberColdArena &operator=(const MemberColdArena &) = delete;
+
+  // Description: Returns the arena used by Member.
+  static MemberColdArena &global();
+
+  // Description: Returns the index of an empty record, now owned by the caller.
+  // Time Efficiency: O(1), without the lock but once every LEASE_SIZE calls (or so) per thread
+  // Exception: Throws UnableToInsertException if the arena holds 2^32 - 1 records.
+  unsigned int allocate();
+
+  // Description: Empties the record of index (not 0) and frees index.
+  // Time Efficiency: O(1), without the lock but once every LEASE_SIZE calls (or so) per thread
+  void release(unsigned int index);
+
+  // Description: Returns the record of index (not 0, owned by the caller).
+  // Time Efficiency: O(1), no lock
+  Record &at(unsigned int index) const
+  {
+    return chunks[index >> CHUNK_BITS].load(std::memory_order_acquire)[index & (CHUNK_SIZE - 1)];
+  }
+
+  // Description: Returns the number of records owned.
+  unsigned int getRecordCount() const;
+
+  // Description: Returns the memory used by the chunks and the directory in bytes (not counting
+  //              names and emails too long for a string's inline buffer).
+  unsigned long long getMemoryUsage() const;
+};
+
+#endif
@@ -0,0 +1,301 @@
+/*
+ * MemberIndex.cpp
+ *
+ * Class Description: Secondary index over the members stored in a List.
+ *                    Maps a string key computed from a Member (e.g. its email or its
+ *                    case-folded name) to that Member using open addressing (linear probing).
+ *                    The index only stores pointers to the Member objects owned by the List:
+ *                    member records are never duplicated.
+ *                    There is one entry per distinct key: members sharing a key (e.g. a common name)
+ *                    are kept in the list of that key's entry, so that they do not lengthen the
+ *                    probe sequence of one another.
+ *                    The empty key ("no email", "no name") is never indexed.
+ * Class Invariant: - Each stored pointer appears once.
+ *                  - No two entries have the same key.
+ *                  - If the index is unique, every entry holds one member.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <string>
+
+#include "MemberIndex.h"
+#include "ElementAlreadyExistsException.h"
+
+const static unsigned int INITIAL_CAPACITY = 64;
+
+// Constructor
+// Description: Creates an empty index on the key computed by keyFcn.
+MemberIndex::MemberIndex(string (*keyFcn)(const Member &), bool isUnique)
+    : capacity(INITIAL_CAPACITY), keyOf(keyFcn), unique(isUnique)
+{
+    entries = new Entry[capacity];
+    for (unsigned int i = 0; i < capacity; i++)
+    {
+        entries[i].hashCode = 0;
+        entries[i].element = nullptr;
+        entries[i].others = nullptr;
+    }
+}
+
+// Destructor
+// Description: Releases the index. The indexed members are not deleted.
+MemberIndex::~MemberIndex()
+{
+    for (unsigned int i = 0; i < capacity; i++)
+    {
+        delete entries[i].others;
+    }
+    delete[] entries;
+    entries = nullptr;
+}
+
+// Description: Returns the number of members indexed.
+unsigned int MemberIndex::getElementCount() const
+{
+    return elementCount;
+}
+
+// Description: Adds a member to the index using its current key.
+//              A member whose key is empty is not indexed.
+// Exception: Throws ElementAlreadyExistsException if the index is unique and another
+//            member already has the same key.
+void MemberIndex::insert(Member &element)
+{
+    string key = keyOf(element);
+    if (key.empty())
+    {
+        return;
+    }
+
+    unsigned long long hashCode = hashKey(key);
+    unsigned int index = locate(key, hashCode);
+    if (entries[index].element != nullptr)
+    {
+        if (unique)
+        {
+            throw ElementAlreadyExistsException("Unable to index element. Key already exists.");
+        }
+        if (entries[index].others == nullptr)
+        {
+            entries[index].others = new vector<Member *>();
+        }
+        entries[index].others->push_back(&element);
+        elementCount++;
+        return;
+    }
+
+    // A new key: keep the load at or below 1/2 so that clusters stay short.
+    if (2 * (keyCount + 1) > capacity)
+    {
+        grow();
+        index = locate(key, hashCode);
+    }
+    entries[index].hashCode = hashCode;
+    entries[index].element = &element;
+    entries[index].others = nullptr;
+    keyCount++;
+    elementCount++;
+}
+
+// Description: Removes a member from the index. Must be called while the member still
+//              has the key it was indexed with.
+bool MemberIndex::remove(Member &element)
+{
+    string key = keyOf(element);
+    if (key.empty())
+    {
+        return false;
+    }
+
+    unsigned int index = locate(key, hashKey(key));
+    Entry &entry = entries[index];
+    if (entry.element == nullptr)
+    {
+        return false;
+    }
+
+    if (entry.element != &element)
+    {
+        if (entry.others == nullptr)
+        {
+            return false;
+        }
+        vector<Member *> &others = *entry.others;
+        unsigned int i = 0;
+        while (i < others.size() && others[i] != &element)
+        {
+            i++;
+        }
+        if (i == others.size())
+        {
+            return false;
+        }
+        others[i] = others.back();
+        others.pop_back();
+    }
+    else if (entry.others != nullptr && !entry.others->empty())
+    {
+        entry.element = entry.others->back();
+        entry.others->pop_back();
+    }
+    else
+    {
+        erase(index);
+        keyCount--;
+        elementCount--;
+        return true;
+    }
+
+    if (entry.others->empty())
+    {
+        delete entry.others;
+        entry.others = nullptr;
+    }
+    elementCount--;
+    return true;
+}
+
+// Description: Returns a member whose key is key, nullptr if there is none (or key is empty).
+Member *MemberIndex::find(const string &key) const
+{
+    if (key.empty())
+    {
+        return nullptr;
+    }
+    return entries[locate(key, hashKey(key))].element;
+}
+
+// Description: Appends every member whose key is key to results and returns how many were found.
+unsigned int MemberIndex::findAll(const string &key, vector<Member *> &results) const
+{
+    if (key.empty())
+    {
+        return 0;
+    }
+
+    const Entry &entry = entries[locate(key, hashKey(key))];
+    if (entry.element == nullptr)
+    {
+        return 0;
+    }
+    results.push_back(entry.element);
+    if (entry.others == nullptr)
+    {
+        return 1;
+    }
+    results.insert(results.end(), entry.others->begin(), entry.others->end());
+    return 1 + (unsigned int)entry.others->size();
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Hash code of a key (FNV-1a).
+unsigned long long MemberIndex::hashKey(const string &key)
+{
+    unsigned long long hashCode = 0xcbf29ce484222325ULL;
+    for (unsigned int i = 0; i < key.length(); i++)
+    {
+        hashCode ^= (unsigned char)key[i];
+        hashCode *= 0x100000001b3ULL;
+    }
+    // FNV's low bits are weak for short keys; fold the high bits in.
+    return hashCode ^ (hashCode >> 32);
+}
+
+// Description: Returns the cell of the entry of key, or the empty cell ending its probe sequence.
+unsigned int MemberIndex::locate(const string &key, unsigned long long hashCode) const
+{
+    unsigned int mask = capacity - 1;
+    unsigned int index = (unsigned int)hashCode & mask;
+    while (entries[index].element != nullptr)
+    {
+        if (entries[index].hashCode == hashCode && keyOf(*entries[index].element) == key)
+        {
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+// Description: Empties the cell at index, moving the entries following it back (backward shift):
+//              an entry may fill the hole only if its home is not between the hole and the entry
+//              (cyclically), so that no probe sequence is broken and no tombstone is needed.
+void MemberIndex::erase(unsigned int index)
+{
+    unsigned int mask = capacity - 1;
+    unsigned int hole = index;
+    unsigned int next = (hole + 1) & mask;
+    while (entries[next].element != nullptr)
+    {
+        unsigned int home = (unsigned int)entries[next].hashCode & mask;
+        if (((next - home) & mask) >= ((next - hole) & mask))
+        {
+            entries[hole] = entries[next];
+            hole = next;
+        }
+        next = (next + 1) & mask;
+    }
+    entries[hole].hashCode = 0;
+    entries[hole].element = nullptr;
+    entries[hole].others = nullptr;
+}
+
+// Description: Doubles the capacity and re-inserts every entry.
+void MemberIndex::grow()
+{
+    Entry *oldEntries = entries;
+    unsigned int oldCapacity = capacity;
+
+    capacity *= 2;
+    entries = new Entry[capacity];
+    for (unsigned int i = 0; i < capacity; i++)
+    {
+        entries[i].hashCode = 0;
+        entries[i].element = nullptr;
+        entries[i].others = nullptr;
+    }
+
+    unsigned int mask = capacity - 1;
+    for (unsigned int i = 0; i < oldCapacity; i++)
+    {
+        if (oldEntries[i].element != nullptr)
+        {
+            unsigned int index = (unsigned int)oldEntries[i].hashCode & mask;
+            while (entries[index].element != nullptr)
+            {
+                index = (index + 1) & mask;
+            }
+            entries[index] = oldEntries[i];
+        }
+    }
+    delete[] oldEntries;
+}
+
+// Description: Email key: the email as stored.
+string emailKey(const Member &element)
+{
+    return element.getEmail();
+}
+
+// Description: Case-folded name key: the name with letters converted to lower case.
+string foldedNameKey(const Member &element)
+{
+    return foldCase(element.getName());
+}
+
+// Description: Converts letters to lower case, so that "Zoey Combs" and "zoey combs" match.
+string foldCase(const string &text)
+{
+    string folded = text;
+    for (unsigned int i = 0; i < folded.length(); i++)
+    {
+        if (folded[i] >= 'A' && folded[i] <= 'Z')
+        {
+            folded[i] = folded[i] - 'A' + 'a';
+        }
+    }
+    return folded;
+}
@@ -0,0 +1,107 @@
+/*
+ * MemberIndex.h
+ *
+ * Class Description: Secondary index over the members stored in a List.
+ *                    Maps a string key computed from a Member (e.g. its email or its
+ *                    case-folded name) to that Member using open addressing (linear probing).
+ *                    The index only stores pointers to the Member objects owned by the List:
+ *                    member records are never duplicated.
+ *                    There is one entry per distinct key: members sharing a key (e.g. a common name)
+ *                    are kept in the list of that key's entry, so that they do not lengthen the
+ *                    probe sequence of one another.
+ *                    The empty key ("no email", "no name") is never indexed.
+ * Class Invariant: - Each stored pointer appears once.
+ *                  - No two entries have the same key.
+ *                  - If the index is unique, every entry holds one member.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef MEMBER_INDEX_H
+#define MEMBER_INDEX_H
+
+#include <string>
+#include <vector>
+#include "Member.h"
+
+using std::vector;
+
+class MemberIndex
+{
+
+private:
+  struct Entry
+  {
+    unsigned long long hashCode; // Hash code of the key, cached so that probing rarely builds keys.
+    Member *element;             // First member with the key, nullptr marks an empty cell.
+    vector<Member *> *others;    // Other members with the key, nullptr if there are none.
+  };
+
+  Entry *entries = nullptr;             // Underlying data structure (array).
+  unsigned int capacity = 0;            // Size of entries, always a power of 2.
+  unsigned int elementCount = 0;        // Current number of members indexed.
+  unsigned int keyCount = 0;            // Current number of entries (distinct keys).
+  string (*keyOf)(const Member &);      // Computes the indexing key of a member.
+  bool unique;                          // Whether two members may share a key.
+
+  // Description: Hash code of a key (FNV-1a).
+  static unsigned long long hashKey(const string &key);
+
+  // Description: Returns the cell of the entry of key, or the empty cell ending its probe sequence.
+  unsigned int locate(const string &key, unsigned long long hashCode) const;
+
+  // Description: Empties the cell at index, moving the entries following it back (backward shift).
+  void erase(unsigned int index);
+
+  // Description: Doubles the capacity and re-inserts every entry.
+  void grow();
+
+public:
+  // Constructor
+  // Description: Creates an empty index on the key computed by keyFcn.
+  MemberIndex(string (*keyFcn)(const Member &), bool isUnique);
+
+  // Destructor
+  // Description: Releases the index. The indexed members are not deleted.
+  ~MemberIndex();
+
+  MemberIndex(const MemberIndex &) = delete;
+  MemberIndex &operator=(const MemberIndex &) = delete;
+
+  // Description: Returns the number of members indexed.
+  unsigned int getElementCount() const;
+
+  // Description: Adds a member to the index using its current key.
+  //              A member whose key is empty is not indexed.
+  // Postcondition: element can be found through its key.
+  // Time Efficiency: O(1) expected, whatever the number of members sharing the key
+  // Exception: Throws ElementAlreadyExistsException if the index is unique and another
+  //            member already has the same key.
+  void insert(Member &element);
+
+  // Description: Removes a member from the index. Must be called while the member still
+  //              has the key it was indexed with.
+  // Postcondition: Returns false if the member was not indexed.
+  // Time Efficiency: O(1) expected, plus O(k) for a key shared by k members
+  bool remove(Member &element);
+
+  // Description: Returns a member whose key is key, nullptr if there is none (or key is empty).
+  Member *find(const string &key) const;
+
+  // Description: Appends every member whose key is key to results and returns how many were found.
+  unsigned int findAll(const string &key, vector<Member *> &results) const;
+
+}; // end MemberIndex.h
+
+// Description: Key functions for the indexes maintained by List.
+// Email key: the email as stored.
+string emailKey(const Member &element);
+
+// Case-folded name key: the name with letters converted to lower case.
+string foldedNameKey(const Member &element);
+
+// Description: Converts letters to lower case, so that "Zoey Combs" and "zoey combs" match.
+string foldCase(const string &text);
+
+#endif
@@ -0,0 +1,343 @@
+/*
+ * MemberIngest.cpp
+ *
+ * Class Description: Bulk load of members from the four member files into a List: chunked
+ *                    asynchronous reads (AsyncReader), parsing overlapped with the reads still
+ *                    in flight, batched insertion.
+ * Class Invariant: - The i-th member inserted is made of the i-th record of each file.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "MemberIngest.h"
+#include "ErrorCode.h"
+#include "PhoneKey.h"
+#include "UnableToOpenFileException.h"
+
+using namespace std;
+
+// Fields of one record in each file: names (first and last name), phones, emails, cards.
+static const unsigned int FIELDS_PER_RECORD[MemberIngest::FILE_COUNT] = {2, 1, 1, 1};
+
+// Description: Returns true for the white space separating fields (as isspace( ) in the "C" locale).
+static inline bool isSpace(char c)
+{
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// Description: Returns true for the line breaks separating the fields of a stream of whole lines.
+static inline bool isLineBreak(char c)
+{
+    return c == '\n' || c == '\r';
+}
+
+// Constructor
+MemberIngest::MemberIngest(const string &namesFile, const string &phonesFile, const string &emailsFile,
+                           const string &cardsFile, bool anAllowIoUring)
+    : allowIoUring(anAllowIoUring)
+{
+    streams[0].fileName = namesFile;
+    streams[1].fileName = phonesFile;
+    streams[1].wholeLines = true;
+    streams[2].fileName = emailsFile;
+    streams[3].fileName = cardsFile;
+}
+
+// Destructor
+MemberIngest::~MemberIngest()
+{
+    release();
+}
+
+// Description: Reads the files and inserts their members into list.
+//              Each completion is parsed right away (if its chunk is next in its file) and its buffer
+//              reused for a further chunk, so parsing overlaps the reads in flight.
+// Exception: Throws UnableToOpenFileException if a file cannot be opened or read.
+void MemberIngest::loadInto(List &list)
+{
+    release();
+    usedIoUring = false;
+    bytesRead = 0;
+    loadedCount = 0;
+    rejectedCount = 0;
+
+    for (unsigned int f = 0; f < FILE_COUNT; f++)
+    {
+        Stream &stream = streams[f];
+        struct stat status;
+        stream.fd = open(stream.fileName.c_str(), O_RDONLY | O_CLOEXEC);
+        if (stream.fd < 0 || fstat(stream.fd, &status) != 0)
+        {
+            release();
+            throw UnableToOpenFileException();
+        }
+        stream.size = (unsigned long long)status.st_size;
+        stream.nextChunk = 0;
+        stream.parsedChunks = 0;
+        for (unsigned int s = 0; s < CHUNKS_PER_FILE; s++)
+        {
+            stream.slots[s] = Slot();
+            stream.slots[s].buffer = (char *)aligned_alloc(4096, CHUNK_SIZE);
+        }
+    }
+
+    bool failed = false;
+    vector<Member *> batch;
+    batch.reserve(BATCH);
+    {
+        AsyncReader reader(FILE_COUNT * CHUNKS_PER_FILE, allowIoUring);
+        usedIoUring = reader.usesIoUring();
+        for (unsigned int f = 0; f < FILE_COUNT; f++)
+        {
+            for (unsigned int s = 0; s < CHUNKS_PER_FILE && streams[f].nextChunk * CHUNK_SIZE < streams[f].size; s++)
+            {
+                readNextChunk(reader, f, s);
+            }
+        }
+
+        while (reader.getInFlightCount() > 0)
+        {
+            AsyncReader::Completion completion = reader.wait();
+            unsigned int f = (unsigned int)(completion.tag / CHUNKS_PER_FILE);
+            Stream &stream = streams[f];
+            Slot &slot = stream.slots[completion.tag % CHUNKS_PER_FILE];
+            if (completion.result <= 0 || failed) // read error, or file truncated while being read
+            {
+                failed = true;
+                continue; // let the other reads finish before the buffers are released
+            }
+
+            slot.filled += (unsigned int)completion.result;
+            bytesRead += (unsigned long long)completion.result;
+            if (slot.filled < slot.expected) // short read: read the rest
+            {
+                reader.submit(stream.fd, slot.buffer + slot.filled, slot.expected - slot.filled,
+                              slot.chunk * CHUNK_SIZE + slot.filled, completion.tag);
+                continue;
+            }
+            slot.reading = false;
+            parseReadyChunks(reader, f);
+            assembleMembers(list, batch);
+        }
+    }
+
+    if (failed)
+    {
+        insertBatch(list, batch);
+        release();
+        throw UnableToOpenFileException();
+    }
+
+    // The last field of a file may not be followed by white space.
+    for (unsigned int f = 0; f < FILE_COUNT; f++)
+    {
+        if (!streams[f].partial.empty())
+        {
+            streams[f].fields.push_back(move(streams[f].partial));
+            streams[f].partial.clear();
+        }
+    }
+    assembleMembers(list, batch);
+    insertBatch(list, batch);
+    release();
+}
+
+// Description: Returns true if the last load read through io_uring.
+bool MemberIngest::usesIoUring() const
+{
+    return usedIoUring;
+}
+
+// Description: Returns the number of bytes read by the last load.
+unsigned long long MemberIngest::getBytesRead() const
+{
+    return bytesRead;
+}
+
+// Description: Returns the number of members inserted by the last load.
+unsigned int MemberIngest::getLoadedCount() const
+{
+    return loadedCount;
+}
+
+// Description: Returns the number of members the last load could not insert.
+unsigned int MemberIngest::getRejectedCount() const
+{
+    return rejectedCount;
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Queues the read of the next chunk of a stream into one of its slots
+//              (chunk c always goes to slot c % CHUNKS_PER_FILE).
+void MemberIngest::readNextChunk(AsyncReader &reader, unsigned int file, unsigned int slot)
+{
+    Stream &stream = streams[file];
+    Slot &target = stream.slots[slot];
+    target.chunk = stream.nextChunk++;
+    unsigned long long offset = target.chunk * CHUNK_SIZE;
+    target.expected = (unsigned int)min((unsigned long long)CHUNK_SIZE, stream.size - offset);
+    target.filled = 0;
+    target.reading = true;
+    reader.submit(stream.fd, target.buffer, target.expected, offset, file * CHUNKS_PER_FILE + slot);
+}
+
+// Description: Parses, in order, the chunks of a stream that have been read completely, and reads
+//              the next chunks of the file into their slots.
+void MemberIngest::parseReadyChunks(AsyncReader &reader, unsigned int file)
+{
+    Stream &stream = streams[file];
+    while (stream.parsedChunks < stream.nextChunk)
+    {
+        unsigned int s = (unsigned int)(stream.parsedChunks % CHUNKS_PER_FILE);
+        Slot &slot = stream.slots[s];
+        if (slot.reading)
+        {
+            return; // the next chunk in order is still in flight
+        }
+        parseFields(stream, slot.buffer, slot.buffer + slot.filled);
+        stream.parsedChunks++;
+        if (stream.nextChunk * CHUNK_SIZE < stream.size)
+        {
+            readNextChunk(reader, file, s);
+        }
+    }
+}
+
+// Description: Splits [first, last) into fields separated by white space, or by line breaks if
+//              stream.wholeLines. The first field continues the partial field of the previous chunk;
+//              a field reaching last becomes the partial field.
+void MemberIngest::parseFields(Stream &stream, const char *first, const char *last)
+{
+    const char *p = first;
+    while (p < last)
+    {
+        const char *start = p;
+        if (stream.wholeLines)
+        {
+            while (p < last && !isLineBreak(*p))
+            {
+                p++;
+            }
+        }
+        else
+        {
+            while (p < last && !isSpace(*p))
+            {
+                p++;
+            }
+        }
+        if (p == last)
+        {
+            stream.partial.append(start, p);
+            return;
+        }
+        if (!stream.partial.empty())
+        {
+            stream.partial.append(start, p);
+            stream.fields.push_back(move(stream.partial));
+            stream.partial.clear();
+        }
+        else if (p > start)
+        {
+            stream.fields.emplace_back(start, p);
+        }
+        p++;
+    }
+}
+
+// Description: Takes the members whose fields have all been parsed into batch, inserting full batches.
+void MemberIngest::assembleMembers(List &list, vector<Member *> &batch)
+{
+    while (true)
+    {
+        for (unsigned int f = 0; f < FILE_COUNT; f++)
+        {
+            if (streams[f].fields.size() < FIELDS_PER_RECORD[f])
+            {
+                return;
+            }
+        }
+
+        // The phone is normalized here, so that an invalid record is rejected before its member is made.
+        string &phone = streams[1].fields.front();
+        unsigned long long key;
+        if (normalizePhone(phone, key))
+        {
+            phone.resize(12);
+            formatPhoneKey(key, &phone[0]);
+            deque<string> &names = streams[0].fields;
+            string name = move(names[0]);
+            name += ' ';
+            name += names[1];
+            batch.push_back(new Member(move(name), move(phone), move(streams[2].fields.front()),
+                                       move(streams[3].fields.front())));
+        }
+        else
+        {
+            cout << "Exception: " << errorMessage(ErrorCode::INVALID_KEY) << endl;
+            rejectedCount++;
+        }
+        streams[0].fields.pop_front();
+        streams[0].fields.pop_front();
+        for (unsigned int f = 1; f < FILE_COUNT; f++)
+        {
+            streams[f].fields.pop_front();
+        }
+
+        if (batch.size() == BATCH)
+        {
+            insertBatch(list, batch);
+        }
+    }
+}
+
+// Description: Inserts batch into list, reporting and deleting the members not inserted, then empties batch.
+void MemberIngest::insertBatch(List &list, vector<Member *> &batch)
+{
+    vector<ErrorCode> codes(batch.size());
+    list.insertMany(batch.data(), codes.data(), (unsigned int)batch.size());
+    for (unsigned int i = 0; i < batch.size(); i++)
+    {
+        if (codes[i] == ErrorCode::OK)
+        {
+            loadedCount++;
+        }
+        else
+        {
+            cout << "Exception: " << errorMessage(codes[i]) << endl;
+            delete batch[i];
+            rejectedCount++;
+        }
+    }
+    batch.clear();
+}
+
+// Description: Closes the files and releases the buffers.
+void MemberIngest::release()
+{
+    for (unsigned int f = 0; f < FILE_COUNT; f++)
+    {
+        Stream &stream = streams[f];
+        if (stream.fd >= 0)
+        {
+            close(stream.fd);
+            stream.fd = -1;
+        }
+        for (unsigned int s = 0; s < CHUNKS_PER_FILE; s++)
+        {
+            free(stream.slots[s].buffer);
+            stream.slots[s].buffer = nullptr;
+        }
+        stream.partial.clear();
+        stream.fields.clear();
+    }
+}
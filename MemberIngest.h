@@ -0,0 +1,129 @@
+/*
+ * MemberIngest.h
+ *
+ * Class Description: Bulk load of members from the four member files of the test driver (names,
+ *                    phone numbers, emails and credit card numbers, record i of each file making
+ *                    member i) into a List.
+ *                    The files are read in CHUNK_SIZE chunks at aligned offsets, CHUNKS_PER_FILE
+ *                    reads in flight per file, through AsyncReader (io_uring, or a pread( ) pool).
+ *                    Each chunk is parsed as soon as it (and the chunks before it in its file) has
+ *                    arrived, while the following reads are in flight; members are inserted
+ *                    BATCH at a time with List::insertMany( ).
+ *                    Fields are separated by white space, as read by operator>> in the test driver:
+ *                    a names record is two fields (first and last name), the others one field;
+ *                    except phone numbers, one per line, in any format accepted by normalizePhone( )
+ *                    (e.g. "(604) 853-1423"). A record whose phone number is invalid is rejected.
+ *                    Loading stops at the end of the shortest file.
+ * Class Invariant: - The i-th member inserted is made of the i-th record of each file.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef MEMBER_INGEST_H
+#define MEMBER_INGEST_H
+
+#include <deque>
+#include <string>
+#include <vector>
+#include "List.h"
+#include "AsyncReader.h"
+
+using std::deque;
+using std::string;
+using std::vector;
+
+class MemberIngest
+{
+
+public:
+  const static unsigned int FILE_COUNT = 4;
+  const static unsigned int CHUNK_SIZE = 1 << 20;   // Bytes per read (a multiple of the page size).
+  const static unsigned int CHUNKS_PER_FILE = 4;    // Reads in flight per file.
+  const static unsigned int BATCH = 4096;           // Members per List::insertMany( ).
+
+private:
+  // A buffer of a file: holds one chunk at a time.
+  struct Slot
+  {
+    char *buffer = nullptr;
+    unsigned long long chunk = 0; // Chunk number (offset / CHUNK_SIZE).
+    unsigned int expected = 0;    // Bytes of the chunk (less than CHUNK_SIZE for the last one).
+    unsigned int filled = 0;      // Bytes read so far.
+    bool reading = false;
+  };
+
+  // Reading and parsing state of one file.
+  struct Stream
+  {
+    string fileName;
+    int fd = -1;
+    unsigned long long size = 0;
+    unsigned long long nextChunk = 0;  // Next chunk to read.
+    unsigned long long parsedChunks = 0; // Chunks parsed (in order).
+    Slot slots[CHUNKS_PER_FILE];
+    bool wholeLines = false;           // Fields are separated by line breaks only.
+    string partial;                    // Field cut by the end of the last chunk parsed.
+    deque<string> fields;              // Parsed, not yet taken into a member.
+  };
+
+  Stream streams[FILE_COUNT];
+  bool allowIoUring;
+  bool usedIoUring = false;
+  unsigned long long bytesRead = 0;
+  unsigned int loadedCount = 0;
+  unsigned int rejectedCount = 0;
+
+  // Description: Queues the read of the next chunk of a stream into one of its slots.
+  void readNextChunk(AsyncReader &reader, unsigned int file, unsigned int slot);
+
+  // Description: Parses the chunks of a stream that are complete and next in order, and reuses their slots.
+  void parseReadyChunks(AsyncReader &reader, unsigned int file);
+
+  // Description: Splits [first, last) into fields (lines if stream.wholeLines), the first one continuing
+  //              the partial field.
+  static void parseFields(Stream &stream, const char *first, const char *last);
+
+  // Description: Takes the members whose fields have all been parsed into batch, inserting full batches.
+  void assembleMembers(List &list, vector<Member *> &batch);
+
+  // Description: Inserts batch into list, reporting and deleting the members not inserted.
+  void insertBatch(List &list, vector<Member *> &batch);
+
+  // Description: Closes the files and releases the buffers.
+  void release();
+
+public:
+  // Constructor
+  // Description: Prepares the load of the given files (nothing is opened yet).
+  //              allowIoUring: false forces the pread( ) pool.
+  MemberIngest(const string &namesFile = "names.txt", const string &phonesFile = "randomKeys.txt",
+               const string &emailsFile = "randomEmails.txt", const string &cardsFile = "randomCardNums.txt",
+               bool allowIoUring = true);
+
+  // Destructor
+  ~MemberIngest();
+
+  MemberIngest(const MemberIngest &) = delete;
+  MemberIngest &operator=(const MemberIngest &) = delete;
+
+  // Description: Reads the files and inserts their members into list. A member that cannot be inserted
+  //              (e.g. invalid or duplicate phone number) is reported on cout, as by the test driver, and deleted.
+  // Postcondition: getLoadedCount( ) members inserted, getRejectedCount( ) rejected.
+  // Exception: Throws UnableToOpenFileException if a file cannot be opened or read.
+  void loadInto(List &list);
+
+  // Description: Returns true if the last load read through io_uring.
+  bool usesIoUring() const;
+
+  // Description: Returns the number of bytes read by the last load.
+  unsigned long long getBytesRead() const;
+
+  // Description: Returns the number of members inserted by the last load.
+  unsigned int getLoadedCount() const;
+
+  // Description: Returns the number of members the last load could not insert.
+  unsigned int getRejectedCount() const;
+};
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * PageAllocation.cpp
+ *
+ * Description: Allocation of the large arrays of a hash table, optionally backed by
+ *              2 MB transparent huge pages, with a graceful fallback to ordinary pages.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <fstream>
+#include <new>
+#include <string>
+#include <sys/mman.h>
+
+#include "PageAllocation.h"
+
+using namespace std;
+
+static const size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// Description: Allocates bytes bytes. With HUGE_PAGES, maps a region rounded up to whole
+//              huge pages, trims it to a 2 MB aligned address (huge pages must be aligned) and
+//              asks for huge pages. Falls back to operator new if the mapping fails.
+TableBlock allocateTable(size_t bytes, TableAllocation allocation)
+{
+    TableBlock block;
+    if (allocation == TableAllocation::HUGE_PAGES && bytes > 0)
+    {
+        size_t length = (bytes + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+        void *region = mmap(nullptr, length + HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region != MAP_FAILED)
+        {
+            char *start = (char *)region;
+            char *aligned = (char *)(((size_t)start + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE);
+            if (aligned > start)
+            {
+                munmap(start, aligned - start);
+            }
+            char *end = start + length + HUGE_PAGE_SIZE;
+            if (end > aligned + length)
+            {
+                munmap(aligned + length, end - (aligned + length));
+            }
+
+            block.memory = aligned;
+            block.mappedBytes = length;
+            block.hugePages = madvise(aligned, length, MADV_HUGEPAGE) == 0 && hugePagesAvailable();
+            return block;
+        }
+    }
+
+    block.memory = ::operator new(bytes);
+    return block;
+}
+
+// Description: Releases memory obtained from allocateTable( ).
+void releaseTable(TableBlock &block)
+{
+    if (block.memory == nullptr)
+    {
+        return;
+    }
+    if (block.mappedBytes > 0)
+    {
+        munmap(block.memory, block.mappedBytes);
+    }
+    else
+    {
+        ::operator delete(block.memory);
+    }
+    block.memory = nullptr;
+    block.mappedBytes = 0;
+    block.hugePages = false;
+}
+
+// Description: Returns true if the kernel grants transparent huge pages to madvise( )d regions.
+//              sysfs is read once, on the first call: every table allocation (and every resize of a
+//              DynamicCapacity table) asks.
+bool hugePagesAvailable()
+{
+    static const bool available = []()
+    {
+        ifstream enabledFile("/sys/kernel/mm/transparent_hugepage/enabled");
+        string enabled;
+        getline(enabledFile, enabled);
+        return enabled.find("[always]") != string::npos || enabled.find("[madvise]") != string::npos;
+    }();
+    return available;
+}
@@ -0,0 +1,47 @@
+/*
+ * PageAllocation.h
+ *
+ * Description: Allocation of the large arrays of a hash table, optionally backed by
+ *              2 MB transparent huge pages: one TLB entry then covers 512 times more of
+ *              the table than with 4 KB pages, so random probes of a table larger than
+ *              the TLB reach miss the TLB far less often.
+ *              Huge pages are requested with mmap( ) of a 2 MB aligned region and
+ *              madvise(MADV_HUGEPAGE); if either fails, or the kernel has transparent huge
+ *              pages disabled, the array is still allocated (with ordinary pages, or new[]).
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef PAGE_ALLOCATION_H
+#define PAGE_ALLOCATION_H
+
+#include <cstddef>
+
+enum class TableAllocation
+{
+  HEAP,      // operator new
+  HUGE_PAGES // mmap + madvise(MADV_HUGEPAGE), falling back to operator new
+};
+
+// Memory obtained from allocateTable( ), to be given back to releaseTable( ).
+struct TableBlock
+{
+  void *memory = nullptr;
+  size_t mappedBytes = 0; // Size of the mapping, 0 if the memory comes from operator new.
+  bool hugePages = false; // True if the kernel accepted madvise(MADV_HUGEPAGE) for it.
+};
+
+// Description: Allocates bytes bytes (uninitialized when allocation is HEAP, zeroed otherwise).
+// Exception: Throws bad_alloc if no memory can be obtained at all.
+TableBlock allocateTable(size_t bytes, TableAllocation allocation);
+
+// Description: Releases memory obtained from allocateTable( ).
+void releaseTable(TableBlock &block);
+
+// Description: Returns true if the kernel grants transparent huge pages to regions marked with
+//              madvise(MADV_HUGEPAGE) ("always" or "madvise" in /sys/kernel/mm/transparent_hugepage/enabled,
+//              read on the first call only).
+bool hugePagesAvailable();
+
+#endif
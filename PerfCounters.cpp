@@ -0,0 +1,124 @@
+/*
+ * PerfCounters.cpp
+ *
+ * Class Description: Hardware (and software) event counters of the calling thread, read through
+ *                    perf_event_open( ), each counter opened on its own so that one the machine
+ *                    does not provide leaves the others usable.
+ * Class Invariant: - fds[c] >= 0 if and only if counter c is available.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "PerfCounters.h"
+
+using namespace std;
+
+// Constructor
+PerfCounters::PerfCounters()
+{
+    // Event type and configuration of each counter, in the order of Counter.
+    const unsigned int types[COUNTER_COUNT] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE,
+                                               PERF_TYPE_HARDWARE, PERF_TYPE_SOFTWARE};
+    const unsigned long long configs[COUNTER_COUNT] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                                       PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES,
+                                                       PERF_COUNT_SW_PAGE_FAULTS};
+    for (unsigned int c = 0; c < COUNTER_COUNT; c++)
+    {
+        perf_event_attr attributes;
+        memset(&attributes, 0, sizeof(attributes));
+        attributes.size = sizeof(attributes);
+        attributes.type = types[c];
+        attributes.config = configs[c];
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        // pid 0, cpu -1: the calling thread, on any CPU.
+        fds[c] = (int)syscall(SYS_perf_event_open, &attributes, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+        values[c] = 0;
+    }
+}
+
+// Destructor
+PerfCounters::~PerfCounters()
+{
+    for (unsigned int c = 0; c < COUNTER_COUNT; c++)
+    {
+        if (fds[c] >= 0)
+        {
+            close(fds[c]);
+        }
+    }
+}
+
+// Description: Returns the name of a counter, as written in benchmark reports.
+const char *PerfCounters::name(Counter counter)
+{
+    static const char *const names[COUNTER_COUNT] = {"cycles", "instructions", "cache_misses", "branch_misses",
+                                                     "page_faults"};
+    return names[counter];
+}
+
+// Description: Returns true if counter is counted.
+bool PerfCounters::isAvailable(Counter counter) const
+{
+    return fds[counter] >= 0;
+}
+
+// Description: Returns true if at least one counter is counted.
+bool PerfCounters::isAnyAvailable() const
+{
+    for (unsigned int c = 0; c < COUNTER_COUNT; c++)
+    {
+        if (fds[c] >= 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Description: Resets the counters and starts counting.
+void PerfCounters::start()
+{
+    for (unsigned int c = 0; c < COUNTER_COUNT; c++)
+    {
+        if (fds[c] >= 0)
+        {
+            ioctl(fds[c], PERF_EVENT_IOC_RESET, 0);
+            ioctl(fds[c], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+}
+
+// Description: Stops counting and reads the counters (a counter that cannot be read counts 0).
+void PerfCounters::stop()
+{
+    for (unsigned int c = 0; c < COUNTER_COUNT; c++)
+    {
+        if (fds[c] >= 0)
+        {
+            ioctl(fds[c], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    for (unsigned int c = 0; c < COUNTER_COUNT; c++)
+    {
+        values[c] = 0;
+        if (fds[c] >= 0 && read(fds[c], &values[c], sizeof(values[c])) != (ssize_t)sizeof(values[c]))
+        {
+            values[c] = 0;
+        }
+    }
+}
+
+// Description: Returns the number of events counted between the last start( ) and stop( ).
+unsigned long long PerfCounters::getValue(Counter counter) const
+{
+    return values[counter];
+}
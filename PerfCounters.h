@@ -0,0 +1,70 @@
+/*
+ * PerfCounters.h
+ *
+ * Class Description: Hardware (and software) event counters of the calling thread, read through
+ *                    perf_event_open( ): cycles, instructions, cache misses, branch misses and
+ *                    page faults, counted in user space between start( ) and stop( ).
+ *                    A counter the machine or the kernel does not provide (e.g. no PMU in a virtual
+ *                    machine, or kernel.perf_event_paranoid too high) is left unavailable: the others
+ *                    are counted all the same.
+ *                    The counters are those of the thread that made the object.
+ * Class Invariant: - fds[c] >= 0 if and only if counter c is available.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+class PerfCounters
+{
+
+public:
+  enum Counter
+  {
+    CYCLES,
+    INSTRUCTIONS,
+    CACHE_MISSES,
+    BRANCH_MISSES,
+    PAGE_FAULTS,
+    COUNTER_COUNT
+  };
+
+private:
+  int fds[COUNTER_COUNT];
+  unsigned long long values[COUNTER_COUNT];
+
+public:
+  // Constructor
+  // Description: Opens the counters of the calling thread (disabled).
+  PerfCounters();
+
+  // Destructor
+  ~PerfCounters();
+
+  PerfCounters(const PerfCounters &) = delete;
+  PerfCounters &operator=(const PerfCounters &) = delete;
+
+  // Description: Returns the name of a counter, e.g. "cache_misses".
+  static const char *name(Counter counter);
+
+  // Description: Returns true if counter is counted.
+  bool isAvailable(Counter counter) const;
+
+  // Description: Returns true if at least one counter is counted.
+  bool isAnyAvailable() const;
+
+  // Description: Resets the counters and starts counting.
+  void start();
+
+  // Description: Stops counting and reads the counters.
+  // Postcondition: getValue( ) returns the events counted since start( ).
+  void stop();
+
+  // Description: Returns the number of events counted between the last start( ) and stop( ),
+  //              0 if counter is not available.
+  unsigned long long getValue(Counter counter) const;
+};
+
+#endif
@@ -0,0 +1,503 @@
+/*
+ * PerfRegressionDriver.cpp
+ *
+ * Description: Performance regression harness of the List.
+ *              Usage: prd [max size exponent] [results file] [baseline file] [time threshold]
+ *                         [counter threshold]
+ *              Measures insert, search hit, search miss, bulk load (insertMany( )) and iteration on
+ *              Lists of 10^2 .. 10^(max size exponent) members (default 6), with the time and the
+ *              hardware counters (PerfCounters: cycles, instructions, cache misses, branch misses,
+ *              page faults) per operation, the best of REPETITIONS runs of at least MIN_OPERATIONS
+ *              operations each. Writes the results as JSON to the results file (default
+ *              perfResults.json), one result per line.
+ *              The results record the host (CPU model and number of cores).
+ *              If a baseline file (results of an earlier run, e.g. the checked-in perfBaseline.json)
+ *              is given, compares each result to it: the time per operation may grow by at most
+ *              "time threshold" (default 0.25, i.e. 25%), each counter available in both by at most
+ *              "counter threshold" (default 0.10). Times are only compared if the baseline was
+ *              measured on the same kind of host: otherwise prd warns and compares the counters only.
+ *              Exits with status 1 if a result regressed (or a search found wrong members).
+ *
+ * Author: Elaine Luu
+ * Created on: Oct. 2026
+ *
+ */
+
+#include "List.h"
+#include "Member.h"
+#include "PerfCounters.h"
+#include "PhoneKey.h"
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+const unsigned int MIN_EXPONENT = 2;
+const unsigned long long MIN_OPERATIONS = 1000000; // Per run: small Lists are measured repeatedly.
+const unsigned int REPETITIONS = 3;
+const double MIN_COMPARED_PER_OPERATION = 0.5;     // Counters rarer than this are too noisy to compare.
+
+// Result of one operation on one size of List.
+struct Result
+{
+    string operation;
+    unsigned long long size = 0;
+    unsigned long long operations = 0;
+    double nanosecondsPerOperation = 0;
+    bool counted[PerfCounters::COUNTER_COUNT] = {};
+    double perOperation[PerfCounters::COUNTER_COUNT] = {};
+
+    string name() const
+    {
+        return operation + "/" + to_string(size);
+    }
+};
+
+// Machine the results were measured on: times are only comparable between identical hosts.
+struct Host
+{
+    string cpuModel = "unknown";
+    unsigned int cores = 0;
+
+    bool operator==(const Host &rhs) const
+    {
+        return cpuModel == rhs.cpuModel && cores == rhs.cores;
+    }
+
+    string describe() const
+    {
+        return cpuModel + ", " + to_string(cores) + " core" + (cores == 1 ? "" : "s");
+    }
+};
+
+// Description: Returns the phone of member i: distinct for distinct i < 5 * 10^9. The keys of stored
+//              members are even; with stored false, returns the odd key of a phone that is never stored.
+string memberPhone(unsigned long long i, bool stored = true)
+{
+    char phone[12];
+    formatPhoneKey(((i + 1) * 2654435761ULL % 5000000000ULL) * 2 + (stored ? 0 : 1), phone);
+    return string(phone, 12);
+}
+
+// Description: Returns members i in [0, count) (search members: phone only).
+vector<Member *> makeMembers(unsigned long long count)
+{
+    vector<Member *> members;
+    members.reserve(count);
+    for (unsigned long long i = 0; i < count; i++)
+    {
+        members.push_back(new Member(memberPhone(i)));
+    }
+    return members;
+}
+
+// Description: Runs body (which returns the number of operations it made) under the clock and the
+//              counters, and keeps the run in best if it is the fastest so far.
+void measure(PerfCounters &counters, const function<unsigned long long()> &body, Result &best)
+{
+    Clock::time_point start = Clock::now();
+    counters.start();
+    unsigned long long operations = body();
+    counters.stop();
+    double nanoseconds = chrono::duration<double, nano>(Clock::now() - start).count();
+    double perOperation = nanoseconds / operations;
+    if (best.operations != 0 && perOperation >= best.nanosecondsPerOperation)
+    {
+        return;
+    }
+    best.operations = operations;
+    best.nanosecondsPerOperation = perOperation;
+    for (unsigned int c = 0; c < PerfCounters::COUNTER_COUNT; c++)
+    {
+        best.counted[c] = counters.isAvailable((PerfCounters::Counter)c);
+        best.perOperation[c] = (double)counters.getValue((PerfCounters::Counter)c) / operations;
+    }
+}
+
+// Description: Measures the insertion of size members into empty Lists (insert( ) one at a time, or
+//              insertMany( ) if bulk), enough Lists to make MIN_OPERATIONS insertions.
+Result benchInsert(PerfCounters &counters, unsigned long long size, bool bulk)
+{
+    Result best;
+    best.operation = bulk ? "bulk_load" : "insert";
+    best.size = size;
+    unsigned long long listCount = (MIN_OPERATIONS + size - 1) / size;
+    for (unsigned int r = 0; r < REPETITIONS; r++)
+    {
+        vector<List *> lists;
+        vector<vector<Member *>> members;
+        for (unsigned long long l = 0; l < listCount; l++)
+        {
+            lists.push_back(new List(hashPhone, 2 * size));
+            members.push_back(makeMembers(size));
+        }
+        vector<ErrorCode> codes(bulk ? size : 0);
+        measure(counters, [&]() {
+            for (unsigned long long l = 0; l < listCount; l++)
+            {
+                if (bulk)
+                {
+                    lists[l]->insertMany(members[l].data(), codes.data(), (unsigned int)size);
+                }
+                else
+                {
+                    for (Member *member : members[l])
+                    {
+                        lists[l]->insert(*member);
+                    }
+                }
+            }
+            return listCount * size;
+        }, best);
+        for (List *list : lists)
+        {
+            delete list;
+        }
+    }
+    return best;
+}
+
+// Description: Measures searches (trySearch( ): a miss is no exception) of stored (hit) or never stored
+//              phones in list (size members), in a scattered order, MIN_OPERATIONS of them at least. wrong counts the searches whose
+//              result is not the expected one.
+Result benchSearch(PerfCounters &counters, const List &list, unsigned long long size, bool hit, unsigned long long &wrong)
+{
+    Result best;
+    best.operation = hit ? "search_hit" : "search_miss";
+    best.size = size;
+    // j * 2654435761 mod size is a permutation of [0, size): 2654435761 is prime to 2 and 5.
+    unsigned long long probeCount = (size < MIN_OPERATIONS) ? size : MIN_OPERATIONS;
+    vector<Member> probes;
+    probes.reserve(probeCount);
+    for (unsigned long long j = 0; j < probeCount; j++)
+    {
+        probes.push_back(Member(memberPhone(j * 2654435761ULL % size, hit)));
+    }
+    unsigned long long rounds = (MIN_OPERATIONS + probeCount - 1) / probeCount;
+    for (unsigned int r = 0; r < REPETITIONS; r++)
+    {
+        unsigned long long found = 0;
+        measure(counters, [&]() {
+            Member *result;
+            for (unsigned long long round = 0; round < rounds; round++)
+            {
+                for (const Member &probe : probes)
+                {
+                    found += list.trySearch(probe, result) == ErrorCode::OK;
+                }
+            }
+            return rounds * probeCount;
+        }, best);
+        wrong += hit ? rounds * probeCount - found : found;
+    }
+    return best;
+}
+
+// Description: Measures the traversal of list (size members), enough times to visit MIN_OPERATIONS members.
+Result benchIterate(PerfCounters &counters, const List &list, unsigned long long size)
+{
+    Result best;
+    best.operation = "iterate";
+    best.size = size;
+    unsigned long long rounds = (MIN_OPERATIONS + size - 1) / size;
+    volatile unsigned long long sink = 0;
+    for (unsigned int r = 0; r < REPETITIONS; r++)
+    {
+        measure(counters, [&]() {
+            unsigned long long visited = 0, digits = 0;
+            for (unsigned long long round = 0; round < rounds; round++)
+            {
+                for (List::const_iterator it = list.begin(); it != list.end(); ++it)
+                {
+                    digits += (*it).getPhone()[11];
+                    visited++;
+                }
+            }
+            sink = sink + digits;
+            return visited;
+        }, best);
+    }
+    return best;
+}
+
+// Description: Returns the host running prd: the "model name" of /proc/cpuinfo and the number of cores.
+Host currentHost()
+{
+    Host host;
+    ifstream cpuinfo("/proc/cpuinfo");
+    string line;
+    while (getline(cpuinfo, line))
+    {
+        if (line.compare(0, 10, "model name") == 0 && line.find(':') != string::npos)
+        {
+            host.cpuModel = line.substr(line.find(':') + 1);
+            host.cpuModel.erase(0, host.cpuModel.find_first_not_of(" \t"));
+            break;
+        }
+    }
+    for (char &c : host.cpuModel) // keeps the model a plain JSON string
+    {
+        if (c == '"' || c == '\\')
+        {
+            c = '\'';
+        }
+    }
+    host.cores = thread::hardware_concurrency();
+    return host;
+}
+
+// Description: Writes a number, or null if it was not counted.
+void writeValue(ostream &out, bool counted, double value)
+{
+    if (counted)
+    {
+        out << value;
+    }
+    else
+    {
+        out << "null";
+    }
+}
+
+// Description: Writes the results as JSON, one result per line (as readResults( ) reads them).
+void writeResults(ostream &out, const vector<Result> &results, const PerfCounters &counters, const Host &host)
+{
+    out << "{" << endl;
+    out << "  \"cpu_model\": \"" << host.cpuModel << "\"," << endl;
+    out << "  \"cores\": " << host.cores << "," << endl;
+    out << "  \"repetitions\": " << REPETITIONS << "," << endl;
+    out << "  \"min_operations\": " << MIN_OPERATIONS << "," << endl;
+    out << "  \"counters\": {";
+    for (unsigned int c = 0; c < PerfCounters::COUNTER_COUNT; c++)
+    {
+        out << (c == 0 ? "" : ", ") << "\"" << PerfCounters::name((PerfCounters::Counter)c)
+            << "\": " << (counters.isAvailable((PerfCounters::Counter)c) ? "true" : "false");
+    }
+    out << "}," << endl;
+    out << "  \"results\": [" << endl;
+    out << setprecision(6);
+    for (unsigned int i = 0; i < results.size(); i++)
+    {
+        const Result &result = results[i];
+        out << "    {\"name\": \"" << result.name() << "\", \"operation\": \"" << result.operation
+            << "\", \"size\": " << result.size << ", \"operations\": " << result.operations << ", \"ns_per_op\": "
+            << result.nanosecondsPerOperation;
+        for (unsigned int c = 0; c < PerfCounters::COUNTER_COUNT; c++)
+        {
+            out << ", \"" << PerfCounters::name((PerfCounters::Counter)c) << "_per_op\": ";
+            writeValue(out, result.counted[c], result.perOperation[c]);
+        }
+        out << "}" << (i + 1 < results.size() ? "," : "") << endl;
+    }
+    out << "  ]" << endl;
+    out << "}" << endl;
+}
+
+// Description: Reads the value of "key" in a result line into value. Returns false if the line has
+//              no such key or its value is null.
+bool readValue(const string &line, const string &key, double &value)
+{
+    size_t at = line.find("\"" + key + "\": ");
+    if (at == string::npos)
+    {
+        return false;
+    }
+    istringstream in(line.substr(at + key.size() + 4));
+    return (bool)(in >> value);
+}
+
+// Description: Reads the results of a file written by writeResults( ), by name, and the host they were
+//              measured on (left unknown for a file without one). Returns false if the file cannot be opened.
+bool readResults(const string &fileName, map<string, Result> &results, Host &host)
+{
+    ifstream in(fileName);
+    if (!in)
+    {
+        return false;
+    }
+    string line;
+    while (getline(in, line))
+    {
+        size_t at = line.find("\"cpu_model\": \"");
+        if (at != string::npos)
+        {
+            at += 14;
+            host.cpuModel = line.substr(at, line.find('"', at) - at);
+            continue;
+        }
+        double cores = 0;
+        if (line.find("{\"name\": \"") == string::npos && readValue(line, "cores", cores))
+        {
+            host.cores = (unsigned int)cores;
+            continue;
+        }
+        at = line.find("{\"name\": \"");
+        if (at == string::npos)
+        {
+            continue;
+        }
+        at += 10;
+        string name = line.substr(at, line.find('"', at) - at);
+        Result &result = results[name];
+        if (!readValue(line, "ns_per_op", result.nanosecondsPerOperation))
+        {
+            results.erase(name);
+            continue;
+        }
+        for (unsigned int c = 0; c < PerfCounters::COUNTER_COUNT; c++)
+        {
+            string key = string(PerfCounters::name((PerfCounters::Counter)c)) + "_per_op";
+            result.counted[c] = readValue(line, key, result.perOperation[c]);
+        }
+    }
+    return true;
+}
+
+// Description: Compares result to its baseline and prints the comparison. Returns true if it regressed.
+//              The time is only compared if compareTime (the baseline comes from the same kind of host).
+bool compare(const Result &result, const Result &baseline, double timeThreshold, double counterThreshold,
+             bool compareTime)
+{
+    double change = result.nanosecondsPerOperation / baseline.nanosecondsPerOperation - 1;
+    bool regressed = compareTime && change > timeThreshold;
+    string regressions = regressed ? " time" : "";
+    for (unsigned int c = 0; c < PerfCounters::COUNTER_COUNT; c++)
+    {
+        if (result.counted[c] && baseline.counted[c] && baseline.perOperation[c] >= MIN_COMPARED_PER_OPERATION &&
+            result.perOperation[c] > baseline.perOperation[c] * (1 + counterThreshold))
+        {
+            regressed = true;
+            regressions += string(" ") + PerfCounters::name((PerfCounters::Counter)c) + " (" +
+                           to_string((int)(100 * (result.perOperation[c] / baseline.perOperation[c] - 1))) + "%)";
+        }
+    }
+    cout << setw(22) << left << result.name() << right << setw(10) << baseline.nanosecondsPerOperation << setw(10)
+         << result.nanosecondsPerOperation << setw(9) << showpos << 100 * change << noshowpos << "%  "
+         << (regressed ? "REGRESSION:" + regressions : (compareTime ? "ok" : "ok (time not compared)")) << endl;
+    return regressed;
+}
+
+int main(int argc, char *argv[])
+{
+    unsigned int maxExponent = (argc > 1) ? stoul(argv[1]) : 6;
+    string resultsFile = (argc > 2) ? argv[2] : "perfResults.json";
+    string baselineFile = (argc > 3) ? argv[3] : "";
+    double timeThreshold = (argc > 4) ? stod(argv[4]) : 0.25;
+    double counterThreshold = (argc > 5) ? stod(argv[5]) : 0.10;
+
+    PerfCounters counters;
+    cout << "Counters:";
+    for (unsigned int c = 0; c < PerfCounters::COUNTER_COUNT; c++)
+    {
+        cout << " " << PerfCounters::name((PerfCounters::Counter)c)
+             << (counters.isAvailable((PerfCounters::Counter)c) ? "" : " (unavailable)");
+    }
+    cout << endl;
+
+    vector<Result> results;
+    unsigned long long wrong = 0;
+    cout << fixed << setprecision(1);
+    cout << "name                    ns/op    cycles/op  cache misses/op  branch misses/op" << endl;
+    unsigned long long size = 1;
+    for (unsigned int e = 0; e < MIN_EXPONENT; e++)
+    {
+        size *= 10;
+    }
+    for (unsigned int e = MIN_EXPONENT; e <= maxExponent; e++, size *= 10)
+    {
+        vector<Result> sized;
+        sized.push_back(benchInsert(counters, size, false));
+        sized.push_back(benchInsert(counters, size, true));
+        {
+            List list(hashPhone, 2 * size);
+            vector<Member *> members = makeMembers(size);
+            for (Member *member : members)
+            {
+                list.insert(*member);
+            }
+            sized.push_back(benchSearch(counters, list, size, true, wrong));
+            sized.push_back(benchSearch(counters, list, size, false, wrong));
+            sized.push_back(benchIterate(counters, list, size));
+        }
+        for (const Result &result : sized)
+        {
+            cout << setw(22) << left << result.name() << right << setw(9) << result.nanosecondsPerOperation;
+            for (PerfCounters::Counter c : {PerfCounters::CYCLES, PerfCounters::CACHE_MISSES, PerfCounters::BRANCH_MISSES})
+            {
+                cout << setw(c == PerfCounters::CYCLES ? 13 : 17);
+                if (result.counted[c])
+                {
+                    cout << setprecision(2) << result.perOperation[c] << setprecision(1);
+                }
+                else
+                {
+                    cout << "-";
+                }
+            }
+            cout << endl;
+            results.push_back(result);
+        }
+    }
+    if (wrong != 0)
+    {
+        cout << "Searches with a wrong result: " << wrong << endl;
+    }
+
+    ofstream out(resultsFile);
+    Host host = currentHost();
+    writeResults(out, results, counters, host);
+    out.close();
+    if (!out)
+    {
+        cout << "Unable to write " << resultsFile << endl;
+        return 1;
+    }
+    cout << "Results written to " << resultsFile << endl;
+
+    if (baselineFile.empty())
+    {
+        return wrong == 0 ? 0 : 1;
+    }
+    map<string, Result> baseline;
+    Host baselineHost;
+    if (!readResults(baselineFile, baseline, baselineHost))
+    {
+        cout << "No baseline " << baselineFile << ": nothing compared" << endl;
+        return wrong == 0 ? 0 : 1;
+    }
+    bool compareTime = baselineHost == host;
+    cout << endl
+         << "Against " << baselineFile << " (thresholds: time +" << 100 * timeThreshold << "%, counters +"
+         << 100 * counterThreshold << "%)" << endl;
+    if (!compareTime)
+    {
+        cout << "Warning: the baseline was measured on another host (" << baselineHost.describe() << "; this host: "
+             << host.describe() << "). Times are not compared, only the counters available in both. "
+             << "Run \"make perf-baseline\" to measure a baseline on this host." << endl;
+    }
+    cout << "name                  baseline     ns/op   change" << endl;
+    unsigned int regressions = 0;
+    for (const Result &result : results)
+    {
+        map<string, Result>::const_iterator it = baseline.find(result.name());
+        if (it == baseline.end())
+        {
+            cout << setw(22) << left << result.name() << right << "  not in the baseline" << endl;
+        }
+        else
+        {
+            regressions += compare(result, it->second, timeThreshold, counterThreshold, compareTime);
+        }
+    }
+    cout << regressions << " regression" << (regressions == 1 ? "" : "s") << endl;
+    return (regressions == 0 && wrong == 0) ? 0 : 1;
+}
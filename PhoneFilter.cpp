@@ -0,0 +1,101 @@
+/*
+ * PhoneFilter.cpp
+ *
+ * Class Description: Blocked Bloom filter over packed phone numbers, answering "certainly not
+ *                    stored" or "maybe stored". Each key maps to one 64-byte block (one cache
+ *                    line) of 8 words and sets one bit in each word, so a lookup reads a single
+ *                    cache line.
+ * Class Invariant: - Every key inserted since the last clear( ) is reported by mayContain( ).
+ *                  - The number of blocks is fixed at construction.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <algorithm>
+
+#include "PhoneFilter.h"
+#include "PhoneKey.h"
+
+using namespace std;
+
+// Odd multipliers picking the bit of each word from the low half of the hash
+// (as in the split block Bloom filters of Impala and Parquet).
+static const unsigned int SALTS[8] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+                                      0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+// Constructor
+PhoneFilter::PhoneFilter(unsigned int expectedKeys, unsigned int bitsPerKey)
+{
+    unsigned long long bits = (unsigned long long)expectedKeys * bitsPerKey;
+    blockCount = (unsigned int)max(1ULL, (bits + 511) / 512);
+    blocks = new Block[blockCount];
+    clear();
+}
+
+// Destructor
+PhoneFilter::~PhoneFilter()
+{
+    delete[] blocks;
+    blocks = nullptr;
+}
+
+// Description: Adds a packed phone number.
+void PhoneFilter::insert(unsigned long long key)
+{
+    unsigned long long hash = mixKey(key);
+    Block &block = blocks[blockOf(hash)];
+    for (unsigned int i = 0; i < 8; i++)
+    {
+        block.words[i] |= bitOf(hash, i);
+    }
+    keyCount++;
+}
+
+// Description: Returns false if key was certainly not inserted since the last clear( ), true if it may have been.
+bool PhoneFilter::mayContain(unsigned long long key) const
+{
+    unsigned long long hash = mixKey(key);
+    const Block &block = blocks[blockOf(hash)];
+    bool contained = true;
+    for (unsigned int i = 0; i < 8; i++)
+    {
+        contained &= (block.words[i] & bitOf(hash, i)) != 0;
+    }
+    return contained;
+}
+
+// Description: Removes every key.
+void PhoneFilter::clear()
+{
+    fill((unsigned long long *)blocks, (unsigned long long *)(blocks + blockCount), 0ULL);
+    keyCount = 0;
+}
+
+// Description: Returns the number of keys inserted since the last clear( ).
+unsigned int PhoneFilter::getKeyCount() const
+{
+    return keyCount;
+}
+
+// Description: Returns the memory used by the filter, in bytes.
+unsigned long long PhoneFilter::getMemoryUsage() const
+{
+    return (unsigned long long)blockCount * sizeof(Block) + sizeof(PhoneFilter);
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Returns the index of the block of a key's hash: the high half of the hash
+//              scaled to the block count.
+unsigned int PhoneFilter::blockOf(unsigned long long hash) const
+{
+    return (unsigned int)(((hash >> 32) * blockCount) >> 32);
+}
+
+// Description: Returns the bit set in word i of its block: the top 6 bits of the low half of
+//              the hash times SALTS[i].
+unsigned long long PhoneFilter::bitOf(unsigned long long hash, unsigned int i)
+{
+    return 1ULL << (((unsigned int)hash * SALTS[i]) >> 26);
+}
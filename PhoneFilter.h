@@ -0,0 +1,71 @@
+/*
+ * PhoneFilter.h
+ *
+ * Class Description: Blocked Bloom filter over packed phone numbers, answering "certainly not
+ *                    stored" or "maybe stored". Each key maps to one 64-byte block (one cache
+ *                    line) of 8 words and sets one bit in each word, so a lookup reads a single
+ *                    cache line. With BITS_PER_KEY = 10 the false positive rate is about 1%.
+ *                    Keys cannot be removed: after removals the filter keeps answering "maybe"
+ *                    for them until it is rebuilt (clear( ) then insert( ) of every key).
+ * Class Invariant: - Every key inserted since the last clear( ) is reported by mayContain( ).
+ *                  - The number of blocks is fixed at construction.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef PHONE_FILTER_H
+#define PHONE_FILTER_H
+
+class PhoneFilter
+{
+
+private:
+  struct alignas(64) Block
+  {
+    unsigned long long words[8];
+  };
+
+  Block *blocks = nullptr;
+  unsigned int blockCount = 0;
+  unsigned int keyCount = 0; // Keys inserted since the last clear( ).
+
+  // Description: Returns the index of the block of a key's hash.
+  unsigned int blockOf(unsigned long long hash) const;
+
+  // Description: Returns the bit set in word i of its block by a key's hash.
+  static unsigned long long bitOf(unsigned long long hash, unsigned int i);
+
+public:
+  const static unsigned int BITS_PER_KEY = 10; // Default filter size per expected key.
+
+  // Constructor
+  // Description: Creates an empty filter of bitsPerKey bits per expected key (at least one block).
+  PhoneFilter(unsigned int expectedKeys, unsigned int bitsPerKey = BITS_PER_KEY);
+
+  // Destructor
+  ~PhoneFilter();
+
+  PhoneFilter(const PhoneFilter &) = delete;
+  PhoneFilter &operator=(const PhoneFilter &) = delete;
+
+  // Description: Adds a packed phone number (see PhoneKey.h).
+  // Time Efficiency: O(1), one cache line written
+  void insert(unsigned long long key);
+
+  // Description: Returns false if key was certainly not inserted since the last clear( ),
+  //              true if it may have been.
+  // Time Efficiency: O(1), one cache line read
+  bool mayContain(unsigned long long key) const;
+
+  // Description: Removes every key.
+  void clear();
+
+  // Description: Returns the number of keys inserted since the last clear( ).
+  unsigned int getKeyCount() const;
+
+  // Description: Returns the memory used by the filter, in bytes.
+  unsigned long long getMemoryUsage() const;
+};
+
+#endif
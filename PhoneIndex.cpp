@@ -0,0 +1,247 @@
+/*
+ * PhoneIndex.cpp
+ *
+ * Class Description: Ordered index over the members stored in a List, sorted by phone number.
+ *                    Entries (packed phone, pointer to Member) live in one sorted, contiguous array
+ *                    so that a range of phone numbers is read with a sequential scan.
+ *                    Insertions and removals are buffered and merged into the sorted array in
+ *                    batches, the next time the index is read.
+ * Class Invariant: - The sorted array holds its entries in increasing order of phone number.
+ *                  - Each phone number appears at most once.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <algorithm>
+
+#include "PhoneIndex.h"
+#include "PhoneKey.h"
+
+using namespace std;
+
+// Constructor
+PhoneIndex::PhoneIndex()
+    : insertedCapacity(BATCH_SIZE), removedCapacity(BATCH_SIZE)
+{
+    inserted = new Entry[insertedCapacity];
+    removed = new unsigned long long[removedCapacity];
+}
+
+// Destructor
+// Description: Releases the index. The indexed members are not deleted.
+PhoneIndex::~PhoneIndex()
+{
+    delete[] sorted;
+    sorted = nullptr;
+    delete[] inserted;
+    inserted = nullptr;
+    delete[] removed;
+    removed = nullptr;
+}
+
+// Description: Returns the number of members indexed (pending updates included).
+unsigned int PhoneIndex::getElementCount() const
+{
+    return sortedCount + insertedCount - removedCount;
+}
+
+// Description: Adds a member under its packed phone number.
+void PhoneIndex::insert(unsigned long long key, Member *element)
+{
+    if (insertedCount == insertedCapacity)
+    {
+        if (shouldGrowBatch(insertedCapacity))
+        {
+            Entry *bigger = new Entry[2 * insertedCapacity];
+            copy(inserted, inserted + insertedCount, bigger);
+            delete[] inserted;
+            inserted = bigger;
+            insertedCapacity *= 2;
+        }
+        else
+        {
+            flush();
+        }
+    }
+    inserted[insertedCount].key = key;
+    inserted[insertedCount].element = element;
+    insertedCount++;
+}
+
+// Description: Removes the member indexed under this packed phone number.
+void PhoneIndex::remove(unsigned long long key)
+{
+    // A removal may cancel a pending insertion: merge first so that the
+    // batch never holds both for the same key.
+    if (insertedCount > 0)
+    {
+        flush();
+    }
+    if (removedCount == removedCapacity)
+    {
+        if (shouldGrowBatch(removedCapacity))
+        {
+            unsigned long long *bigger = new unsigned long long[2 * removedCapacity];
+            copy(removed, removed + removedCount, bigger);
+            delete[] removed;
+            removed = bigger;
+            removedCapacity *= 2;
+        }
+        else
+        {
+            flush();
+        }
+    }
+    removed[removedCount] = key;
+    removedCount++;
+}
+
+// Description: Returns the entries whose phone number is in [low, high], in increasing order.
+PhoneIndex::Range PhoneIndex::range(unsigned long long low, unsigned long long high)
+{
+    flush();
+
+    // Binary search for the first entry >= low, then for the first entry > high.
+    const Entry *first = sorted;
+    unsigned int count = sortedCount;
+    while (count > 0)
+    {
+        unsigned int half = count / 2;
+        if (first[half].key < low)
+        {
+            first += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
+        }
+    }
+
+    const Entry *last = first;
+    count = (unsigned int)(sorted + sortedCount - first);
+    while (count > 0)
+    {
+        unsigned int half = count / 2;
+        if (last[half].key <= high)
+        {
+            last += half + 1;
+            count -= half + 1;
+        }
+        else
+        {
+            count = half;
+        }
+    }
+
+    Range result;
+    result.first = first;
+    result.last = last;
+    return result;
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Returns true if a full pending buffer should grow rather than be merged:
+//              batches grow with the sorted array so that merging stays amortized O(log n) per update.
+bool PhoneIndex::shouldGrowBatch(unsigned int batchCapacity) const
+{
+    return batchCapacity < sortedCount / 4;
+}
+
+// Description: Merges the pending insertions and removals into the sorted array.
+//              The pending batches are sorted, then one sequential pass over the sorted
+//              array drops the removed keys and interleaves the inserted ones.
+void PhoneIndex::flush()
+{
+    if (insertedCount == 0 && removedCount == 0)
+    {
+        return;
+    }
+
+    sort(inserted, inserted + insertedCount,
+         [](const Entry &a, const Entry &b)
+         { return a.key < b.key; });
+    sort(removed, removed + removedCount);
+
+    unsigned int newCount = sortedCount + insertedCount;
+    Entry *target = sorted;
+    if (newCount > sortedCapacity)
+    {
+        sortedCapacity = max(newCount, 2 * sortedCapacity);
+        target = new Entry[sortedCapacity];
+    }
+
+    // Merge from the back so that the merge can be done in place when no new array was needed.
+    long long s = (long long)sortedCount - 1;
+    long long n = (long long)insertedCount - 1;
+    long long r = (long long)removedCount - 1;
+    long long out = (long long)newCount - 1;
+    while (s >= 0 || n >= 0)
+    {
+        if (n < 0 || (s >= 0 && sorted[s].key > inserted[n].key))
+        {
+            while (r >= 0 && removed[r] > sorted[s].key)
+            {
+                r--;
+            }
+            if (r >= 0 && removed[r] == sorted[s].key)
+            {
+                r--;
+            }
+            else
+            {
+                target[out--] = sorted[s];
+            }
+            s--;
+        }
+        else
+        {
+            target[out--] = inserted[n--];
+        }
+    }
+
+    // Removed entries left a gap at the front: shift the merged entries down.
+    unsigned int kept = (unsigned int)(newCount - 1 - out);
+    if (out >= 0)
+    {
+        copy(target + out + 1, target + newCount, target);
+    }
+
+    if (target != sorted)
+    {
+        delete[] sorted;
+        sorted = target;
+    }
+    sortedCount = kept;
+    insertedCount = 0;
+    removedCount = 0;
+}
+
+// Description: Converts a phone prefix (e.g. "604" or "604-85") into the range [low, high]
+//              of packed phone numbers starting with it.
+bool phonePrefixRange(const string &prefix, unsigned long long &low, unsigned long long &high)
+{
+    unsigned int digits = 0;
+    for (unsigned int i = 0; i < prefix.length(); i++)
+    {
+        if (prefix[i] >= '0' && prefix[i] <= '9')
+        {
+            digits++;
+        }
+    }
+    if (digits == 0 || digits > 10)
+    {
+        return false;
+    }
+
+    unsigned long long scale = 1;
+    for (unsigned int i = digits; i < 10; i++)
+    {
+        scale *= 10;
+    }
+    low = packPhone(prefix) * scale;
+    high = low + scale - 1;
+    return true;
+}
@@ -0,0 +1,93 @@
+/*
+ * PhoneIndex.h
+ *
+ * Class Description: Ordered index over the members stored in a List, sorted by phone number.
+ *                    Entries (packed phone, pointer to Member) live in one sorted, contiguous array
+ *                    so that a range of phone numbers is read with a sequential scan.
+ *                    Insertions and removals are buffered and merged into the sorted array in
+ *                    batches, the next time the index is read.
+ * Class Invariant: - The sorted array holds its entries in increasing order of phone number.
+ *                  - Each phone number appears at most once.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef PHONE_INDEX_H
+#define PHONE_INDEX_H
+
+#include <string>
+#include "Member.h"
+
+class PhoneIndex
+{
+
+public:
+  struct Entry
+  {
+    unsigned long long key; // Packed phone number (see PhoneKey.h).
+    Member *element;
+  };
+
+  // A range of entries, in increasing order of phone number.
+  // Valid until the index is modified.
+  struct Range
+  {
+    const Entry *first;
+    const Entry *last; // One past the last entry of the range.
+
+    const Entry *begin() const { return first; }
+    const Entry *end() const { return last; }
+    unsigned int size() const { return (unsigned int)(last - first); }
+  };
+
+private:
+  const static unsigned int BATCH_SIZE = 4096; // Minimum number of pending updates merged at once.
+
+  Entry *sorted = nullptr;          // Sorted entries.
+  unsigned int sortedCount = 0;
+  unsigned int sortedCapacity = 0;
+
+  Entry *inserted = nullptr;        // Pending insertions, in arrival order.
+  unsigned int insertedCount = 0;
+  unsigned int insertedCapacity = 0;
+  unsigned long long *removed = nullptr; // Pending removals (packed phones), in arrival order.
+  unsigned int removedCount = 0;
+  unsigned int removedCapacity = 0;
+
+  // Description: Merges the pending insertions and removals into the sorted array.
+  void flush();
+
+  // Description: Returns true if a full pending buffer should grow rather than be merged:
+  //              batches grow with the sorted array so that merging stays amortized O(log n) per update.
+  bool shouldGrowBatch(unsigned int batchCapacity) const;
+
+public:
+  // Constructor
+  PhoneIndex();
+
+  // Destructor
+  // Description: Releases the index. The indexed members are not deleted.
+  ~PhoneIndex();
+
+  // Description: Returns the number of members indexed (pending updates included).
+  unsigned int getElementCount() const;
+
+  // Description: Adds a member under its packed phone number.
+  // Precondition: No member with this phone number is indexed.
+  void insert(unsigned long long key, Member *element);
+
+  // Description: Removes the member indexed under this packed phone number.
+  void remove(unsigned long long key);
+
+  // Description: Returns the entries whose phone number is in [low, high], in increasing order.
+  Range range(unsigned long long low, unsigned long long high);
+
+}; // end PhoneIndex.h
+
+// Description: Converts a phone prefix (e.g. "604" or "604-85") into the range [low, high]
+//              of packed phone numbers starting with it.
+// Postcondition: Returns false if the prefix has no digit or more than 10 digits.
+bool phonePrefixRange(const string &prefix, unsigned long long &low, unsigned long long &high);
+
+#endif
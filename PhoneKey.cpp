@@ -0,0 +1,245 @@
+/*
+ * PhoneKey.cpp
+ *
+ * Description: Helpers turning a member's cell phone number (indexing key)
+ *              into a packed integer key and scrambling that key into a hash code.
+ *              Used by the hash tables that compare keys as integers rather than strings.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <cstring>
+
+#include "PhoneKey.h"
+
+// Description: Packs a phone number of the form XXX-XXX-XXXX into its 10-digit integer value.
+//              Non-digit characters are skipped.
+unsigned long long packPhone(const string &phone)
+{
+    return packPhone(phone.data(), phone.data() + phone.length());
+}
+
+// Description: Same as packPhone(const string &), for the characters in [first, last).
+unsigned long long packPhone(const char *first, const char *last)
+{
+    unsigned long long key = 0;
+    for (const char *c = first; c != last; c++)
+    {
+        if (*c >= '0' && *c <= '9')
+        {
+            key = key * 10 + (*c - '0');
+        }
+    }
+    return key;
+}
+
+// Description: Validates a phone number written in any of the usual formats and packs it into its 10-digit key.
+bool normalizePhone(const char *first, const char *last, unsigned long long &key)
+{
+    key = INVALID_PHONE_KEY;
+
+    // Fast path: XXX-XXX-XXXX.
+    if (last - first == 12 && first[3] == '-' && first[7] == '-')
+    {
+        unsigned long long value = 0;
+        bool digitsOnly = true;
+        for (unsigned int i = 0; i < 12; i++)
+        {
+            unsigned int digit = (unsigned int)(unsigned char)first[i] - '0';
+            if (i != 3 && i != 7)
+            {
+                digitsOnly &= digit < 10;
+                value = value * 10 + digit;
+            }
+        }
+        if (digitsOnly)
+        {
+            key = value;
+            return value != INVALID_PHONE_KEY;
+        }
+    }
+
+    while (first < last && (*first == ' ' || *first == '\t' || *first == '\r' || *first == '\n'))
+    {
+        first++;
+    }
+    while (last > first && (last[-1] == ' ' || last[-1] == '\t' || last[-1] == '\r' || last[-1] == '\n'))
+    {
+        last--;
+    }
+    bool plus = first < last && *first == '+';
+    if (plus)
+    {
+        first++;
+    }
+
+    unsigned long long value = 0;
+    unsigned int digits = 0;
+    int openedAt = -1;     // Digits before the '(' while it is open.
+    bool parentheses = false;
+    char previous = '\0'; // '\0' at the start, 'd' after a digit, otherwise the character itself.
+    for (const char *c = first; c < last; c++)
+    {
+        unsigned int digit = (unsigned int)(unsigned char)*c - '0';
+        if (digit < 10)
+        {
+            if (++digits > 11)
+            {
+                return false;
+            }
+            value = value * 10 + digit;
+            previous = 'd';
+            continue;
+        }
+        switch (*c)
+        {
+        case ' ':
+        case '-':
+        case '.':
+            if (previous != 'd' && previous != ')')
+            {
+                return false;
+            }
+            break;
+        case '(':
+            // Before the area code: at the start, or after the country code 1.
+            if (parentheses || !(digits == 0 || (digits == 1 && value == 1)) || previous == '(')
+            {
+                return false;
+            }
+            parentheses = true;
+            openedAt = (int)digits;
+            break;
+        case ')':
+            if (openedAt < 0 || digits != (unsigned int)openedAt + 3 || previous != 'd')
+            {
+                return false;
+            }
+            openedAt = -1;
+            break;
+        default:
+            return false;
+        }
+        previous = *c;
+    }
+    if (previous != 'd' || openedAt >= 0)
+    {
+        return false;
+    }
+
+    if (digits == 11 && value / 10000000000ULL == 1)
+    {
+        value -= 10000000000ULL;
+    }
+    else if (digits != 10 || plus)
+    {
+        return false;
+    }
+    key = value;
+    return value != INVALID_PHONE_KEY;
+}
+
+// Description: Same as normalizePhone(const char *, const char *, unsigned long long &), for a string.
+bool normalizePhone(const string &phone, unsigned long long &key)
+{
+    return normalizePhone(phone.data(), phone.data() + phone.length(), key);
+}
+
+// Description: Batch mode of normalizePhone( ). Returns the number of valid phone numbers.
+unsigned int normalizePhones(const string *phones, unsigned long long *keys, unsigned int count)
+{
+    unsigned int valid = 0;
+    for (unsigned int i = 0; i < count; i++)
+    {
+        valid += normalizePhone(phones[i].data(), phones[i].data() + phones[i].length(), keys[i]);
+    }
+    return valid;
+}
+
+// Description: Writes the canonical form XXX-XXX-XXXX of a 10-digit key in out[0 .. 11].
+void formatPhoneKey(unsigned long long key, char *out)
+{
+    // The three groups are formatted independently, two digits at a time, rather than as one chain of
+    // ten divisions: Member::getPhone( ) calls this for every member a scan reads.
+    static const char DIGIT_PAIRS[] = "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+                                      "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+                                      "8081828384858687888990919293949596979899";
+    key %= 10000000000ULL;
+    unsigned int area = (unsigned int)(key / 10000000);
+    unsigned int rest = (unsigned int)(key % 10000000);
+    unsigned int exchange = rest / 10000;
+    unsigned int line = rest % 10000;
+    out[0] = (char)('0' + area / 100);
+    memcpy(out + 1, DIGIT_PAIRS + 2 * (area % 100), 2);
+    out[3] = '-';
+    out[4] = (char)('0' + exchange / 100);
+    memcpy(out + 5, DIGIT_PAIRS + 2 * (exchange % 100), 2);
+    out[7] = '-';
+    memcpy(out + 8, DIGIT_PAIRS + 2 * (line / 100), 2);
+    memcpy(out + 10, DIGIT_PAIRS + 2 * (line % 100), 2);
+}
+
+// Description: Returns the canonical form XXX-XXX-XXXX of phone, INVALID_PHONE if it is not a valid phone number.
+string canonicalPhone(const string &phone)
+{
+    unsigned long long key;
+    if (!normalizePhone(phone, key))
+    {
+        return INVALID_PHONE;
+    }
+    char buffer[12];
+    formatPhoneKey(key, buffer);
+    return string(buffer, 12);
+}
+
+// Description: Returns the number of digits in [first, last).
+unsigned int countDigits(const char *first, const char *last)
+{
+    unsigned int digits = 0;
+    for (const char *c = first; c != last; c++)
+    {
+        if (*c >= '0' && *c <= '9')
+        {
+            digits++;
+        }
+    }
+    return digits;
+}
+
+// Description: Scrambles a packed key so that every bit of the key affects every bit of the result
+//              (finalizer of the SplitMix64 generator).
+unsigned long long mixKey(unsigned long long key)
+{
+    key ^= key >> 30;
+    key *= 0xbf58476d1ce4e5b9ULL;
+    key ^= key >> 27;
+    key *= 0x94d049bb133111ebULL;
+    key ^= key >> 31;
+    return key;
+}
+
+// Description: Hash function usable with a List of any capacity: the scrambled packed phone number.
+//              List reduces it modulo its capacity.
+unsigned int hashPhone(string indexingKey)
+{
+    return hashPhoneKey(packPhone(indexingKey));
+}
+
+// Description: Hash function of the seeded family: the packed phone number, offset by the seed, scrambled.
+unsigned int hashPhoneSeeded(const string &indexingKey, unsigned long long seed)
+{
+    return hashPhoneKeySeeded(packPhone(indexingKey), seed);
+}
+
+// Description: hashPhone( ) of a packed phone number.
+unsigned int hashPhoneKey(unsigned long long key)
+{
+    return (unsigned int)(mixKey(key) >> 32);
+}
+
+// Description: hashPhoneSeeded( ) of a packed phone number.
+unsigned int hashPhoneKeySeeded(unsigned long long key, unsigned long long seed)
+{
+    return (unsigned int)(mixKey(key + mixKey(seed)) >> 32);
+}
@@ -0,0 +1,102 @@
+/*
+ * PhoneKey.h
+ *
+ * Description: Helpers turning a member's cell phone number (indexing key)
+ *              into a packed integer key and scrambling that key into a hash code.
+ *              Used by the hash tables that compare keys as integers rather than strings.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef PHONE_KEY_H
+#define PHONE_KEY_H
+
+#include <string>
+
+using std::string;
+
+const unsigned long long INVALID_PHONE_KEY = 0; // Key of no valid phone number (see normalizePhone( )).
+const char *const INVALID_PHONE = "000-000-0000"; // Phone number given by Member to an invalid one.
+
+// Description: Packs a phone number of the form XXX-XXX-XXXX into its 10-digit integer value.
+//              Non-digit characters are skipped.
+// Example: "604-853-1423" -> 6048531423
+// Time Efficiency: O(1) (fixed length key)
+// Space Efficiency: O(1)
+unsigned long long packPhone(const string &phone);
+
+// Description: Same as packPhone(const string &), for the characters in [first, last)
+//              (e.g. a field of a line read from a file, without copying it into a string).
+// Time Efficiency: O(last - first)
+// Space Efficiency: O(1)
+unsigned long long packPhone(const char *first, const char *last);
+
+// Description: Validates a phone number written in any of the usual formats and packs it into its
+//              10-digit key, in one pass over [first, last) and without allocating:
+//                  604-853-1423   604.853.1423   604 853 1423   6048531423
+//                  (604) 853-1423   (604)853-1423
+//                  +1 604 853 1423   +1-604-853-1423   +1 (604) 853-1423   1-604-853-1423   16048531423
+//              White space around the number is ignored. Separators (' ', '-', '.') go between digits
+//              (or after the area code's ')'), one at a time; the area code may be in parentheses.
+//              11 digits are a country code 1 followed by the number; '+' requires that country code.
+//              The canonical XXX-XXX-XXXX is recognized first (fast path).
+//              Returns false, key being INVALID_PHONE_KEY, for anything else, and for 000-000-0000,
+//              which marks an invalid phone number (see Member).
+// Example: "(604) 853-1423" -> 6048531423
+// Time Efficiency: O(last - first)
+// Space Efficiency: O(1)
+bool normalizePhone(const char *first, const char *last, unsigned long long &key);
+
+// Description: Same as normalizePhone(const char *, const char *, unsigned long long &), for a string.
+bool normalizePhone(const string &phone, unsigned long long &key);
+
+// Description: Batch mode of normalizePhone( ): keys[i] is the key of phones[i], INVALID_PHONE_KEY
+//              if phones[i] is not a valid phone number. Returns the number of valid ones.
+// Time Efficiency: O(total length of the phones)
+// Space Efficiency: O(1)
+unsigned int normalizePhones(const string *phones, unsigned long long *keys, unsigned int count);
+
+// Description: Writes the canonical form XXX-XXX-XXXX of a 10-digit key in out[0 .. 11] (no terminator).
+// Time Efficiency: O(1)
+// Space Efficiency: O(1)
+void formatPhoneKey(unsigned long long key, char *out);
+
+// Description: Returns the canonical form XXX-XXX-XXXX of phone (any format accepted by
+//              normalizePhone( )), INVALID_PHONE if it is not a valid phone number.
+// Time Efficiency: O(length of phone)
+// Space Efficiency: O(1) (the result fits in the string's own buffer)
+string canonicalPhone(const string &phone);
+
+// Description: Returns the number of digits in [first, last).
+// Time Efficiency: O(last - first)
+// Space Efficiency: O(1)
+unsigned int countDigits(const char *first, const char *last);
+
+// Description: Scrambles a packed key so that every bit of the key affects every bit of the result
+//              (finalizer of the SplitMix64 generator).
+// Time Efficiency: O(1)
+// Space Efficiency: O(1)
+unsigned long long mixKey(unsigned long long key);
+
+// Description: Hash function usable with a List of any capacity: the scrambled packed phone number.
+//              List reduces it modulo its capacity.
+// Time Efficiency: O(1)
+// Space Efficiency: O(1)
+unsigned int hashPhone(string indexingKey);
+
+// Description: Family of hash functions of the same kind as hashPhone( ), one per seed: the packed phone
+//              number is combined with the seed before it is scrambled, so that keys colliding under
+//              one seed are spread apart under another (see HashFamily).
+// Time Efficiency: O(1)
+// Space Efficiency: O(1)
+unsigned int hashPhoneSeeded(const string &indexingKey, unsigned long long seed);
+
+// Description: hashPhone( ) and hashPhoneSeeded( ) of a phone number already packed into key: what a
+//              List keyed by packed phone numbers calls instead of formatting the phone back.
+// Time Efficiency: O(1)
+// Space Efficiency: O(1)
+unsigned int hashPhoneKey(unsigned long long key);
+unsigned int hashPhoneKeySeeded(unsigned long long key, unsigned long long seed);
+
+#endif
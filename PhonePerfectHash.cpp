@@ -0,0 +1,145 @@
+/*
+ * PhonePerfectHash.cpp
+ *
+ * Class Description: Minimal perfect hash function over a fixed set of packed phone numbers
+ *                    (BBHash construction): levels of bit arrays, a key's index is the rank of
+ *                    the first bit it owns alone; the keys left after MAX_LEVELS levels are kept
+ *                    in a sorted fallback array.
+ * Class Invariant: - Each key of the set maps to a distinct index in [0, getKeyCount( )).
+ *                  - The set is fixed at construction.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <algorithm>
+
+#include "PhonePerfectHash.h"
+#include "PhoneKey.h"
+
+using namespace std;
+
+// Constructor
+// Description: Builds the levels one at a time: a first pass over the keys left marks the bits
+//              hit once and the bits hit more than once, a second pass keeps the keys whose bit
+//              was hit more than once for the next level.
+PhonePerfectHash::PhonePerfectHash(const vector<unsigned long long> &keys) : keyCount((unsigned int)keys.size())
+{
+    vector<unsigned long long> left(keys);
+    vector<unsigned long long> collided;
+    for (unsigned int level = 0; level < MAX_LEVELS && !left.empty(); level++)
+    {
+        unsigned long long size = ((unsigned long long)(left.size() * GAMMA) + 511) / 512 * 512;
+        Level current = {bits.size() * 64, size};
+        levels.push_back(current);
+        bits.resize(bits.size() + size / 64, 0);
+        collided.assign(size / 64, 0);
+
+        unsigned long long *levelBits = bits.data() + current.offset / 64;
+        for (unsigned int i = 0; i < left.size(); i++)
+        {
+            unsigned long long position = positionOf(left[i], level, size);
+            unsigned long long bit = 1ULL << (position % 64);
+            if (levelBits[position / 64] & bit)
+            {
+                collided[position / 64] |= bit;
+            }
+            levelBits[position / 64] |= bit;
+        }
+
+        unsigned int kept = 0;
+        for (unsigned int i = 0; i < left.size(); i++)
+        {
+            unsigned long long position = positionOf(left[i], level, size);
+            if (collided[position / 64] & (1ULL << (position % 64)))
+            {
+                left[kept++] = left[i];
+            }
+        }
+        left.resize(kept);
+        for (unsigned long long w = 0; w < size / 64; w++)
+        {
+            levelBits[w] &= ~collided[w];
+        }
+    }
+
+    ranks.resize(bits.size() / 8 + 1);
+    unsigned long long setBits = 0;
+    for (unsigned long long w = 0; w < bits.size(); w++)
+    {
+        if (w % 8 == 0)
+        {
+            ranks[w / 8] = (unsigned int)setBits;
+        }
+        setBits += __builtin_popcountll(bits[w]);
+    }
+    ranks.back() = (unsigned int)setBits;
+
+    // The keys left take the last indices.
+    sort(left.begin(), left.end());
+    for (unsigned int i = 0; i < left.size(); i++)
+    {
+        fallback.push_back(make_pair(left[i], (unsigned int)setBits + i));
+    }
+}
+
+// Description: Returns the index of key if it is in the set, an arbitrary index in [0, getKeyCount( ))
+//              or getKeyCount( ) otherwise.
+unsigned int PhonePerfectHash::indexOf(unsigned long long key) const
+{
+    for (unsigned int level = 0; level < levels.size(); level++)
+    {
+        unsigned long long position = levels[level].offset + positionOf(key, level, levels[level].size);
+        if (bits[position / 64] & (1ULL << (position % 64)))
+        {
+            return (unsigned int)rank(position);
+        }
+    }
+
+    vector<pair<unsigned long long, unsigned int>>::const_iterator it =
+        lower_bound(fallback.begin(), fallback.end(), make_pair(key, 0U));
+    return (it != fallback.end() && it->first == key) ? it->second : keyCount;
+}
+
+// Description: Returns the number of keys in the set.
+unsigned int PhonePerfectHash::getKeyCount() const
+{
+    return keyCount;
+}
+
+// Description: Returns the number of levels built.
+unsigned int PhonePerfectHash::getLevelCount() const
+{
+    return (unsigned int)levels.size();
+}
+
+// Description: Returns the memory used by the function, in bytes.
+unsigned long long PhonePerfectHash::getMemoryUsage() const
+{
+    return bits.size() * sizeof(unsigned long long) + ranks.size() * sizeof(unsigned int) +
+           fallback.size() * sizeof(pair<unsigned long long, unsigned int>) + levels.size() * sizeof(Level) +
+           sizeof(PhonePerfectHash);
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Returns the bit of a key in a level of size bits: the key scrambled with a
+//              seed per level, scaled to size (multiply-shift rather than modulo).
+unsigned long long PhonePerfectHash::positionOf(unsigned long long key, unsigned int level, unsigned long long size)
+{
+    unsigned long long hash = mixKey(key + (level + 1) * 0x9e3779b97f4a7c15ULL);
+    return (unsigned long long)(((unsigned __int128)hash * size) >> 64);
+}
+
+// Description: Returns the number of set bits before bit position of bits: the rank of its
+//              block of 512 bits plus the set bits of the block's words before it.
+unsigned long long PhonePerfectHash::rank(unsigned long long position) const
+{
+    unsigned long long word = position / 64;
+    unsigned long long count = ranks[word / 8];
+    for (unsigned long long w = word / 8 * 8; w < word; w++)
+    {
+        count += __builtin_popcountll(bits[w]);
+    }
+    return count + __builtin_popcountll(bits[word] & ((1ULL << (position % 64)) - 1));
+}
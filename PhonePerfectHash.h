@@ -0,0 +1,78 @@
+/*
+ * PhonePerfectHash.h
+ *
+ * Class Description: Minimal perfect hash function over a fixed set of packed phone numbers
+ *                    (BBHash construction): maps each of the n keys of the set to a distinct
+ *                    index in [0, n), using about 3.5 bits per key and no key storage.
+ *                    Level 0 is a bit array of GAMMA * n bits; each key hashes (with the level's
+ *                    seed) to one bit, which is set if no other key of the level hashes there.
+ *                    The keys that collided go on to level 1, of GAMMA times as many bits as keys
+ *                    left, and so on. The index of a key is the rank (number of set bits before it)
+ *                    of its bit in the concatenated levels. The few keys left after MAX_LEVELS
+ *                    levels are kept in a sorted fallback array.
+ *                    A key outside the set maps to an arbitrary index (or to none): the caller
+ *                    must compare the key stored at the index returned.
+ * Class Invariant: - Each key of the set maps to a distinct index in [0, getKeyCount( )).
+ *                  - The set is fixed at construction.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef PHONE_PERFECT_HASH_H
+#define PHONE_PERFECT_HASH_H
+
+#include <utility>
+#include <vector>
+
+using std::pair;
+using std::vector;
+
+class PhonePerfectHash
+{
+
+private:
+  // A level: the bits [offset, offset + size) of bits.
+  struct Level
+  {
+    unsigned long long offset;
+    unsigned long long size;
+  };
+
+  vector<Level> levels;
+  vector<unsigned long long> bits;    // Bit arrays of every level, concatenated (each a multiple of 512 bits).
+  vector<unsigned int> ranks;         // ranks[b] is the number of set bits before block b of 512 bits.
+  vector<pair<unsigned long long, unsigned int>> fallback; // (key, index) of the keys left after the last level, sorted.
+  unsigned int keyCount = 0;
+
+  // Description: Returns the bit of a key in a level of size bits.
+  static unsigned long long positionOf(unsigned long long key, unsigned int level, unsigned long long size);
+
+  // Description: Returns the number of set bits before bit position of bits.
+  unsigned long long rank(unsigned long long position) const;
+
+public:
+  const static unsigned int MAX_LEVELS = 24;
+  constexpr static double GAMMA = 2.0; // Bits per key of each level: more bits, fewer levels visited per lookup.
+
+  // Constructor
+  // Description: Builds the function over keys (which must be distinct).
+  // Time Efficiency: O(n) expected
+  PhonePerfectHash(const vector<unsigned long long> &keys);
+
+  // Description: Returns the index of key if it is in the set, an arbitrary index in [0, getKeyCount( ))
+  //              or getKeyCount( ) otherwise.
+  // Time Efficiency: O(1) expected (about 1.6 levels visited for a key of the set)
+  unsigned int indexOf(unsigned long long key) const;
+
+  // Description: Returns the number of keys in the set.
+  unsigned int getKeyCount() const;
+
+  // Description: Returns the number of levels built.
+  unsigned int getLevelCount() const;
+
+  // Description: Returns the memory used by the function, in bytes.
+  unsigned long long getMemoryUsage() const;
+};
+
+#endif
@@ -0,0 +1,646 @@
+/*
+ * RosterCodec.cpp
+ *
+ * Class Description: Compact binary roster: blocks of columnar member records (packed phones,
+ *                    dictionary coded names and email domains, integer cards), each column zlib
+ *                    compressed unless that does not pay, written from a List and loaded back
+ *                    into a List a block at a time.
+ * Class Invariant: - Loading a roster written from a List inserts members equal (name, phone,
+ *                    email and credit card) to those of the List.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <unordered_map>
+#include <zlib.h>
+
+#include "RosterCodec.h"
+#include "PhoneKey.h"
+#include "ErrorCode.h"
+#include "UnableToOpenFileException.h"
+
+using namespace std;
+
+static const char MAGIC[4] = {'R', 'S', 'T', 'R'};
+static const unsigned int VERSION = 1;
+static const unsigned int HEADER_SIZE = 8;                                        // Magic, version.
+static const unsigned int BLOCK_HEADER_SIZE = 8 + 8 * RosterCodec::COLUMN_COUNT; // Record count, CRC-32, column sizes.
+static const unsigned int MAX_COLUMN_SIZE = 1 << 30; // Sanity bound on the uncompressed size of a column.
+static const unsigned int SAMPLE_SIZE = 16384;      // Bytes of a column compressed to see if it compresses.
+static const char *const MALFORMED_ROSTER = "Malformed binary roster.";
+
+// Columns of a block, in the order they are stored.
+enum Column
+{
+    DICTIONARY = 0, // Word count, then the words (length prefixed).
+    PHONES,         // PHONE_BYTES per member.
+    NAMES,          // Word count, then word numbers.
+    EMAILS,         // EmailKind, then the domain number (EMAIL_FROM_NAME, EMAIL_LOCAL).
+    CARDS,          // Digit count (0: in the strings column), then the value in CARD_BYTES[digit count] bytes.
+    STRINGS         // Length prefixed strings, in member order.
+};
+
+static const unsigned int PHONE_BYTES = 5;
+static const unsigned long long RAW_PHONE = (1ULL << 40) - 1; // Phone kept in the strings column.
+static const unsigned int MAX_CARD_DIGITS = 19;              // 10^19 - 1 fits in 64 bits.
+
+// Bytes holding the value of a card of d digits: the bytes of 10^d - 1.
+static const unsigned char CARD_BYTES[MAX_CARD_DIGITS + 1] = {0, 1, 1, 2, 2, 3, 3, 3, 4, 4, 5, 5, 5, 6, 6, 7, 7, 8, 8, 8};
+
+// Kinds of email records.
+enum EmailKind
+{
+    EMAIL_FROM_NAME = 0, // first.last@domain: domain number.
+    EMAIL_LOCAL = 1,     // local@domain: domain number, local part in the strings column.
+    EMAIL_RAW = 2        // No '@': the email in the strings column.
+};
+
+// Description: Reads a column, throwing on any read past its end.
+struct RosterCodec::Cursor
+{
+    const unsigned char *next;
+    const unsigned char *end;
+
+    // Description: Returns the next n bytes.
+    // Exception: Throws UnableToOpenFileException if fewer than n bytes are left.
+    const unsigned char *take(unsigned long long n)
+    {
+        if (n > (unsigned long long)(end - next))
+        {
+            throw UnableToOpenFileException(MALFORMED_ROSTER);
+        }
+        const unsigned char *taken = next;
+        next += n;
+        return taken;
+    }
+
+    // Description: Returns the next variable length integer.
+    // Exception: Throws UnableToOpenFileException if it is cut or longer than 64 bits.
+    unsigned long long varint()
+    {
+        unsigned long long value = 0;
+        for (unsigned int shift = 0; shift < 64; shift += 7)
+        {
+            unsigned char byte = *take(1);
+            value |= (unsigned long long)(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+        throw UnableToOpenFileException(MALFORMED_ROSTER);
+    }
+
+    // Description: Replaces text with the next length prefixed string.
+    void text(string &text)
+    {
+        unsigned long long length = varint();
+        text.assign((const char *)take(length), length);
+    }
+};
+
+// Description: Returns the little endian 32-bit integer at bytes.
+static unsigned int readWord(const unsigned char *bytes)
+{
+    return (unsigned int)bytes[0] | (unsigned int)bytes[1] << 8 | (unsigned int)bytes[2] << 16 |
+           (unsigned int)bytes[3] << 24;
+}
+
+// Description: Stores value at bytes, little endian.
+static void writeWord(char *bytes, unsigned int value)
+{
+    for (unsigned int b = 0; b < 4; b++)
+    {
+        bytes[b] = (char)(value >> (8 * b));
+    }
+}
+
+// Constructor
+RosterCodec::RosterCodec(int aCompressionLevel) : compressionLevel(aCompressionLevel) {}
+
+// Description: Writes the members of list to os, as a binary roster.
+// Exception: Throws UnableToOpenFileException if os fails.
+void RosterCodec::writeList(ostream &os, const List &list)
+{
+    encodedBytes = 0;
+    rawBytes = 0;
+    recordCount = 0;
+
+    char header[HEADER_SIZE] = {MAGIC[0], MAGIC[1], MAGIC[2], MAGIC[3], (char)VERSION, 0, 0, 0};
+    os.write(header, HEADER_SIZE);
+    encodedBytes += HEADER_SIZE;
+
+    vector<const Member *> block;
+    block.reserve(BLOCK_RECORDS);
+    string columns[COLUMN_COUNT], body;
+    for (List::const_iterator it = list.begin(); it != list.end(); ++it)
+    {
+        block.push_back(&*it);
+        if (block.size() == BLOCK_RECORDS)
+        {
+            writeBlock(os, block, columns, body);
+        }
+    }
+    if (!block.empty())
+    {
+        writeBlock(os, block, columns, body);
+    }
+    writeBlock(os, block, columns, body); // empty block: end of roster
+
+    if (!os)
+    {
+        throw UnableToOpenFileException();
+    }
+}
+
+// Description: Reads a binary roster from is and inserts its members into list.
+//              The stored (not compressed) columns are decoded in place, in the block read from is.
+// Exception: Throws UnableToOpenFileException if is cannot be read or is not a valid binary roster.
+void RosterCodec::loadInto(istream &is, List &list)
+{
+    encodedBytes = 0;
+    rawBytes = 0;
+    recordCount = 0;
+    loadedCount = 0;
+    rejectedCount = 0;
+
+    unsigned char header[HEADER_SIZE];
+    if (!is.read((char *)header, HEADER_SIZE))
+    {
+        throw UnableToOpenFileException(MALFORMED_ROSTER);
+    }
+    if (header[0] != MAGIC[0] || header[1] != MAGIC[1] || header[2] != MAGIC[2] || header[3] != MAGIC[3] ||
+        header[4] != VERSION)
+    {
+        throw UnableToOpenFileException(MALFORMED_ROSTER);
+    }
+    encodedBytes += HEADER_SIZE;
+
+    string body, inflated[COLUMN_COUNT];
+    vector<Member *> members;
+    members.reserve(INSERT_BATCH);
+    while (true)
+    {
+        unsigned char blockHeader[BLOCK_HEADER_SIZE];
+        if (!is.read((char *)blockHeader, BLOCK_HEADER_SIZE))
+        {
+            throw UnableToOpenFileException(MALFORMED_ROSTER); // cut before the end block
+        }
+        encodedBytes += BLOCK_HEADER_SIZE;
+        unsigned int count = readWord(blockHeader);
+        if (count == 0)
+        {
+            return;
+        }
+
+        // Column c: rawSizes[c] bytes, stored in storedSizes[c] bytes (compressed if fewer).
+        unsigned int rawSizes[COLUMN_COUNT], storedSizes[COLUMN_COUNT];
+        unsigned long long bodySize = 0;
+        for (unsigned int c = 0; c < COLUMN_COUNT; c++)
+        {
+            rawSizes[c] = readWord(blockHeader + 8 + 8 * c);
+            storedSizes[c] = readWord(blockHeader + 12 + 8 * c);
+            if (rawSizes[c] > MAX_COLUMN_SIZE || storedSizes[c] > rawSizes[c])
+            {
+                throw UnableToOpenFileException(MALFORMED_ROSTER);
+            }
+            bodySize += storedSizes[c];
+        }
+        if (count > rawSizes[PHONES])
+        {
+            throw UnableToOpenFileException(MALFORMED_ROSTER);
+        }
+
+        body.resize(bodySize);
+        if (!is.read(&body[0], bodySize) || crc32(0, (const Bytef *)body.data(), bodySize) != readWord(blockHeader + 4))
+        {
+            throw UnableToOpenFileException(MALFORMED_ROSTER);
+        }
+        encodedBytes += bodySize;
+
+        Cursor columns[COLUMN_COUNT];
+        const unsigned char *next = (const unsigned char *)body.data();
+        for (unsigned int c = 0; c < COLUMN_COUNT; c++)
+        {
+            if (storedSizes[c] == rawSizes[c])
+            {
+                columns[c].next = next;
+            }
+            else
+            {
+                inflated[c].resize(rawSizes[c]);
+                uLongf inflatedSize = rawSizes[c];
+                if (uncompress((Bytef *)&inflated[c][0], &inflatedSize, next, storedSizes[c]) != Z_OK ||
+                    inflatedSize != rawSizes[c])
+                {
+                    throw UnableToOpenFileException(MALFORMED_ROSTER);
+                }
+                columns[c].next = (const unsigned char *)inflated[c].data();
+            }
+            columns[c].end = columns[c].next + rawSizes[c];
+            next += storedSizes[c];
+            rawBytes += rawSizes[c];
+        }
+
+        try
+        {
+            decodeBlock(columns, count, list, members);
+        }
+        catch (UnableToOpenFileException &)
+        {
+            for (unsigned int i = 0; i < members.size(); i++)
+            {
+                delete members[i];
+            }
+            throw;
+        }
+        recordCount += count;
+    }
+}
+
+// Description: Returns the number of members written or decoded by the last call.
+unsigned int RosterCodec::getRecordCount() const
+{
+    return recordCount;
+}
+
+// Description: Returns the size of the roster written or read by the last call, in bytes.
+unsigned long long RosterCodec::getEncodedBytes() const
+{
+    return encodedBytes;
+}
+
+// Description: Returns the size of the columns of the last call before compression, in bytes.
+unsigned long long RosterCodec::getRawBytes() const
+{
+    return rawBytes;
+}
+
+// Description: Returns the number of members inserted by the last loadInto( ).
+unsigned int RosterCodec::getLoadedCount() const
+{
+    return loadedCount;
+}
+
+// Description: Returns the number of members the last loadInto( ) could not insert.
+unsigned int RosterCodec::getRejectedCount() const
+{
+    return rejectedCount;
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Appends value as a variable length integer (7 bits per byte, lowest first).
+static void appendVarint(string &column, unsigned long long value)
+{
+    while (value >= 0x80)
+    {
+        column.push_back((char)(value | 0x80));
+        value >>= 7;
+    }
+    column.push_back((char)value);
+}
+
+// Description: Appends a length prefixed string.
+static void appendText(string &column, const string &text)
+{
+    appendVarint(column, text.size());
+    column += text;
+}
+
+// Description: Returns true if card is 1 to MAX_CARD_DIGITS digits.
+static bool isNumeric(const string &card)
+{
+    if (card.empty() || card.size() > MAX_CARD_DIGITS)
+    {
+        return false;
+    }
+    for (unsigned int i = 0; i < card.size(); i++)
+    {
+        if (card[i] < '0' || card[i] > '9')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Description: Returns the dictionary number of word, adding it to the dictionary if it is new.
+static unsigned int wordNumber(unordered_map<string, unsigned int> &numbers, vector<const string *> &words, const string &word)
+{
+    pair<unordered_map<string, unsigned int>::iterator, bool> entry = numbers.emplace(word, (unsigned int)words.size());
+    if (entry.second)
+    {
+        words.push_back(&entry.first->first);
+    }
+    return entry.first->second;
+}
+
+// Description: Encodes members into the (uncompressed) columns of one block.
+void RosterCodec::encodeBlock(const vector<const Member *> &members, string *columns)
+{
+    unordered_map<string, unsigned int> numbers;
+    vector<const string *> words;
+    for (unsigned int c = 0; c < COLUMN_COUNT; c++)
+    {
+        columns[c].clear();
+    }
+    string &phones = columns[PHONES], &names = columns[NAMES], &emails = columns[EMAILS], &cards = columns[CARDS],
+           &strings = columns[STRINGS];
+
+    vector<string> nameWords;
+    for (unsigned int m = 0; m < members.size(); m++)
+    {
+        const Member &member = *members[m];
+
+        // A member's phone is always its packed key: RAW_PHONE is only read, from older rosters.
+        unsigned long long packed = member.getPhoneKey();
+        for (unsigned int b = 0; b < PHONE_BYTES; b++)
+        {
+            phones.push_back((char)(packed >> (8 * b)));
+        }
+
+        // Words separated by single spaces, so that joining them with spaces gives the name back.
+        string name = member.getName();
+        nameWords.clear();
+        size_t start = 0;
+        while (true)
+        {
+            size_t space = name.find(' ', start);
+            nameWords.push_back(name.substr(start, space - start));
+            if (space == string::npos)
+            {
+                break;
+            }
+            start = space + 1;
+        }
+        appendVarint(names, nameWords.size());
+        for (unsigned int w = 0; w < nameWords.size(); w++)
+        {
+            appendVarint(names, wordNumber(numbers, words, nameWords[w]));
+        }
+
+        string email = member.getEmail();
+        size_t at = email.rfind('@');
+        if (at == string::npos)
+        {
+            emails.push_back((char)EMAIL_RAW);
+            appendText(strings, email);
+        }
+        else
+        {
+            bool fromName = nameWords.size() == 2 && at == nameWords[0].size() + 1 + nameWords[1].size() &&
+                            email.compare(0, nameWords[0].size(), nameWords[0]) == 0 &&
+                            email[nameWords[0].size()] == '.' &&
+                            email.compare(nameWords[0].size() + 1, nameWords[1].size(), nameWords[1]) == 0;
+            emails.push_back((char)(fromName ? EMAIL_FROM_NAME : EMAIL_LOCAL));
+            appendVarint(emails, wordNumber(numbers, words, email.substr(at + 1)));
+            if (!fromName)
+            {
+                appendText(strings, email.substr(0, at));
+            }
+        }
+
+        string card = member.getCreditCard();
+        if (isNumeric(card))
+        {
+            unsigned long long value = stoull(card);
+            cards.push_back((char)card.size());
+            for (unsigned int b = 0; b < CARD_BYTES[card.size()]; b++)
+            {
+                cards.push_back((char)(value >> (8 * b)));
+            }
+        }
+        else
+        {
+            cards.push_back(0);
+            appendText(strings, card);
+        }
+    }
+
+    appendVarint(columns[DICTIONARY], words.size());
+    for (unsigned int w = 0; w < words.size(); w++)
+    {
+        appendText(columns[DICTIONARY], *words[w]);
+    }
+}
+
+// Description: Decodes the recordCount members of the columns of a block and inserts them into list,
+//              INSERT_BATCH at a time (members holds those decoded and not inserted yet).
+// Exception: Throws UnableToOpenFileException if the block is malformed.
+void RosterCodec::decodeBlock(Cursor *columns, unsigned int recordCount, List &list, vector<Member *> &members)
+{
+    Cursor &phones = columns[PHONES], &names = columns[NAMES], &emails = columns[EMAILS], &cards = columns[CARDS],
+           &strings = columns[STRINGS];
+
+    unsigned long long wordCount = columns[DICTIONARY].varint();
+    if (wordCount > (unsigned long long)(columns[DICTIONARY].end - columns[DICTIONARY].next))
+    {
+        throw UnableToOpenFileException(MALFORMED_ROSTER);
+    }
+    vector<string> words(wordCount);
+    for (unsigned long long w = 0; w < wordCount; w++)
+    {
+        columns[DICTIONARY].text(words[w]);
+    }
+
+    // The word with the next dictionary number of a column.
+    auto word = [&](Cursor &column) -> const string &
+    {
+        unsigned long long number = column.varint();
+        if (number >= words.size())
+        {
+            throw UnableToOpenFileException(MALFORMED_ROSTER);
+        }
+        return words[number];
+    };
+
+    string name, phone, email, card;
+    for (unsigned int m = 0; m < recordCount; m++)
+    {
+        const unsigned char *bytes = phones.take(PHONE_BYTES);
+        unsigned long long packed = 0;
+        for (unsigned int b = 0; b < PHONE_BYTES; b++)
+        {
+            packed |= (unsigned long long)bytes[b] << (8 * b);
+        }
+        if (packed == RAW_PHONE)
+        {
+            strings.text(phone);
+        }
+        else
+        {
+            phone.resize(12);
+            formatPhoneKey(packed, &phone[0]);
+        }
+
+        unsigned long long nameWordCount = names.varint();
+        name.clear();
+        const string *first = nullptr, *last = nullptr;
+        for (unsigned long long w = 0; w < nameWordCount; w++)
+        {
+            const string &nameWord = word(names);
+            if (w > 0)
+            {
+                name += ' ';
+            }
+            name += nameWord;
+            (w == 0 ? first : last) = &nameWord;
+        }
+
+        unsigned char kind = *emails.take(1);
+        if (kind == EMAIL_RAW)
+        {
+            strings.text(email);
+        }
+        else if (kind == EMAIL_FROM_NAME || kind == EMAIL_LOCAL)
+        {
+            const string &domain = word(emails);
+            if (kind == EMAIL_FROM_NAME)
+            {
+                if (nameWordCount != 2)
+                {
+                    throw UnableToOpenFileException(MALFORMED_ROSTER);
+                }
+                email.assign(*first);
+                email += '.';
+                email += *last;
+            }
+            else
+            {
+                strings.text(email);
+            }
+            email += '@';
+            email += domain;
+        }
+        else
+        {
+            throw UnableToOpenFileException(MALFORMED_ROSTER);
+        }
+
+        unsigned char digits = *cards.take(1);
+        if (digits == 0)
+        {
+            strings.text(card);
+        }
+        else if (digits <= MAX_CARD_DIGITS)
+        {
+            const unsigned char *valueBytes = cards.take(CARD_BYTES[digits]);
+            unsigned long long value = 0;
+            for (unsigned int b = 0; b < CARD_BYTES[digits]; b++)
+            {
+                value |= (unsigned long long)valueBytes[b] << (8 * b);
+            }
+            card.assign(digits, '0');
+            for (int i = digits - 1; i >= 0; i--)
+            {
+                card[i] = (char)('0' + value % 10);
+                value /= 10;
+            }
+            if (value != 0)
+            {
+                throw UnableToOpenFileException(MALFORMED_ROSTER);
+            }
+        }
+        else
+        {
+            throw UnableToOpenFileException(MALFORMED_ROSTER);
+        }
+
+        members.push_back(new Member(name, phone, email, card));
+        if (members.size() == INSERT_BATCH || m + 1 == recordCount)
+        {
+            insertBatch(list, members);
+        }
+    }
+}
+
+// Description: Returns true if zlib saves at least a quarter of [first, first + size), using the end of
+//              scratch as work space.
+// Exception: Throws UnableToOpenFileException if zlib fails.
+static bool compresses(const char *first, unsigned int size, int level, string &scratch)
+{
+    size_t offset = scratch.size();
+    uLongf compressedSize = compressBound(size);
+    scratch.resize(offset + compressedSize);
+    if (compress2((Bytef *)&scratch[offset], &compressedSize, (const Bytef *)first, size, level) != Z_OK)
+    {
+        throw UnableToOpenFileException();
+    }
+    scratch.resize(offset);
+    return compressedSize < size - size / 4;
+}
+
+// Description: Encodes and writes one block, then empties members. An empty block is the end of the roster.
+//              A column is stored compressed only if zlib saves at least a quarter of it: the random
+//              digits of phones and cards barely compress, and inflating them would cost more than
+//              reading them. Whether a column compresses is first tried on its first SAMPLE_SIZE bytes.
+void RosterCodec::writeBlock(ostream &os, vector<const Member *> &members, string *columns, string &body)
+{
+    char blockHeader[BLOCK_HEADER_SIZE] = {};
+    writeWord(blockHeader, (unsigned int)members.size());
+    body.clear();
+    if (!members.empty())
+    {
+        encodeBlock(members, columns);
+        for (unsigned int c = 0; c < COLUMN_COUNT; c++)
+        {
+            unsigned int rawSize = (unsigned int)columns[c].size();
+            size_t offset = body.size();
+            uLongf compressedSize = rawSize;
+            if (compresses(columns[c].data(), min(rawSize, SAMPLE_SIZE), compressionLevel, body))
+            {
+                compressedSize = compressBound(rawSize);
+                body.resize(offset + compressedSize);
+                if (compress2((Bytef *)&body[offset], &compressedSize, (const Bytef *)columns[c].data(), rawSize,
+                              compressionLevel) != Z_OK)
+                {
+                    throw UnableToOpenFileException();
+                }
+            }
+            if (compressedSize < rawSize - rawSize / 4)
+            {
+                body.resize(offset + compressedSize);
+            }
+            else
+            {
+                body.replace(offset, string::npos, columns[c]);
+                compressedSize = rawSize;
+            }
+            writeWord(blockHeader + 8 + 8 * c, rawSize);
+            writeWord(blockHeader + 12 + 8 * c, (unsigned int)compressedSize);
+            rawBytes += rawSize;
+        }
+        writeWord(blockHeader + 4, (unsigned int)crc32(0, (const Bytef *)body.data(), body.size()));
+    }
+    os.write(blockHeader, BLOCK_HEADER_SIZE);
+    os.write(body.data(), body.size());
+
+    encodedBytes += BLOCK_HEADER_SIZE + body.size();
+    recordCount += (unsigned int)members.size();
+    members.clear();
+}
+
+// Description: Inserts members into list, reporting and deleting the members not inserted, then empties members.
+void RosterCodec::insertBatch(List &list, vector<Member *> &members)
+{
+    vector<ErrorCode> codes(members.size());
+    list.insertMany(members.data(), codes.data(), (unsigned int)members.size());
+    for (unsigned int i = 0; i < members.size(); i++)
+    {
+        if (codes[i] == ErrorCode::OK)
+        {
+            loadedCount++;
+        }
+        else
+        {
+            cout << "Exception: " << errorMessage(codes[i]) << endl;
+            delete members[i];
+            rejectedCount++;
+        }
+    }
+    members.clear();
+}
@@ -0,0 +1,111 @@
+/*
+ * RosterCodec.h
+ *
+ * Class Description: Compact binary roster: writes the members of a List to a stream and loads
+ *                    them back into a List, about a quarter of the size of the text roster written
+ *                    by List::exportTo( ).
+ *                    A roster is a header ("RSTR", format version) followed by blocks of up to
+ *                    BLOCK_RECORDS members and an empty block marking the end. A block (checked by
+ *                    a CRC-32) is columnar; each column is compressed with zlib if that saves at least a quarter
+ *                    of it, and stored as is otherwise:
+ *                    - a dictionary of the words of the block (the space separated words of the
+ *                      names, and the email domains), each word once,
+ *                    - phones: the packed 10 digits (see PhoneKey.h) in 5 bytes,
+ *                    - names: number of words, then the dictionary number of each word,
+ *                    - emails: "first.last@domain" (first and last being the words of a two word
+ *                      name) is the domain's dictionary number only; other emails keep their
+ *                      local part, or are kept whole if they have no '@',
+ *                    - cards: all digit cards (up to 19 digits) are their digit count and value
+ *                      (in the fewest bytes holding any value of that many digits: 6 for 13 digits),
+ *                    - strings: the text of whatever the columns above could not encode.
+ *                    Integers are little endian; variable length ones are LEB128 (7 bits per byte).
+ *                    Loading reads a block at a time and inserts its members with
+ *                    List::insertMany( ) as they are decoded, INSERT_BATCH at a time.
+ * Class Invariant: - Loading a roster written from a List inserts members equal (name, phone,
+ *                    email and credit card) to those of the List.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef ROSTER_CODEC_H
+#define ROSTER_CODEC_H
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+#include "List.h"
+#include "Member.h"
+
+using std::istream;
+using std::ostream;
+using std::string;
+using std::vector;
+
+class RosterCodec
+{
+
+public:
+  const static unsigned int COLUMN_COUNT = 6;      // Columns of a block.
+  const static unsigned int BLOCK_RECORDS = 65536; // Members per block.
+  const static unsigned int INSERT_BATCH = 256;    // Members decoded per List::insertMany( ) (still in cache).
+  const static int DEFAULT_LEVEL = 6;              // zlib compression level (1: fastest .. 9: smallest).
+
+private:
+  struct Cursor; // Reads a decoded column (see RosterCodec.cpp).
+
+  int compressionLevel;
+  unsigned long long encodedBytes = 0; // Bytes written or read by the last call.
+  unsigned long long rawBytes = 0;     // Uncompressed size of the columns of the last call.
+  unsigned int recordCount = 0;        // Members written or decoded by the last call.
+  unsigned int loadedCount = 0;
+  unsigned int rejectedCount = 0;
+
+  // Description: Encodes members into the (uncompressed) columns of one block.
+  static void encodeBlock(const vector<const Member *> &members, string *columns);
+
+  // Description: Decodes the recordCount members of the (uncompressed) columns of a block and inserts them into list.
+  // Exception: Throws UnableToOpenFileException if the block is malformed.
+  void decodeBlock(Cursor *columns, unsigned int recordCount, List &list, vector<Member *> &members);
+
+  // Description: Encodes, compresses and writes one block (body: work buffer), then empties members.
+  void writeBlock(ostream &os, vector<const Member *> &members, string *columns, string &body);
+
+  // Description: Inserts members into list, reporting and deleting the members not inserted, then empties members.
+  void insertBatch(List &list, vector<Member *> &members);
+
+public:
+  // Constructor
+  // Description: Creates a codec writing blocks compressed at aCompressionLevel (zlib level 1 to 9).
+  RosterCodec(int aCompressionLevel = DEFAULT_LEVEL);
+
+  // Description: Writes the members of list to os, as a binary roster.
+  // Postcondition: List remains unchanged. getRecordCount( ) members and getEncodedBytes( ) bytes written.
+  // Exception: Throws UnableToOpenFileException if os fails.
+  void writeList(ostream &os, const List &list);
+
+  // Description: Reads a binary roster from is and inserts its members into list. A member that cannot be
+  //              inserted (e.g. duplicate phone number) is reported on cout, as by the test driver, and deleted.
+  // Postcondition: getLoadedCount( ) members inserted, getRejectedCount( ) rejected.
+  // Exception: Throws UnableToOpenFileException if is cannot be read or is not a valid binary roster
+  //            (the members decoded before the fault are inserted).
+  void loadInto(istream &is, List &list);
+
+  // Description: Returns the number of members written or decoded by the last call.
+  unsigned int getRecordCount() const;
+
+  // Description: Returns the size of the roster written or read by the last call, in bytes.
+  unsigned long long getEncodedBytes() const;
+
+  // Description: Returns the size of the columns of the last call before compression, in bytes.
+  unsigned long long getRawBytes() const;
+
+  // Description: Returns the number of members inserted by the last loadInto( ).
+  unsigned int getLoadedCount() const;
+
+  // Description: Returns the number of members the last loadInto( ) could not insert.
+  unsigned int getRejectedCount() const;
+};
+
+#endif
@@ -0,0 +1,476 @@
+/*
+ * RosterMerge.cpp
+ *
+ * Class Description: Merges an incoming member roster into an existing one (hash join on the
+ *                    phone number) and classifies every incoming record as new, duplicate or conflict.
+ *                    Records are radix partitioned on the hash of their phone number so that each
+ *                    partition (its records and its join table) fits in cache, then the partitions
+ *                    are joined independently by a pool of threads.
+ * Class Invariant: - After run( ), every well-formed incoming line is in exactly one of
+ *                    getNew( ), getDuplicates( ) and getConflicts( ), in the order of the
+ *                    incoming roster.
+ *                  - The reported lines point into the rosters held by this object.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <thread>
+
+#include "RosterMerge.h"
+#include "PhoneKey.h"
+#include "UnableToOpenFileException.h"
+
+using namespace std;
+
+// Description: Runs work(t) for t = 0 .. count - 1, each on its own thread (t = 0 on the calling thread).
+template <class Work>
+static void runThreads(unsigned int count, Work work)
+{
+    vector<thread> threads;
+    for (unsigned int t = 1; t < count; t++)
+    {
+        threads.emplace_back(work, t);
+    }
+    work(0);
+    for (unsigned int t = 0; t < threads.size(); t++)
+    {
+        threads[t].join();
+    }
+}
+
+// Description: Returns the start of the next ", " field separator in [first, last), nullptr if none.
+static const char *findSeparator(const char *first, const char *last)
+{
+    while (first < last)
+    {
+        const char *comma = (const char *)memchr(first, ',', last - first);
+        if (comma == nullptr || comma + 1 == last)
+        {
+            return nullptr;
+        }
+        if (comma[1] == ' ')
+        {
+            return comma;
+        }
+        first = comma + 1;
+    }
+    return nullptr;
+}
+
+// Description: Returns the end of the line starting at "line" (its '\n', or '\0' at the end of the roster),
+//              before any '\r'.
+static const char *endOfLine(const char *line)
+{
+    const char *end = line + strcspn(line, "\n");
+    if (end > line && end[-1] == '\r')
+    {
+        end--;
+    }
+    return end;
+}
+
+// Description: Returns the start of the email field of a well-formed line (email and credit card follow).
+static const char *detailsOf(const char *line, const char *end)
+{
+    const char *nameEnd = findSeparator(line, end);
+    return findSeparator(nameEnd + 2, end) + 2;
+}
+
+// Description: FNV-1a hash of [first, last).
+static unsigned long long hashBytes(const char *first, const char *last)
+{
+    unsigned long long hash = 14695981039346656037ULL;
+    for (const char *c = first; c != last; c++)
+    {
+        hash = (hash ^ (unsigned char)*c) * 1099511628211ULL;
+    }
+    return hash;
+}
+
+// Description: Returns the partition of a packed phone number: the top "bits" bits of its hash.
+static unsigned int partitionOf(unsigned long long key, unsigned int bits)
+{
+    return bits == 0 ? 0 : (unsigned int)(mixKey(key) >> (64 - bits));
+}
+
+// Constructor
+RosterMerge::RosterMerge(string anExistingRoster, string anIncomingRoster, unsigned int aThreadCount)
+    : existingRoster(move(anExistingRoster)), incomingRoster(move(anIncomingRoster)), threadCount(aThreadCount)
+{
+    if (threadCount == 0)
+    {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+}
+
+// Description: Reads a whole roster file.
+// Exception: Throws UnableToOpenFileException if the file cannot be read.
+string RosterMerge::readFile(const string &fileName)
+{
+    ifstream inFile(fileName, ios::binary | ios::ate);
+    if (!inFile)
+    {
+        throw UnableToOpenFileException();
+    }
+    string contents((size_t)inFile.tellg(), '\0');
+    inFile.seekg(0);
+    if (!inFile.read(&contents[0], contents.size()))
+    {
+        throw UnableToOpenFileException("Unable to read file.");
+    }
+    return contents;
+}
+
+// Description: Joins the incoming roster with the existing one and classifies the incoming records.
+//              1. Each roster is parsed in parallel slices.
+//              2. The number of partitions is chosen so that a partition holds about PARTITION_SIZE
+//                 records of both rosters, and the records are scattered to their partitions.
+//              3. The threads join the partitions, taking the next one from a shared counter.
+//              4. The results of the threads are concatenated and put back in incoming roster order.
+void RosterMerge::run()
+{
+    newRecords.clear();
+    duplicates.clear();
+    conflicts.clear();
+    malformedCount = 0;
+    existingCount = 0;
+    existingRepeats = 0;
+
+    vector<vector<Record>> existingChunks(threadCount);
+    vector<vector<Record>> incomingChunks(threadCount);
+    parseChunks(existingRoster, existingChunks, malformedCount);
+    parseChunks(incomingRoster, incomingChunks, malformedCount);
+
+    unsigned long long total = 0;
+    for (unsigned int t = 0; t < threadCount; t++)
+    {
+        existingCount += existingChunks[t].size();
+        total += existingChunks[t].size() + incomingChunks[t].size();
+    }
+    unsigned int bits = 0;
+    while (bits < MAX_PARTITION_BITS && (total >> bits) > PARTITION_SIZE)
+    {
+        bits++;
+    }
+
+    Partitions existing;
+    Partitions incoming;
+    scatter(existingChunks, bits, existing);
+    scatter(incomingChunks, bits, incoming);
+
+    atomic<unsigned int> nextPartition(0);
+    vector<JoinResult> results(threadCount);
+    runThreads(threadCount, [&](unsigned int t)
+               { join(existing, incoming, 1u << bits, nextPartition, results[t]); });
+
+    for (unsigned int t = 0; t < threadCount; t++)
+    {
+        newRecords.insert(newRecords.end(), results[t].newRecords.begin(), results[t].newRecords.end());
+        duplicates.insert(duplicates.end(), results[t].duplicates.begin(), results[t].duplicates.end());
+        conflicts.insert(conflicts.end(), results[t].conflicts.begin(), results[t].conflicts.end());
+        existingRepeats += results[t].existingRepeats;
+    }
+
+    // The lines all point into incomingRoster: pointer order is file order.
+    // The three lists are sorted concurrently.
+    runThreads(3, [&](unsigned int t)
+               {
+                   if (t == 0)
+                   {
+                       sort(newRecords.begin(), newRecords.end());
+                   }
+                   else if (t == 1)
+                   {
+                       sort(duplicates.begin(), duplicates.end());
+                   }
+                   else
+                   {
+                       sort(conflicts.begin(), conflicts.end(), [](const Conflict &a, const Conflict &b)
+                            { return a.incoming < b.incoming; });
+                   } });
+}
+
+// Description: Incoming lines whose phone number was not seen before (in file order).
+const vector<const char *> &RosterMerge::getNew() const
+{
+    return newRecords;
+}
+
+// Description: Incoming lines identical (phone, email, credit card) to a record seen before.
+const vector<const char *> &RosterMerge::getDuplicates() const
+{
+    return duplicates;
+}
+
+// Description: Incoming lines whose phone number was seen before with a different email or credit card.
+const vector<RosterMerge::Conflict> &RosterMerge::getConflicts() const
+{
+    return conflicts;
+}
+
+// Description: Number of lines of either roster that could not be parsed.
+unsigned long long RosterMerge::getMalformedCount() const
+{
+    return malformedCount;
+}
+
+// Description: Number of well-formed lines of the existing roster.
+unsigned long long RosterMerge::getExistingCount() const
+{
+    return existingCount;
+}
+
+// Description: Number of existing lines whose phone number appears earlier in the existing roster (ignored).
+unsigned long long RosterMerge::getExistingRepeatCount() const
+{
+    return existingRepeats;
+}
+
+// Description: Returns the line starting at "line" (without its end of line).
+string RosterMerge::lineAt(const char *line)
+{
+    return string(line, endOfLine(line));
+}
+
+// Description: Writes the given lines, one per line, through a local buffer.
+void RosterMerge::writeLines(ostream &os, const vector<const char *> &lines)
+{
+    const unsigned int BUFFER_SIZE = 1 << 16;
+    string buffer;
+    buffer.reserve(BUFFER_SIZE + 256);
+
+    for (unsigned long long i = 0; i < lines.size(); i++)
+    {
+        buffer.append(lines[i], endOfLine(lines[i]));
+        buffer += '\n';
+        if (buffer.size() >= BUFFER_SIZE)
+        {
+            os.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    os.write(buffer.data(), buffer.size());
+}
+
+// Description: Writes each conflict as its incoming line followed by the line it conflicts with.
+void RosterMerge::writeConflicts(ostream &os, const vector<Conflict> &conflicts)
+{
+    const unsigned int BUFFER_SIZE = 1 << 16;
+    string buffer;
+    buffer.reserve(BUFFER_SIZE + 512);
+
+    for (unsigned long long i = 0; i < conflicts.size(); i++)
+    {
+        buffer.append(conflicts[i].incoming, endOfLine(conflicts[i].incoming));
+        buffer += "\n    conflicts with: ";
+        buffer.append(conflicts[i].existing, endOfLine(conflicts[i].existing));
+        buffer += '\n';
+        if (buffer.size() >= BUFFER_SIZE)
+        {
+            os.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+    os.write(buffer.data(), buffer.size());
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Parses the lines of roster[first, last) into records, skipping (and counting)
+//              malformed lines. A line is well-formed if it has 4 ", " separated fields and
+//              its phone number has 10 digits.
+void RosterMerge::parse(const char *first, const char *last, vector<Record> &records, unsigned long long &malformed)
+{
+    records.reserve((last - first) / 64);
+    const char *line = first;
+    while (line < last)
+    {
+        const char *newLine = (const char *)memchr(line, '\n', last - line);
+        if (newLine == nullptr)
+        {
+            newLine = last;
+        }
+        const char *end = newLine;
+        if (end > line && end[-1] == '\r')
+        {
+            end--;
+        }
+
+        if (end > line)
+        {
+            const char *nameEnd = findSeparator(line, end);
+            const char *phoneEnd = nameEnd == nullptr ? nullptr : findSeparator(nameEnd + 2, end);
+            const char *emailEnd = phoneEnd == nullptr ? nullptr : findSeparator(phoneEnd + 2, end);
+            if (emailEnd == nullptr || countDigits(nameEnd + 2, phoneEnd) != 10)
+            {
+                malformed++;
+            }
+            else
+            {
+                Record record;
+                record.key = packPhone(nameEnd + 2, phoneEnd);
+                record.details = hashBytes(phoneEnd + 2, end);
+                record.line = line;
+                records.push_back(record);
+            }
+        }
+        line = newLine + 1;
+    }
+}
+
+// Description: Parses a roster with threadCount threads: chunks[t] receives the records
+//              of the t-th slice of the roster. Slices end at a line boundary.
+void RosterMerge::parseChunks(const string &roster, vector<vector<Record>> &chunks, unsigned long long &malformed) const
+{
+    const char *first = roster.data();
+    const char *last = first + roster.size();
+    vector<const char *> bounds(threadCount + 1);
+    bounds[0] = first;
+    bounds[threadCount] = last;
+    for (unsigned int t = 1; t < threadCount; t++)
+    {
+        const char *bound = max(bounds[t - 1], first + roster.size() / threadCount * t);
+        const char *newLine = (const char *)memchr(bound, '\n', last - bound);
+        bounds[t] = newLine == nullptr ? last : newLine + 1;
+    }
+
+    vector<unsigned long long> malformedCounts(threadCount, 0);
+    runThreads(threadCount, [&](unsigned int t)
+               { parse(bounds[t], bounds[t + 1], chunks[t], malformedCounts[t]); });
+    for (unsigned int t = 0; t < threadCount; t++)
+    {
+        malformed += malformedCounts[t];
+    }
+}
+
+// Description: Radix partitions the parsed chunks on the top "bits" bits of the hash of their phone number.
+//              Each thread counts the records of its chunk per partition; the prefix sums of the counts
+//              (partition major, chunk minor) give each thread its own output range in every partition,
+//              so that the threads scatter without synchronization and the roster order is kept.
+void RosterMerge::scatter(vector<vector<Record>> &chunks, unsigned int bits, Partitions &result) const
+{
+    unsigned int partitionCount = 1u << bits;
+    vector<vector<unsigned long long>> cursors(threadCount, vector<unsigned long long>(partitionCount, 0));
+    runThreads(threadCount, [&](unsigned int t)
+               {
+                   for (unsigned long long i = 0; i < chunks[t].size(); i++)
+                   {
+                       cursors[t][partitionOf(chunks[t][i].key, bits)]++;
+                   } });
+
+    result.offsets.assign(partitionCount + 1, 0);
+    unsigned long long offset = 0;
+    for (unsigned int p = 0; p < partitionCount; p++)
+    {
+        result.offsets[p] = offset;
+        for (unsigned int t = 0; t < threadCount; t++)
+        {
+            unsigned long long count = cursors[t][p];
+            cursors[t][p] = offset;
+            offset += count;
+        }
+    }
+    result.offsets[partitionCount] = offset;
+
+    result.records.resize(offset);
+    runThreads(threadCount, [&](unsigned int t)
+               {
+                   Record *records = result.records.data();
+                   for (unsigned long long i = 0; i < chunks[t].size(); i++)
+                   {
+                       const Record &record = chunks[t][i];
+                       records[cursors[t][partitionOf(record.key, bits)]++] = record;
+                   }
+                   vector<Record>().swap(chunks[t]); });
+}
+
+// Description: Joins partitions, taken one at a time from the shared counter nextPartition, into result.
+//              The join table of a partition holds, for each phone number, 1 + the index of its first
+//              record: existing records first (0 .. e - 1), then incoming ones (e ..). It is
+//              open addressing with linear probing, sized to a power of 2 at least twice the
+//              number of records of the partition.
+void RosterMerge::join(const Partitions &existing, const Partitions &incoming, unsigned int partitionCount,
+                       atomic<unsigned int> &nextPartition, JoinResult &result)
+{
+    vector<unsigned int> table;
+    for (unsigned int p = nextPartition++; p < partitionCount; p = nextPartition++)
+    {
+        const Record *existingRecords = existing.records.data() + existing.offsets[p];
+        unsigned int existingCount = (unsigned int)(existing.offsets[p + 1] - existing.offsets[p]);
+        const Record *incomingRecords = incoming.records.data() + incoming.offsets[p];
+        unsigned int incomingCount = (unsigned int)(incoming.offsets[p + 1] - incoming.offsets[p]);
+
+        unsigned int size = 16;
+        while (size < 2 * (existingCount + incomingCount))
+        {
+            size *= 2;
+        }
+        unsigned int mask = size - 1;
+        table.assign(size, 0);
+
+        auto recordAt = [&](unsigned int index) -> const Record &
+        {
+            return index < existingCount ? existingRecords[index] : incomingRecords[index - existingCount];
+        };
+        auto cellOf = [&](unsigned long long key)
+        {
+            unsigned int cell = (unsigned int)mixKey(key) & mask;
+            while (table[cell] != 0 && recordAt(table[cell] - 1).key != key)
+            {
+                cell = (cell + 1) & mask;
+            }
+            return cell;
+        };
+
+        for (unsigned int i = 0; i < existingCount; i++)
+        {
+            unsigned int cell = cellOf(existingRecords[i].key);
+            if (table[cell] == 0)
+            {
+                table[cell] = i + 1;
+            }
+            else
+            {
+                result.existingRepeats++;
+            }
+        }
+
+        for (unsigned int i = 0; i < incomingCount; i++)
+        {
+            const Record &record = incomingRecords[i];
+            unsigned int cell = cellOf(record.key);
+            if (table[cell] == 0)
+            {
+                table[cell] = existingCount + i + 1;
+                result.newRecords.push_back(record.line);
+                continue;
+            }
+            const Record &seen = recordAt(table[cell] - 1);
+            if (seen.details == record.details && sameDetails(seen.line, record.line))
+            {
+                result.duplicates.push_back(record.line);
+            }
+            else
+            {
+                Conflict conflict;
+                conflict.incoming = record.line;
+                conflict.existing = seen.line;
+                result.conflicts.push_back(conflict);
+            }
+        }
+    }
+}
+
+// Description: Returns true if the email and credit card of both (well-formed) lines are identical.
+bool RosterMerge::sameDetails(const char *line, const char *otherLine)
+{
+    const char *end = endOfLine(line);
+    const char *otherEnd = endOfLine(otherLine);
+    const char *details = detailsOf(line, end);
+    const char *otherDetails = detailsOf(otherLine, otherEnd);
+    return end - details == otherEnd - otherDetails && memcmp(details, otherDetails, end - details) == 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * RosterMerge.h
+ *
+ * Class Description: Merges an incoming member roster into an existing one (hash join on the
+ *                    phone number) and classifies every incoming record as:
+ *                    - new: its phone number is in neither roster so far,
+ *                    - duplicate: same phone number, email and credit card as a record seen before,
+ *                    - conflict: same phone number as a record seen before, but a different
+ *                      email or credit card.
+ *                    A roster is text, one member per line, in the format of
+ *                    operator<<(ostream &, const Member &) and List::exportTo( ):
+ *                        Louis Pace, 604-853-1423, louis@nowhere.com, 1234 5678 9098 7654
+ *                    Records are radix partitioned on the hash of their phone number so that each
+ *                    partition (its records and its join table) fits in cache, then the partitions
+ *                    are joined independently by a pool of threads.
+ *                    Within the incoming roster, the first record of a phone number wins: later
+ *                    ones are reported against it, as duplicates or conflicts.
+ * Class Invariant: - After run( ), every well-formed incoming line is in exactly one of
+ *                    getNew( ), getDuplicates( ) and getConflicts( ), in the order of the
+ *                    incoming roster.
+ *                  - The reported lines point into the rosters held by this object.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef ROSTER_MERGE_H
+#define ROSTER_MERGE_H
+
+#include <atomic>
+#include <string>
+#include <vector>
+#include <ostream>
+
+using std::atomic;
+using std::ostream;
+using std::string;
+using std::vector;
+
+class RosterMerge
+{
+
+public:
+  // An incoming record with the same phone number as an earlier record.
+  struct Conflict
+  {
+    const char *incoming; // Start of the incoming line.
+    const char *existing; // Start of the line it conflicts with (existing roster, or earlier incoming line).
+  };
+
+private:
+  // One roster line, as joined (24 bytes).
+  struct Record
+  {
+    unsigned long long key;     // Packed phone number (see PhoneKey.h).
+    unsigned long long details; // Hash of the email and credit card.
+    const char *line;           // Start of the line in its roster.
+  };
+
+  // A roster split into partitions: partition p is records[offsets[p] .. offsets[p + 1]).
+  struct Partitions
+  {
+    vector<Record> records;
+    vector<unsigned long long> offsets;
+  };
+
+  // Results of the partitions joined by one thread.
+  struct JoinResult
+  {
+    vector<const char *> newRecords;
+    vector<const char *> duplicates;
+    vector<Conflict> conflicts;
+    unsigned long long existingRepeats = 0;
+  };
+
+  const static unsigned int PARTITION_SIZE = 4096; // Target number of records (both rosters) per partition.
+  const static unsigned int MAX_PARTITION_BITS = 16;
+
+  string existingRoster;
+  string incomingRoster;
+  unsigned int threadCount;
+
+  vector<const char *> newRecords;
+  vector<const char *> duplicates;
+  vector<Conflict> conflicts;
+  unsigned long long malformedCount = 0;
+  unsigned long long existingCount = 0;
+  unsigned long long existingRepeats = 0;
+
+  // Description: Parses the lines of roster[first, last) into records, skipping (and counting)
+  //              malformed lines. first and last are at the start of a line.
+  static void parse(const char *first, const char *last, vector<Record> &records, unsigned long long &malformed);
+
+  // Description: Parses a roster with threadCount threads: chunks[t] receives the records
+  //              of the t-th slice of the roster, malformed the number of malformed lines.
+  void parseChunks(const string &roster, vector<vector<Record>> &chunks, unsigned long long &malformed) const;
+
+  // Description: Radix partitions the parsed chunks, with threadCount threads, on the top "bits"
+  //              bits of the hash of their phone number, and releases the chunks. The order of the
+  //              records within a partition is the order of the roster.
+  void scatter(vector<vector<Record>> &chunks, unsigned int bits, Partitions &result) const;
+
+  // Description: Joins partitions, taken one at a time from the shared counter nextPartition, into result.
+  static void join(const Partitions &existing, const Partitions &incoming, unsigned int partitionCount,
+                   atomic<unsigned int> &nextPartition, JoinResult &result);
+
+  // Description: Returns true if the email and credit card of both lines are identical.
+  static bool sameDetails(const char *line, const char *otherLine);
+
+public:
+  // Constructor
+  // Description: Takes the text of both rosters. threadCount 0 means one thread per CPU.
+  RosterMerge(string anExistingRoster, string anIncomingRoster, unsigned int aThreadCount = 0);
+
+  // Description: Reads a whole roster file.
+  // Exception: Throws UnableToOpenFileException if the file cannot be read.
+  static string readFile(const string &fileName);
+
+  // Description: Joins the incoming roster with the existing one and classifies the incoming records.
+  // Postcondition: getNew( ), getDuplicates( ), getConflicts( ) and the counts are set.
+  // Time Efficiency: O(n) expected, n = number of lines of both rosters
+  // Space Efficiency: O(n)
+  void run();
+
+  // Description: Incoming lines whose phone number was not seen before (in file order).
+  const vector<const char *> &getNew() const;
+
+  // Description: Incoming lines identical (phone, email, credit card) to a record seen before.
+  const vector<const char *> &getDuplicates() const;
+
+  // Description: Incoming lines whose phone number was seen before with a different email or credit card.
+  const vector<Conflict> &getConflicts() const;
+
+  // Description: Number of lines of either roster that could not be parsed (not 4 fields, or
+  //              not a 10-digit phone number). Empty lines are ignored.
+  unsigned long long getMalformedCount() const;
+
+  // Description: Number of well-formed lines of the existing roster.
+  unsigned long long getExistingCount() const;
+
+  // Description: Number of existing lines whose phone number appears earlier in the existing roster (ignored).
+  unsigned long long getExistingRepeatCount() const;
+
+  // Description: Returns the line starting at "line" (without its end of line).
+  static string lineAt(const char *line);
+
+  // Description: Writes the given lines, one per line, in large blocks.
+  static void writeLines(ostream &os, const vector<const char *> &lines);
+
+  // Description: Writes each conflict as its incoming line followed by the line it conflicts with.
+  static void writeConflicts(ostream &os, const vector<Conflict> &conflicts);
+};
+
+#endif
@@ -0,0 +1,91 @@
+/*
+ * RosterMergeDriver.cpp
+ *
+ * Description: Merges an incoming member roster into an existing one and reports the
+ *              new, duplicate and conflicting incoming records.
+ *              Usage: rmd existingRoster incomingRoster [output prefix] [threads]
+ *              Rosters have one member per line, in the format written by List::exportTo( ):
+ *                  Louis Pace, 604-853-1423, louis@nowhere.com, 1234 5678 9098 7654
+ *              Writes <prefix>New.txt, <prefix>Duplicates.txt and <prefix>Conflicts.txt
+ *              (default prefix: "merge") and prints the counts and timings on cout.
+ *
+ * Author: Elaine Luu
+ * Created on: Oct. 2026
+ *
+ */
+
+#include "RosterMerge.h"
+#include "UnableToOpenFileException.h"
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <string>
+
+using namespace std;
+using Clock = chrono::steady_clock;
+
+// Description: Returns the milliseconds elapsed since start.
+double millisecondsSince(Clock::time_point start)
+{
+    return chrono::duration<double, milli>(Clock::now() - start).count();
+}
+
+// Description: Reads a roster file, naming the file if it cannot be read.
+// Exception: Throws UnableToOpenFileException if the file cannot be read.
+string readRoster(const char *fileName)
+{
+    try
+    {
+        return RosterMerge::readFile(fileName);
+    }
+    catch (UnableToOpenFileException &)
+    {
+        cout << "Roster " << fileName << ":" << endl;
+        throw;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 3)
+    {
+        cout << "Usage: " << argv[0] << " existingRoster incomingRoster [output prefix] [threads]" << endl;
+        return 1;
+    }
+    string prefix = (argc > 3) ? argv[3] : "merge";
+    unsigned int threads = (argc > 4) ? stoul(argv[4]) : 0;
+
+    try
+    {
+        Clock::time_point start = Clock::now();
+        RosterMerge merge(readRoster(argv[1]), readRoster(argv[2]), threads);
+        cout << "Read both rosters in " << millisecondsSince(start) << " ms" << endl;
+
+        start = Clock::now();
+        merge.run();
+        cout << "Merged in " << millisecondsSince(start) << " ms" << endl;
+
+        cout << "Existing records:   " << merge.getExistingCount() << " (" << merge.getExistingRepeatCount()
+             << " repeated phone numbers ignored)" << endl;
+        cout << "New records:        " << merge.getNew().size() << endl;
+        cout << "Duplicate records:  " << merge.getDuplicates().size() << endl;
+        cout << "Conflicting records: " << merge.getConflicts().size() << endl;
+        cout << "Malformed lines:    " << merge.getMalformedCount() << endl;
+
+        start = Clock::now();
+        ofstream newFile(prefix + "New.txt", ios::trunc);
+        RosterMerge::writeLines(newFile, merge.getNew());
+        ofstream duplicatesFile(prefix + "Duplicates.txt", ios::trunc);
+        RosterMerge::writeLines(duplicatesFile, merge.getDuplicates());
+        ofstream conflictsFile(prefix + "Conflicts.txt", ios::trunc);
+        RosterMerge::writeConflicts(conflictsFile, merge.getConflicts());
+        cout << "Wrote " << prefix << "New.txt, " << prefix << "Duplicates.txt and " << prefix
+             << "Conflicts.txt in " << millisecondsSince(start) << " ms" << endl;
+    }
+    catch (exception &e)
+    {
+        cout << "Exception: " << e.what() << endl;
+        return 1;
+    }
+    return 0;
+}
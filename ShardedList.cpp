@@ -0,0 +1,368 @@
+/*
+ * ShardedList.cpp
+ *
+ * Class Description: Sharded front-end over several independent Lists, for multi-socket servers.
+ *                    The key space is split on the high bits of the phone hash; each shard is owned
+ *                    by a worker thread pinned to the CPUs of one NUMA node, which allocates (first
+ *                    touch) and serves its List. Requests reach the workers in batches, through
+ *                    per-shard queues.
+ * Class Invariant: - An element is stored in the shard of its phone, and only there.
+ *                  - Only the worker of a shard accesses its List.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include <fstream>
+#include <sstream>
+#include <pthread.h>
+#include <sched.h>
+
+#include "ShardedList.h"
+#include "PhoneKey.h"
+
+using namespace std;
+
+// Description: Returns the packed key of a phone number in any format normalizePhone( ) accepts,
+//              INVALID_PHONE_KEY if it is not a valid one (its shard then reports it missing).
+static unsigned long long phoneKeyOf(const string &phone)
+{
+    unsigned long long key = INVALID_PHONE_KEY;
+    normalizePhone(phone, key);
+    return key;
+}
+
+// Description: Parses a sysfs CPU list such as "0-3,8-11" into CPU numbers.
+static vector<int> parseCpuList(const string &cpuList)
+{
+    vector<int> cpus;
+    stringstream ss(cpuList);
+    string range;
+    while (getline(ss, range, ','))
+    {
+        if (range.empty() || range[0] < '0' || range[0] > '9')
+        {
+            continue;
+        }
+        size_t dash = range.find('-');
+        int first = stoi(range.substr(0, dash));
+        int last = (dash == string::npos) ? first : stoi(range.substr(dash + 1));
+        for (int cpu = first; cpu <= last; cpu++)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+// Description: Returns the CPUs of each NUMA node (from /sys/devices/system/node);
+//              a single node with every CPU if the system does not describe its nodes.
+vector<vector<int>> ShardedList::detectNodes()
+{
+    vector<vector<int>> nodes;
+    for (unsigned int node = 0;; node++)
+    {
+        ifstream cpuListFile("/sys/devices/system/node/node" + to_string(node) + "/cpulist");
+        if (!cpuListFile)
+        {
+            break;
+        }
+        string cpuList;
+        getline(cpuListFile, cpuList);
+        vector<int> cpus = parseCpuList(cpuList);
+        if (!cpus.empty()) // memory-only nodes have no CPU to serve a shard
+        {
+            nodes.push_back(cpus);
+        }
+    }
+
+    if (nodes.empty())
+    {
+        vector<int> cpus;
+        for (unsigned int cpu = 0; cpu < max(1u, thread::hardware_concurrency()); cpu++)
+        {
+            cpus.push_back((int)cpu);
+        }
+        nodes.push_back(cpus);
+    }
+    return nodes;
+}
+
+// Constructor
+ShardedList::ShardedList(unsigned int aCapacity, unsigned int aShardCount)
+{
+    vector<vector<int>> nodes = detectNodes();
+    shardCount = (aShardCount == 0) ? (unsigned int)nodes.size() : aShardCount;
+    unsigned int shardCapacity = aCapacity / shardCount + aCapacity / shardCount / 16 + 64;
+
+    shards = new Shard[shardCount];
+    Request created;
+    created.pending = shardCount;
+    for (unsigned int s = 0; s < shardCount; s++)
+    {
+        shards[s].node = s % nodes.size();
+        shards[s].worker = thread(&ShardedList::work, this, s, nodes[shards[s].node], shardCapacity, ref(created));
+    }
+
+    unique_lock<mutex> guard(created.lock);
+    created.done.wait(guard, [&]()
+                      { return created.pending == 0; });
+}
+
+// Destructor
+// Description: Stops the workers, which delete their List (and its elements).
+ShardedList::~ShardedList()
+{
+    for (unsigned int s = 0; s < shardCount; s++)
+    {
+        lock_guard<mutex> guard(shards[s].lock);
+        shards[s].stopping = true;
+        shards[s].ready.notify_one();
+    }
+    for (unsigned int s = 0; s < shardCount; s++)
+    {
+        shards[s].worker.join();
+    }
+    delete[] shards;
+    shards = nullptr;
+}
+
+// Description: Returns the number of shards.
+unsigned int ShardedList::getShardCount() const
+{
+    return shardCount;
+}
+
+// Description: Returns the NUMA node serving a shard.
+unsigned int ShardedList::getNodeOf(unsigned int shard) const
+{
+    return shards[shard].node;
+}
+
+// Description: Returns the shard of a phone number: the high bits of its hash, scaled to the shard count.
+unsigned int ShardedList::shardOf(const string &phone) const
+{
+    return shardOf(phoneKeyOf(phone));
+}
+
+// Description: Returns the shard of a packed phone number.
+unsigned int ShardedList::shardOf(unsigned long long phoneKey) const
+{
+    return (unsigned int)(((unsigned long long)hashPhoneKey(phoneKey) * shardCount) >> 32);
+}
+
+// Description: Returns the total element count.
+unsigned int ShardedList::getElementCount() const
+{
+    unsigned int count = 0;
+    for (unsigned int s = 0; s < shardCount; s++)
+    {
+        count += shards[s].elementCount;
+    }
+    return count;
+}
+
+// Description: Inserts elements[0 .. count - 1]; codes[i] is the outcome of List::tryInsert( ) for elements[i].
+void ShardedList::insertMany(Member *const *elements, ErrorCode *codes, unsigned int count)
+{
+    Task pattern;
+    pattern.operation = Task::INSERT;
+    pattern.elements = elements;
+    pattern.codes = codes;
+    dispatch(pattern, count, [&](unsigned int i)
+             { return elements[i]->getPhoneKey(); });
+}
+
+// Description: Looks up a batch of phone numbers.
+void ShardedList::searchMany(const string *phones, Member **results, unsigned int count) const
+{
+    Task pattern;
+    pattern.operation = Task::SEARCH;
+    pattern.phones = phones;
+    pattern.results = results;
+    dispatch(pattern, count, [&](unsigned int i)
+             { return phoneKeyOf(phones[i]); });
+}
+
+// Description: Removes (and deletes) the elements whose phones are phones[0 .. count - 1].
+void ShardedList::removeMany(const string *phones, ErrorCode *codes, unsigned int count)
+{
+    Task pattern;
+    pattern.operation = Task::REMOVE;
+    pattern.phones = phones;
+    pattern.codes = codes;
+    dispatch(pattern, count, [&](unsigned int i)
+             { return phoneKeyOf(phones[i]); });
+}
+
+// Description: Insert an element.
+// Exception: Throws the exceptions of List::insert( ).
+void ShardedList::insert(Member &newElement)
+{
+    Member *element = &newElement;
+    ErrorCode code = ErrorCode::OK;
+    insertMany(&element, &code, 1);
+    if (code != ErrorCode::OK)
+    {
+        throwException(code);
+    }
+}
+
+// Description: Returns a pointer to the element with the same phone as target.
+// Exception: Throws ElementDoesNotExistException if there is none.
+Member *ShardedList::search(const Member &target) const
+{
+    string phone = target.getPhone();
+    Member *found = nullptr;
+    searchMany(&phone, &found, 1);
+    if (found == nullptr)
+    {
+        throwException(ErrorCode::ELEMENT_DOES_NOT_EXIST);
+    }
+    return found;
+}
+
+// Description: Removes (and deletes) the element with the same phone as target.
+// Exception: Throws the exceptions of List::remove( ).
+void ShardedList::remove(const Member &target)
+{
+    string phone = target.getPhone();
+    ErrorCode code = ErrorCode::OK;
+    removeMany(&phone, &code, 1);
+    if (code != ErrorCode::OK)
+    {
+        throwException(code);
+    }
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Splits the elements [0, count) of a call per shard, enqueues one task per shard
+//              involved and waits until each of them has been processed.
+template <class KeyOf>
+void ShardedList::dispatch(Task &pattern, unsigned int count, KeyOf keyOf) const
+{
+    vector<vector<unsigned int>> positions(shardCount);
+    for (unsigned int i = 0; i < count; i++)
+    {
+        positions[shardOf(keyOf(i))].push_back(i);
+    }
+
+    Request request;
+    pattern.request = &request;
+    unsigned int involved = 0;
+    for (unsigned int s = 0; s < shardCount; s++)
+    {
+        involved += !positions[s].empty();
+    }
+    request.pending = involved;
+
+    for (unsigned int s = 0; s < shardCount; s++)
+    {
+        if (positions[s].empty())
+        {
+            continue;
+        }
+        Task task = pattern;
+        task.positions = move(positions[s]);
+        lock_guard<mutex> guard(shards[s].lock);
+        shards[s].queue.push_back(move(task));
+        shards[s].ready.notify_one();
+    }
+
+    unique_lock<mutex> guard(request.lock);
+    request.done.wait(guard, [&]()
+                      { return request.pending == 0; });
+}
+
+// Description: Body of the worker thread of a shard: pins itself to the CPUs of the shard's node,
+//              creates the shard's List (first touch on that node), then processes the shard's queue,
+//              a whole batch of tasks at a time, until stopping.
+void ShardedList::work(unsigned int shard, const vector<int> &cpus, unsigned int aCapacity, Request &created)
+{
+    Shard &self = shards[shard];
+
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    for (unsigned int i = 0; i < cpus.size(); i++)
+    {
+        CPU_SET(cpus[i], &cpuSet);
+    }
+    pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet); // best effort: may be restricted
+
+    self.list = new List(hashPhone, aCapacity);
+    finish(created);
+
+    deque<Task> batch;
+    while (true)
+    {
+        {
+            unique_lock<mutex> guard(self.lock);
+            self.ready.wait(guard, [&]()
+                            { return self.stopping || !self.queue.empty(); });
+            if (self.queue.empty())
+            {
+                break; // stopping, and nothing left to do
+            }
+            batch.swap(self.queue);
+        }
+
+        for (unsigned int t = 0; t < batch.size(); t++)
+        {
+            process(self, batch[t]);
+            finish(*batch[t].request);
+        }
+        batch.clear();
+    }
+
+    delete self.list;
+    self.list = nullptr;
+}
+
+// Description: Records that one more shard is done with a request and wakes its caller if it was the last.
+//              The count is decremented under the request's lock: the caller (which owns the request)
+//              cannot see it reach 0 and return before this thread is done with the request.
+void ShardedList::finish(Request &request)
+{
+    lock_guard<mutex> guard(request.lock);
+    if (--request.pending == 0)
+    {
+        request.done.notify_one();
+    }
+}
+
+// Description: Processes one task on the List of a shard.
+void ShardedList::process(Shard &shard, Task &task)
+{
+    const vector<unsigned int> &positions = task.positions;
+    if (task.operation == Task::SEARCH)
+    {
+        // Gathered into contiguous arrays for the List's batched (prefetching) lookup.
+        vector<string> phones(positions.size());
+        vector<Member *> results(positions.size());
+        for (unsigned int i = 0; i < positions.size(); i++)
+        {
+            phones[i] = task.phones[positions[i]];
+        }
+        shard.list->searchMany(phones.data(), results.data(), positions.size());
+        for (unsigned int i = 0; i < positions.size(); i++)
+        {
+            task.results[positions[i]] = results[i];
+        }
+    }
+    else if (task.operation == Task::INSERT)
+    {
+        for (unsigned int i = 0; i < positions.size(); i++)
+        {
+            task.codes[positions[i]] = shard.list->tryInsert(*task.elements[positions[i]]);
+        }
+    }
+    else
+    {
+        for (unsigned int i = 0; i < positions.size(); i++)
+        {
+            task.codes[positions[i]] = shard.list->tryRemove(Member(task.phones[positions[i]]));
+        }
+    }
+    shard.elementCount = shard.list->getElementCount();
+}
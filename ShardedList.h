@@ -0,0 +1,163 @@
+/*
+ * ShardedList.h
+ *
+ * Class Description: Sharded front-end over several independent Lists, for multi-socket servers.
+ *                    The key space is split on the high bits of the phone hash: each phone belongs
+ *                    to exactly one shard. Each shard is owned by a worker thread pinned to the CPUs
+ *                    of one NUMA node (shards are spread round-robin over the nodes found in
+ *                    /sys/devices/system/node); the worker allocates its List itself, so that its
+ *                    hashTable is first touched, hence placed, on that node, and it is the only
+ *                    thread that ever reads or writes its List.
+ *                    Requests are split per shard and handed over in batches through per-shard
+ *                    queues: a call of insertMany( ), searchMany( ) or removeMany( ) enqueues at
+ *                    most one task per shard and returns once every shard has processed its part.
+ *                    The single element calls are batches of one; prefer the batched calls.
+ *                    Like List, a ShardedList owns the elements inserted in it.
+ * Class Invariant: - An element is stored in the shard of its phone, and only there.
+ *                  - Only the worker of a shard accesses its List.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef SHARDED_LIST_H
+#define SHARDED_LIST_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "List.h"
+#include "ErrorCode.h"
+
+using std::atomic;
+using std::condition_variable;
+using std::deque;
+using std::mutex;
+using std::string;
+using std::thread;
+using std::vector;
+
+class ShardedList
+{
+
+private:
+  // Completion of one call: the number of shards that have not processed their task yet.
+  struct Request
+  {
+    atomic<unsigned int> pending{0};
+    mutex lock;
+    condition_variable done;
+  };
+
+  // The part of one call handled by one shard: positions (in the caller's arrays) of its elements.
+  struct Task
+  {
+    enum Operation
+    {
+      INSERT,
+      SEARCH,
+      REMOVE
+    };
+    Operation operation;
+    vector<unsigned int> positions;
+    Member *const *elements = nullptr; // INSERT
+    const string *phones = nullptr;    // SEARCH, REMOVE
+    Member **results = nullptr;        // SEARCH
+    ErrorCode *codes = nullptr;        // INSERT, REMOVE
+    Request *request = nullptr;
+  };
+
+  struct Shard
+  {
+    List *list = nullptr;                // Created, used and deleted by the worker only.
+    atomic<unsigned int> elementCount{0}; // Updated by the worker, read by anyone.
+    unsigned int node = 0;               // NUMA node of the worker.
+    thread worker;
+    mutex lock;                          // Protects queue and stopping.
+    condition_variable ready;
+    deque<Task> queue;
+    bool stopping = false;
+  };
+
+  Shard *shards = nullptr;
+  unsigned int shardCount = 0;
+
+  // Description: Body of the worker thread of a shard: pins itself to the CPUs of the shard's node,
+  //              creates the shard's List of aCapacity cells, then processes the shard's queue,
+  //              a whole batch of tasks at a time, until stopping.
+  void work(unsigned int shard, const vector<int> &cpus, unsigned int aCapacity, Request &created);
+
+  // Description: Processes one task on the List of a shard.
+  static void process(Shard &shard, Task &task);
+
+  // Description: Records that one more shard is done with a request and wakes its caller if it was the last.
+  static void finish(Request &request);
+
+  // Description: Splits the elements [0, count) of a call per shard (keyOf(i) gives the packed phone of element i),
+  //              enqueues the tasks and waits until every shard has processed its task.
+  template <class KeyOf>
+  void dispatch(Task &pattern, unsigned int count, KeyOf keyOf) const;
+
+public:
+  // Description: Returns the CPUs of each NUMA node (from /sys/devices/system/node);
+  //              a single node with every CPU if the system does not describe its nodes.
+  static vector<vector<int>> detectNodes();
+
+  // Constructor
+  // Description: Creates aShardCount shards (0: one per NUMA node) of List, holding aCapacity
+  //              elements in total. Each shard has aCapacity / shardCount cells, plus a margin
+  //              for the uneven spread of the phones over the shards.
+  ShardedList(unsigned int aCapacity, unsigned int aShardCount = 0);
+
+  // Destructor
+  // Description: Stops the workers, which delete their List (and its elements).
+  ~ShardedList();
+
+  ShardedList(const ShardedList &) = delete;
+  ShardedList &operator=(const ShardedList &) = delete;
+
+  // Description: Returns the number of shards.
+  unsigned int getShardCount() const;
+
+  // Description: Returns the NUMA node serving a shard.
+  unsigned int getNodeOf(unsigned int shard) const;
+
+  // Description: Returns the shard of a phone number.
+  unsigned int shardOf(const string &phone) const;
+
+  // Description: Returns the shard of a packed phone number (see PhoneKey.h).
+  unsigned int shardOf(unsigned long long phoneKey) const;
+
+  // Description: Returns the total element count (the sum of the shards' counts, read without stopping them).
+  unsigned int getElementCount() const;
+
+  // Description: Inserts elements[0 .. count - 1]; codes[i] is the outcome of List::tryInsert( ) for elements[i].
+  //              The ShardedList owns the elements inserted (codes[i] == ErrorCode::OK).
+  void insertMany(Member *const *elements, ErrorCode *codes, unsigned int count);
+
+  // Description: Looks up a batch of phone numbers: results[i] is set to the element whose
+  //              phone is phones[i], or nullptr if there is none.
+  void searchMany(const string *phones, Member **results, unsigned int count) const;
+
+  // Description: Removes (and deletes) the elements whose phones are phones[0 .. count - 1];
+  //              codes[i] is the outcome of List::tryRemove( ) for phones[i].
+  void removeMany(const string *phones, ErrorCode *codes, unsigned int count);
+
+  // Description: Insert an element.
+  // Exception: Throws the exceptions of List::insert( ).
+  void insert(Member &newElement);
+
+  // Description: Returns a pointer to the element with the same phone as target.
+  // Exception: Throws ElementDoesNotExistException if there is none.
+  Member *search(const Member &target) const;
+
+  // Description: Removes (and deletes) the element with the same phone as target.
+  // Exception: Throws the exceptions of List::remove( ).
+  void remove(const Member &target);
+};
+
+#endif
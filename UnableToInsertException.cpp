@@ -12,4 +12,7 @@
 #include "UnableToInsertException.h"
 
 // Constructor
-UnableToInsertException::UnableToInsertException(const string &message) : logic_error("UnableToInsertException") {}
+UnableToInsertException::UnableToInsertException(const char *message) : DataCollectionException(ErrorCode::UNABLE_TO_INSERT, message) {}
+
+// Constructor
+UnableToInsertException::UnableToInsertException(ErrorCode code) : DataCollectionException(code, errorMessage(code)) {}
@@ -12,16 +12,20 @@
 #ifndef UNABLE_TO_INSERT_EXCEPTION_H
 #define UNABLE_TO_INSERT_EXCEPTION_H
 
-#include <stdexcept>
+#include "DataCollectionException.h"
 
-using std::logic_error;
-using std::string;
-
-class UnableToInsertException : public logic_error
+class UnableToInsertException : public DataCollectionException
 {
 
 public:
    // Constructor
-   UnableToInsertException(const string &);
+   // Description: The message defaults to errorMessage(ErrorCode::UNABLE_TO_INSERT).
+   // Precondition: message has static storage duration (e.g. a string literal).
+   explicit UnableToInsertException(const char *message = errorMessage(ErrorCode::UNABLE_TO_INSERT));
+
+   // Constructor
+   // Description: An exception of category code (ErrorCode::UNABLE_TO_INSERT or ErrorCode::INVALID_KEY),
+   //              with the message errorMessage(code).
+   explicit UnableToInsertException(ErrorCode code);
 };
 #endif
@@ -0,0 +1,14 @@
+/*
+ * UnableToOpenFileException.cpp
+ *
+ * Class Description: Defines the exception that is thrown when
+ *                    a file cannot be opened for reading or writing.
+ *
+ * Author: Inspired from our textbook's authors Frank M. Carrano and Tim Henry.
+ *         Copyright (c) 2013 __Pearson Education__. All rights reserved.
+ */
+
+#include "UnableToOpenFileException.h"
+
+// Constructor
+UnableToOpenFileException::UnableToOpenFileException(const char *message) : DataCollectionException(ErrorCode::UNABLE_TO_OPEN_FILE, message) {}
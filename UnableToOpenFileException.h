@@ -0,0 +1,25 @@
+/*
+ * UnableToOpenFileException.h
+ *
+ * Class Description: Defines the exception that is thrown when
+ *                    a file cannot be opened for reading or writing.
+ *
+ * Author: Inspired from our textbook's authors Frank M. Carrano and Tim Henry.
+ *         Copyright (c) 2013 __Pearson Education__. All rights reserved.
+ */
+
+#ifndef UNABLE_TO_OPEN_FILE_EXCEPTION_H
+#define UNABLE_TO_OPEN_FILE_EXCEPTION_H
+
+#include "DataCollectionException.h"
+
+class UnableToOpenFileException : public DataCollectionException
+{
+
+public:
+   // Constructor
+   // Description: The message defaults to errorMessage(ErrorCode::UNABLE_TO_OPEN_FILE).
+   // Precondition: message has static storage duration (e.g. a string literal).
+   explicit UnableToOpenFileException(const char *message = errorMessage(ErrorCode::UNABLE_TO_OPEN_FILE));
+};
+#endif
@@ -0,0 +1,228 @@
+/*
+ * VersionedList.cpp
+ *
+ * Class Description: Multi-version front-end over List: generations are built aside and published
+ *                    with an atomic pointer swap; replaced generations are reclaimed with epoch-based
+ *                    reclamation once their readers are gone.
+ * Class Invariant: - current always points to a complete generation.
+ *                  - A retired generation is deleted only once no Snapshot can reach it.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#include "VersionedList.h"
+
+using namespace std;
+
+// Process-wide thread numbering: the first reader slot a thread tries.
+static atomic<unsigned int> nextReaderIndex(0);
+static thread_local unsigned int readerIndex = nextReaderIndex++;
+
+// Constructor
+// Description: Claims a free reader slot, announcing the current epoch in it, then reads the current
+//              generation. A writer that retires a generation afterwards sees the slot (all the
+//              operations involved are sequentially consistent) and keeps the generation.
+VersionedList::Snapshot::Snapshot(const VersionedList &versioned)
+{
+    for (unsigned int i = readerIndex;; i++)
+    {
+        ReaderSlot &candidate = versioned.slots[i % MAX_READERS];
+        unsigned long long free = 0;
+        if (candidate.epoch.load(memory_order_relaxed) == 0 &&
+            candidate.epoch.compare_exchange_strong(free, versioned.globalEpoch.load()))
+        {
+            slot = &candidate;
+            break;
+        }
+        if ((i - readerIndex) % MAX_READERS == MAX_READERS - 1)
+        {
+            this_thread::yield(); // every slot is held
+        }
+    }
+    generation = versioned.current.load();
+}
+
+// Destructor
+// Description: Frees the reader slot.
+VersionedList::Snapshot::~Snapshot()
+{
+    slot->epoch.store(0, memory_order_release);
+}
+
+// Constructor
+VersionedList::VersionedList(unsigned int (*hFcn)(string), unsigned int aCapacity) : hashFcn(hFcn)
+{
+    current.store(new Generation{new List(hFcn, aCapacity), ++generationCount});
+}
+
+// Destructor
+// Description: Waits for a background reload (dropping its exception), then deletes every generation.
+VersionedList::~VersionedList()
+{
+    if (loader.joinable())
+    {
+        loader.join();
+    }
+    Generation *last = current.load();
+    delete last->list;
+    delete last;
+    for (unsigned int i = 0; i < retired.size(); i++)
+    {
+        delete retired[i].generation->list;
+        delete retired[i].generation;
+    }
+}
+
+// Description: Returns a snapshot of the current generation.
+VersionedList::Snapshot VersionedList::snapshot() const
+{
+    return Snapshot(*this);
+}
+
+// Description: Looks up the element with the same phone as target in the current generation and copies it into result.
+ErrorCode VersionedList::trySearch(const Member &target, Member &result) const
+{
+    Snapshot view(*this);
+    Member *found = nullptr;
+    ErrorCode code = view->trySearch(target, found);
+    if (code == ErrorCode::OK)
+    {
+        result = *found;
+    }
+    return code;
+}
+
+// Description: Builds a new generation with load on the calling thread, then publishes it.
+void VersionedList::reload(const Loader &load, unsigned int aCapacity)
+{
+    List *next = new List(hashFcn, aCapacity);
+    try
+    {
+        load(*next);
+    }
+    catch (...)
+    {
+        delete next;
+        throw;
+    }
+
+    lock_guard<mutex> guard(writerLock);
+    publish(next);
+}
+
+// Description: Same as reload( ), on a background thread.
+void VersionedList::reloadInBackground(Loader load, unsigned int aCapacity)
+{
+    waitForReload();
+    loader = thread(&VersionedList::backgroundReload, this, load, aCapacity);
+}
+
+// Description: Waits for the background reload, if any.
+// Exception: Passes on the exception that abandoned the background reload, if any (once).
+void VersionedList::waitForReload()
+{
+    if (loader.joinable())
+    {
+        loader.join();
+    }
+    if (reloadError != nullptr)
+    {
+        exception_ptr error = reloadError;
+        reloadError = nullptr;
+        rethrow_exception(error);
+    }
+}
+
+// Description: Copy-on-write update: copies the current generation, applies change to the copy, then publishes it.
+//              The writer lock is held throughout, so that no other writer publishes in between.
+void VersionedList::update(const Loader &change)
+{
+    lock_guard<mutex> guard(writerLock);
+    const List &source = *current.load()->list;
+    List *next = new List(hashFcn, source.getCapacity());
+    try
+    {
+        for (List::const_iterator it = source.begin(); it != source.end(); ++it)
+        {
+            next->insert(*new Member(*it));
+        }
+        change(*next);
+    }
+    catch (...)
+    {
+        delete next;
+        throw;
+    }
+    publish(next);
+}
+
+// Description: Returns the number of the current generation.
+unsigned long long VersionedList::getGenerationNumber() const
+{
+    return current.load()->number;
+}
+
+// Description: Deletes the retired generations no reader can reach any more and returns the number still waiting.
+unsigned int VersionedList::reclaim()
+{
+    lock_guard<mutex> guard(writerLock);
+    reclaimRetired();
+    return (unsigned int)retired.size();
+}
+
+////////////////////////////// Helper functions ///////////////////////////
+
+// Description: Body of the background reload thread: reload( ), keeping an exception in reloadError
+//              (read by waitForReload( ) once the thread is joined).
+void VersionedList::backgroundReload(Loader load, unsigned int aCapacity)
+{
+    try
+    {
+        reload(load, aCapacity);
+    }
+    catch (...)
+    {
+        reloadError = current_exception();
+    }
+}
+
+// Description: Makes next the current generation and retires the previous one in the epoch that ends now
+//              (the caller holds writerLock). Readers entering later announce a later epoch and can only
+//              read the new generation.
+void VersionedList::publish(List *next)
+{
+    Generation *previous = current.exchange(new Generation{next, ++generationCount});
+    retired.push_back(Retired{previous, globalEpoch.fetch_add(1)});
+    reclaimRetired();
+}
+
+// Description: Deletes the retired generations no reader can reach any more: those retired in an
+//              epoch older than the oldest epoch announced (the caller holds writerLock).
+void VersionedList::reclaimRetired()
+{
+    unsigned long long oldest = globalEpoch.load();
+    for (unsigned int i = 0; i < MAX_READERS; i++)
+    {
+        unsigned long long epoch = slots[i].epoch.load();
+        if (epoch != 0 && epoch < oldest)
+        {
+            oldest = epoch;
+        }
+    }
+
+    unsigned int kept = 0;
+    for (unsigned int i = 0; i < retired.size(); i++)
+    {
+        if (retired[i].epoch < oldest)
+        {
+            delete retired[i].generation->list;
+            delete retired[i].generation;
+        }
+        else
+        {
+            retired[kept++] = retired[i];
+        }
+    }
+    retired.resize(kept);
+}
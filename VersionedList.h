@@ -0,0 +1,158 @@
+/*
+ * VersionedList.h
+ *
+ * Class Description: Multi-version front-end over List, for tables reloaded while they are read
+ *                    (e.g. the nightly load of the member files). The current generation (a List)
+ *                    is reached through an atomic pointer. A new generation is built aside (by
+ *                    reload( ), reloadInBackground( ) or update( )) and published with a single pointer
+ *                    swap (RCU style): a reader sees either the whole previous generation or the whole
+ *                    new one, never a partial load, and never waits for a writer.
+ *                    Replaced generations are reclaimed with epoch-based reclamation: a reader holding a
+ *                    Snapshot announces the epoch it entered in a reader slot; a generation retired in
+ *                    epoch e is deleted once every announced epoch is past e.
+ *                    Writers (reload, update) are serialized among themselves.
+ * Class Invariant: - current always points to a complete generation.
+ *                  - A retired generation is deleted only once no Snapshot can reach it.
+ *
+ * Author: Elaine Luu
+ * Date: Last modified: Oct. 2026
+ */
+
+#ifndef VERSIONED_LIST_H
+#define VERSIONED_LIST_H
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "List.h"
+#include "ErrorCode.h"
+
+using std::atomic;
+using std::exception_ptr;
+using std::function;
+using std::mutex;
+using std::thread;
+using std::vector;
+
+class VersionedList
+{
+
+private:
+  struct Generation
+  {
+    List *list;
+    unsigned long long number;
+  };
+
+  struct Retired
+  {
+    Generation *generation;
+    unsigned long long epoch; // Epoch in which it was replaced.
+  };
+
+  // Epoch announced by one reader: 0 when the slot is free. One cache line per slot.
+  struct alignas(64) ReaderSlot
+  {
+    atomic<unsigned long long> epoch{0};
+  };
+
+  const static unsigned int MAX_READERS = 128; // Snapshots held at the same time (beyond that, readers spin).
+
+  atomic<Generation *> current;
+  atomic<unsigned long long> globalEpoch{1};
+  mutable ReaderSlot slots[MAX_READERS];
+
+  unsigned int (*hashFcn)(string);
+  mutex writerLock;           // Serializes publish( ) (and the reclamation of retired generations).
+  vector<Retired> retired;    // Replaced generations not deleted yet.
+  unsigned long long generationCount = 0;
+  thread loader;              // Background reload, if any.
+  exception_ptr reloadError;  // Exception of the background reload, until waitForReload( ) passes it on.
+
+  // Description: Makes next the current generation and retires the previous one.
+  void publish(List *next);
+
+  // Description: Body of the background reload thread: reload( ), keeping an exception in reloadError.
+  void backgroundReload(function<void(List &)> load, unsigned int aCapacity);
+
+  // Description: Deletes the retired generations no reader can reach any more (the caller holds writerLock).
+  void reclaimRetired();
+
+public:
+  typedef function<void(List &)> Loader;
+
+  // Consistent view of one generation. Holding it pins the generation (it cannot be reclaimed),
+  // so keep it short-lived; it does not block writers.
+  class Snapshot
+  {
+  private:
+    ReaderSlot *slot;
+    const Generation *generation;
+
+  public:
+    Snapshot(const VersionedList &versioned);
+    ~Snapshot();
+    Snapshot(const Snapshot &) = delete;
+    Snapshot &operator=(const Snapshot &) = delete;
+
+    const List &operator*() const { return *generation->list; }
+    const List *operator->() const { return generation->list; }
+
+    // Description: Returns the number of the generation seen (1 for the initial one).
+    unsigned long long getGenerationNumber() const { return generation->number; }
+  };
+
+  // Constructor
+  // Description: Creates a VersionedList whose first generation is an empty List of aCapacity cells.
+  VersionedList(unsigned int (*hFcn)(string), unsigned int aCapacity = List::CAPACITY);
+
+  // Destructor
+  // Description: Waits for a background reload, then deletes every generation. The exception of a
+  //              background reload not waited for with waitForReload( ) is dropped.
+  //              No Snapshot may be held any more.
+  ~VersionedList();
+
+  VersionedList(const VersionedList &) = delete;
+  VersionedList &operator=(const VersionedList &) = delete;
+
+  // Description: Returns a snapshot of the current generation.
+  Snapshot snapshot() const;
+
+  // Description: Looks up the element with the same phone as target in the current generation and
+  //              copies it into result (the element itself may be reclaimed once the call returns).
+  // Postcondition: Returns the outcome of List::trySearch( ); result is unchanged unless ErrorCode::OK.
+  ErrorCode trySearch(const Member &target, Member &result) const;
+
+  // Description: Builds a new generation of aCapacity cells with load (which inserts the elements,
+  //              e.g. from the member files) on the calling thread, then publishes it.
+  //              If load throws, nothing is published and the exception is passed on.
+  void reload(const Loader &load, unsigned int aCapacity);
+
+  // Description: Same as reload( ), on a background thread; returns at once.
+  //              Waits for the previous background reload first, if any (see waitForReload( )).
+  //              If load throws, nothing is published and the exception is kept for waitForReload( ).
+  // Exception: Passes on the exception of the previous background reload, without starting this one.
+  void reloadInBackground(Loader load, unsigned int aCapacity);
+
+  // Description: Waits for the background reload, if any.
+  // Exception: Passes on the exception that abandoned the background reload, if any (once).
+  void waitForReload();
+
+  // Description: Copy-on-write update: copies the current generation (elements included) into a new
+  //              List of the same capacity, applies change to the copy, then publishes it.
+  //              If change throws, nothing is published and the exception is passed on.
+  // Time Efficiency: O(n): meant for occasional edits, not a stream of single inserts.
+  void update(const Loader &change);
+
+  // Description: Returns the number of the current generation.
+  unsigned long long getGenerationNumber() const;
+
+  // Description: Deletes the retired generations no reader can reach any more and returns
+  //              the number still waiting for their readers.
+  unsigned int reclaim();
+};
+
+#endif